@@ -0,0 +1,1446 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <stack>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "my_containers.h"
+#include "my_containersplus.h"
+
+//  Benchmarks are grouped by container, "./bench.out vector" runs only the
+//  Vector group, without arguments every group is run.
+
+namespace {
+
+template <typename Function>
+double MeasureSeconds(Function function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+void PrintResult(const char *name, size_t count, double seconds) {
+  std::printf("%-44s n=%-10zu %10.3f ms %8.2f ns/op\n", name, count,
+              seconds * 1e3, seconds * 1e9 / (count == 0 ? 1 : count));
+}
+
+//  Vector
+// -----------------------------------------------------------------------------
+
+void BenchVector() {
+  for (size_t count : {10000, 100000, 1000000, 10000000}) {
+    double seconds = MeasureSeconds([count]() {
+      s21::Vector<int> vector;
+      for (size_t i = 0; i < count; i++) {
+        vector.push_back(static_cast<int>(i));
+      }
+    });
+    PrintResult("s21::Vector<int>::push_back", count, seconds);
+    seconds = MeasureSeconds([count]() {
+      std::vector<int> vector;
+      for (size_t i = 0; i < count; i++) {
+        vector.push_back(static_cast<int>(i));
+      }
+    });
+    PrintResult("std::vector<int>::push_back", count, seconds);
+  }
+  for (size_t count : {100000, 1000000, 10000000}) {
+    std::string payload(32, 'x');
+    double seconds = MeasureSeconds([count, &payload]() {
+      s21::Vector<std::string> vector;
+      for (size_t i = 0; i < count; i++) {
+        vector.push_back(std::string(payload));
+      }
+    });
+    PrintResult("s21::Vector<std::string>::push_back", count, seconds);
+    seconds = MeasureSeconds([count, &payload]() {
+      std::vector<std::string> vector;
+      for (size_t i = 0; i < count; i++) {
+        vector.push_back(std::string(payload));
+      }
+    });
+    PrintResult("std::vector<std::string>::push_back", count, seconds);
+  }
+}
+
+//  Queue
+// -----------------------------------------------------------------------------
+
+//  fills the queue with count items and drains it
+template <typename QueueType>
+void FillDrain(size_t count) {
+  QueueType queue;
+  for (size_t i = 0; i < count; i++) {
+    queue.push(static_cast<int>(i));
+  }
+  long long sum = 0;
+  while (!queue.empty()) {
+    sum += queue.front();
+    queue.pop();
+  }
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+//  work queue with a steady backlog: every push is followed by a pop
+template <typename QueueType>
+void SteadyState(size_t count, size_t backlog) {
+  QueueType queue;
+  for (size_t i = 0; i < backlog; i++) {
+    queue.push(static_cast<int>(i));
+  }
+  long long sum = 0;
+  for (size_t i = 0; i < count; i++) {
+    queue.push(static_cast<int>(i));
+    sum += queue.front();
+    queue.pop();
+  }
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+void BenchQueue() {
+  for (size_t count : {10000, 100000, 1000000, 10000000}) {
+    PrintResult("s21::Queue<int> fill+drain", count,
+                MeasureSeconds([count]() { FillDrain<s21::Queue<int>>(count); }));
+    PrintResult("s21::Queue<int, RingBuffer> fill+drain", count,
+                MeasureSeconds([count]() {
+                  FillDrain<s21::Queue<int, s21::RingBuffer<int>>>(count);
+                }));
+    PrintResult("std::queue<int> fill+drain", count,
+                MeasureSeconds([count]() { FillDrain<std::queue<int>>(count); }));
+  }
+  for (size_t backlog : {16, 1024, 65536}) {
+    size_t count = 10000000;
+    std::printf("backlog %zu\n", backlog);
+    PrintResult("s21::Queue<int> push+pop", count,
+                MeasureSeconds([count, backlog]() {
+                  SteadyState<s21::Queue<int>>(count, backlog);
+                }));
+    PrintResult("s21::Queue<int, RingBuffer> push+pop", count,
+                MeasureSeconds([count, backlog]() {
+                  SteadyState<s21::Queue<int, s21::RingBuffer<int>>>(count,
+                                                                    backlog);
+                }));
+    PrintResult("std::queue<int> push+pop", count,
+                MeasureSeconds([count, backlog]() {
+                  SteadyState<std::queue<int>>(count, backlog);
+                }));
+  }
+}
+
+//  Deque
+// -----------------------------------------------------------------------------
+
+//  fills at one end, then reads every element through iterators, through
+//  operator[] and sorts, the deque is filled in descending order
+template <typename DequeType>
+void DequeRound(const char *label, size_t count, bool front) {
+  char name[64];
+  DequeType deque;
+  std::snprintf(name, sizeof(name), "%s push_%s", label,
+                front ? "front" : "back");
+  PrintResult(name, count, MeasureSeconds([&deque, count, front]() {
+                for (size_t i = 0; i < count; i++) {
+                  if (front) {
+                    deque.push_front(static_cast<int>(i));
+                  } else {
+                    deque.push_back(static_cast<int>(count - i));
+                  }
+                }
+              }));
+  long long sum = 0;
+  std::snprintf(name, sizeof(name), "%s iterate", label);
+  PrintResult(name, count, MeasureSeconds([&deque, &sum]() {
+                for (auto it = deque.begin(); it != deque.end(); ++it) {
+                  sum += *it;
+                }
+              }));
+  std::snprintf(name, sizeof(name), "%s operator[]", label);
+  PrintResult(name, count, MeasureSeconds([&deque, &sum, count]() {
+                for (size_t i = 0; i < count; i++) sum += deque[i];
+              }));
+  std::snprintf(name, sizeof(name), "%s std::sort", label);
+  PrintResult(name, count, MeasureSeconds([&deque]() {
+                std::sort(deque.begin(), deque.end());
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+void BenchDeque() {
+  for (size_t count : {100000, 1000000, 10000000}) {
+    for (bool front : {false, true}) {
+      DequeRound<s21::Deque<int>>("s21::Deque<int>", count, front);
+      DequeRound<std::deque<int>>("std::deque<int>", count, front);
+    }
+  }
+}
+
+//  Stack
+// -----------------------------------------------------------------------------
+
+//  the first round only warms up the heap, so the container measured first
+//  does not pay for the page faults of both
+template <typename StackType, typename Value>
+void StackFillDrain(const char *name, size_t count, const Value &value) {
+  auto fillDrain = [count, &value]() {
+    StackType stack;
+    for (size_t i = 0; i < count; i++) {
+      stack.push(value);
+    }
+    while (!stack.empty()) {
+      stack.pop();
+    }
+  };
+  fillDrain();
+  PrintResult(name, count, MeasureSeconds(fillDrain));
+}
+
+//  depth-first traversal pattern, 1100 pushes then 1100 pops, the depth
+//  crosses a chunk boundary of ChunkedStorage
+template <typename StackType>
+void StackOscillate(const char *name, size_t count) {
+  StackType stack;
+  long long sum = 0;
+  PrintResult(name, count, MeasureSeconds([&stack, &sum, count]() {
+                for (size_t i = 0; i < count; i++) {
+                  for (int j = 0; j < 1100; j++) stack.push(j);
+                  for (int j = 0; j < 1100; j++) {
+                    sum += stack.top();
+                    stack.pop();
+                  }
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+//  pushes count items one by one or as a single range, then drains
+template <typename StackType>
+void StackPushRange(const char *name, size_t count, bool asRange) {
+  std::vector<int> items(count, 7);
+  auto fillDrain = [&items, asRange]() {
+    StackType stack;
+    if (asRange) {
+      stack.push_range(items);
+    } else {
+      for (int item : items) stack.push(item);
+    }
+    while (!stack.empty()) {
+      stack.pop();
+    }
+  };
+  fillDrain();
+  PrintResult(name, count, MeasureSeconds(fillDrain));
+}
+
+//  the same adaptor over each underlying container
+template <typename Value>
+using VectorStack = s21::Stack<Value>;
+template <typename Value>
+using RingStack = s21::Stack<Value, s21::RingBuffer<Value>>;
+template <typename Value>
+using ChunkedStack = s21::Stack<Value, s21::ChunkedStorage<Value>>;
+
+void BenchStack() {
+  std::string payload(32, 'x');
+  for (size_t count : {10000, 100000, 1000000, 10000000}) {
+    StackFillDrain<VectorStack<int>>("s21::Stack<int, Vector> fill+drain",
+                                     count, 7);
+    StackFillDrain<RingStack<int>>("s21::Stack<int, RingBuffer> fill+drain",
+                                   count, 7);
+    StackFillDrain<ChunkedStack<int>>(
+        "s21::Stack<int, ChunkedStorage> fill+drain", count, 7);
+    StackFillDrain<std::stack<int>>("std::stack<int> fill+drain", count, 7);
+    StackFillDrain<std::stack<int, std::vector<int>>>(
+        "std::stack<int, vector> fill+drain", count, 7);
+  }
+  for (size_t count : {100000, 1000000}) {
+    StackFillDrain<VectorStack<std::string>>(
+        "s21::Stack<string, Vector> fill+drain", count, payload);
+    StackFillDrain<RingStack<std::string>>(
+        "s21::Stack<string, RingBuffer> fill+drain", count, payload);
+    StackFillDrain<ChunkedStack<std::string>>(
+        "s21::Stack<string, ChunkedStorage> fill+drain", count, payload);
+    StackFillDrain<std::stack<std::string>>("std::stack<string> fill+drain",
+                                            count, payload);
+  }
+  StackOscillate<VectorStack<int>>("s21::Stack<int, Vector> oscillate",
+                                   10000);
+  StackOscillate<RingStack<int>>("s21::Stack<int, RingBuffer> oscillate",
+                                 10000);
+  StackOscillate<ChunkedStack<int>>(
+      "s21::Stack<int, ChunkedStorage> oscillate", 10000);
+  StackOscillate<std::stack<int>>("std::stack<int> oscillate", 10000);
+  for (size_t count : {100000, 10000000}) {
+    StackPushRange<VectorStack<int>>("s21::Stack<int, Vector> push loop",
+                                     count, false);
+    StackPushRange<VectorStack<int>>("s21::Stack<int, Vector> push_range",
+                                     count, true);
+    StackPushRange<RingStack<int>>("s21::Stack<int, RingBuffer> push loop",
+                                   count, false);
+    StackPushRange<RingStack<int>>("s21::Stack<int, RingBuffer> push_range",
+                                   count, true);
+  }
+}
+
+//  PriorityQueue
+// -----------------------------------------------------------------------------
+
+std::vector<int> RandomKeys(size_t count) {
+  std::vector<int> keys(count);
+  unsigned seed = 2024;
+  for (size_t i = 0; i < count; i++) {
+    seed = seed * 1103515245 + 12345;
+    keys[i] = static_cast<int>(seed >> 1);
+  }
+  return keys;
+}
+
+//  pushes random keys one by one, then pops them all
+template <typename QueueType>
+void HeapPushPop(const char *name, const std::vector<int> &keys) {
+  long long sum = 0;
+  PrintResult(name, keys.size(), MeasureSeconds([&keys, &sum]() {
+                QueueType queue;
+                for (int key : keys) queue.push(key);
+                while (!queue.empty()) {
+                  sum += queue.top();
+                  queue.pop();
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+//  builds the heap from a whole range and pops a tenth of it
+template <typename QueueType, typename Build>
+void HeapBuild(const char *name, const std::vector<int> &keys, Build build) {
+  long long sum = 0;
+  PrintResult(name, keys.size(), MeasureSeconds([&keys, &sum, build]() {
+                QueueType queue{build(keys)};
+                for (size_t i = 0; i < keys.size() / 10; i++) {
+                  sum += queue.top();
+                  queue.pop();
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+//  Dijkstra-like load on a min-heap: every item gets three smaller keys
+//  before the heap is drained. The addressable queue updates in place,
+//  std::priority_queue pushes a duplicate and skips stale entries on pop.
+void DecreaseKeyAddressable(size_t count, const std::vector<int> &keys) {
+  long long sum = 0;
+  PrintResult("s21::AddressablePriorityQueue decrease-key", count,
+              MeasureSeconds([count, &keys, &sum]() {
+                s21::AddressablePriorityQueue<int, std::greater<int>> queue;
+                std::vector<size_t> handles(count);
+                std::vector<int> current(count);
+                for (size_t i = 0; i < count; i++) {
+                  current[i] = keys[i];
+                  handles[i] = queue.push(keys[i]);
+                }
+                for (size_t round = 1; round <= 3; round++) {
+                  for (size_t i = 0; i < count; i++) {
+                    current[i] -= keys[(i * round) % count] % 1024 + 1;
+                    queue.update(handles[i], current[i]);
+                  }
+                }
+                while (!queue.empty()) {
+                  sum += queue.top();
+                  queue.pop();
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+void DecreaseKeyLazy(size_t count, const std::vector<int> &keys) {
+  long long sum = 0;
+  PrintResult("std::priority_queue lazy decrease-key", count,
+              MeasureSeconds([count, &keys, &sum]() {
+                typedef std::pair<int, size_t> Item;
+                std::priority_queue<Item, std::vector<Item>, std::greater<Item>>
+                    queue;
+                std::vector<int> current(count);
+                for (size_t i = 0; i < count; i++) {
+                  current[i] = keys[i];
+                  queue.push({keys[i], i});
+                }
+                for (size_t round = 1; round <= 3; round++) {
+                  for (size_t i = 0; i < count; i++) {
+                    current[i] -= keys[(i * round) % count] % 1024 + 1;
+                    queue.push({current[i], i});
+                  }
+                }
+                while (!queue.empty()) {
+                  Item item = queue.top();
+                  queue.pop();
+                  if (item.first == current[item.second]) sum += item.first;
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+void BenchPriority() {
+  for (size_t count : {10000, 100000, 1000000, 10000000}) {
+    std::vector<int> keys = RandomKeys(count);
+    HeapPushPop<s21::PriorityQueue<int, s21::Vector<int>, std::less<int>, 2>>(
+        "s21::PriorityQueue<int> binary push+pop", keys);
+    HeapPushPop<s21::PriorityQueue<int>>("s21::PriorityQueue<int> 4-ary push+pop",
+                                         keys);
+    HeapPushPop<std::priority_queue<int>>("std::priority_queue<int> push+pop",
+                                          keys);
+  }
+  for (size_t count : {100000, 10000000}) {
+    std::vector<int> keys = RandomKeys(count);
+    HeapBuild<s21::PriorityQueue<int>>(
+        "s21::PriorityQueue<int> push_range", keys,
+        [](const std::vector<int> &keys) {
+          s21::PriorityQueue<int> queue;
+          queue.push_range(keys);
+          return queue;
+        });
+    HeapBuild<std::priority_queue<int>>(
+        "std::priority_queue<int> range ctor", keys,
+        [](const std::vector<int> &keys) {
+          return std::priority_queue<int>(keys.begin(), keys.end());
+        });
+  }
+  for (size_t count : {100000, 1000000}) {
+    std::vector<int> keys = RandomKeys(count);
+    DecreaseKeyAddressable(count, keys);
+    DecreaseKeyLazy(count, keys);
+  }
+}
+
+//  SpscQueue, one producer thread and one consumer thread
+// -----------------------------------------------------------------------------
+
+//  std::queue behind a mutex, the usual hand-off the lock-free queue replaces
+class LockedQueue {
+ public:
+  bool try_push(int value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push(value);
+    return true;
+  }
+
+  bool try_pop(int &value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.empty()) return false;
+    value = queue.front();
+    queue.pop();
+    return true;
+  }
+
+ private:
+  std::mutex mutex;
+  std::queue<int> queue;
+};
+
+//  moves count ints from a producer thread to the consumer, batch elements
+//  at a time when batch is above one
+template <typename QueueType>
+void HandOff(const char *name, size_t count, size_t batch) {
+  QueueType queue;
+  long long sum = 0;
+  PrintResult(name, count, MeasureSeconds([&queue, &sum, count, batch]() {
+                std::thread producer([&queue, count, batch]() {
+                  std::vector<int> items(batch);
+                  for (size_t next = 0; next < count;) {
+                    if (batch == 1) {
+                      if (queue.try_push(static_cast<int>(next))) {
+                        next++;
+                      } else {
+                        std::this_thread::yield();
+                      }
+                    } else {
+                      size_t size = std::min(batch, count - next);
+                      for (size_t i = 0; i < size; i++) {
+                        items[i] = static_cast<int>(next + i);
+                      }
+                      if constexpr (requires { queue.try_push_n(items.data(), size); }) {
+                        size_t pushed = queue.try_push_n(items.data(), size);
+                        if (pushed == 0) std::this_thread::yield();
+                        next += pushed;
+                      }
+                    }
+                  }
+                });
+                std::vector<int> items(batch);
+                for (size_t taken = 0; taken < count;) {
+                  if (batch == 1) {
+                    int value;
+                    if (queue.try_pop(value)) {
+                      sum += value;
+                      taken++;
+                    } else {
+                      std::this_thread::yield();
+                    }
+                  } else {
+                    if constexpr (requires { queue.try_pop_n(items.data(), batch); }) {
+                      size_t popped = queue.try_pop_n(items.data(), batch);
+                      if (popped == 0) std::this_thread::yield();
+                      for (size_t i = 0; i < popped; i++) sum += items[i];
+                      taken += popped;
+                    }
+                  }
+                }
+                producer.join();
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+//  round trip of one value to an echo thread and back, the time per op is
+//  the latency of two hand-offs. Waiting sides yield, so the numbers stay
+//  meaningful when both threads share one core
+template <typename QueueType>
+void PingPong(const char *name, size_t count) {
+  QueueType ping;
+  QueueType pong;
+  PrintResult(name, count, MeasureSeconds([&ping, &pong, count]() {
+                std::thread echo([&ping, &pong, count]() {
+                  for (size_t i = 0; i < count; i++) {
+                    int value;
+                    while (!ping.try_pop(value)) std::this_thread::yield();
+                    while (!pong.try_push(value)) std::this_thread::yield();
+                  }
+                });
+                for (size_t i = 0; i < count; i++) {
+                  int value = static_cast<int>(i);
+                  while (!ping.try_push(value)) std::this_thread::yield();
+                  while (!pong.try_pop(value)) std::this_thread::yield();
+                }
+                echo.join();
+              }));
+}
+
+void BenchSpsc() {
+  typedef s21::SpscQueue<int, 4096> Spsc;
+  for (size_t count : {1000000, 10000000}) {
+    HandOff<Spsc>("s21::SpscQueue<int> hand-off", count, 1);
+    HandOff<Spsc>("s21::SpscQueue<int> hand-off, batch 64", count, 64);
+    HandOff<LockedQueue>("mutex + std::queue<int> hand-off", count, 1);
+  }
+  PingPong<Spsc>("s21::SpscQueue<int> round trip", 200000);
+  PingPong<LockedQueue>("mutex + std::queue<int> round trip", 200000);
+}
+
+//  MpmcQueue, the same number of producer and consumer threads
+// -----------------------------------------------------------------------------
+
+//  pairs producers and pairs consumers move count ints in total, batch
+//  elements at a time when batch is above one
+template <typename QueueType>
+void Scaling(const char *name, size_t pairs, size_t count, size_t batch) {
+  QueueType queue;
+  std::atomic<long long> sum{0};
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s %zu+%zu threads", name, pairs,
+                pairs);
+  PrintResult(label, count, MeasureSeconds([&queue, &sum, pairs, count,
+                                            batch]() {
+                std::vector<std::thread> workers;
+                size_t share = count / pairs;
+                for (size_t t = 0; t < pairs; t++) {
+                  workers.emplace_back([&queue, share, batch]() {
+                    std::vector<int> items(batch, 1);
+                    for (size_t next = 0; next < share;) {
+                      size_t pushed = 0;
+                      if constexpr (requires {
+                                      queue.try_push_n(items.data(), batch);
+                                    }) {
+                        if (batch > 1) {
+                          pushed = queue.try_push_n(
+                              items.data(), std::min(batch, share - next));
+                        } else {
+                          pushed = queue.try_push(1) ? 1 : 0;
+                        }
+                      } else {
+                        pushed = queue.try_push(1) ? 1 : 0;
+                      }
+                      if (pushed == 0) std::this_thread::yield();
+                      next += pushed;
+                    }
+                  });
+                  workers.emplace_back([&queue, &sum, share, batch]() {
+                    std::vector<int> items(batch);
+                    long long local = 0;
+                    for (size_t taken = 0; taken < share;) {
+                      size_t popped = 0;
+                      if constexpr (requires {
+                                      queue.try_pop_n(items.data(), batch);
+                                    }) {
+                        if (batch > 1) {
+                          popped = queue.try_pop_n(
+                              items.data(), std::min(batch, share - taken));
+                          for (size_t i = 0; i < popped; i++) {
+                            local += items[i];
+                          }
+                        } else if (queue.try_pop(items[0])) {
+                          local += items[0];
+                          popped = 1;
+                        }
+                      } else if (queue.try_pop(items[0])) {
+                        local += items[0];
+                        popped = 1;
+                      }
+                      if (popped == 0) std::this_thread::yield();
+                      taken += popped;
+                    }
+                    sum += local;
+                  });
+                }
+                for (std::thread &worker : workers) worker.join();
+              }));
+  if (sum.load() == -1) std::printf("unreachable\n");
+}
+
+void BenchMpmc() {
+  typedef s21::MpmcQueue<int, 4096> Mpmc;
+  const size_t count = 1 << 20;
+  for (size_t pairs : {1, 2, 4, 8, 16, 32}) {
+    Scaling<Mpmc>("s21::MpmcQueue<int>", pairs, count, 1);
+    Scaling<Mpmc>("s21::MpmcQueue<int> batch 16", pairs, count, 16);
+    Scaling<LockedQueue>("mutex + std::queue<int>", pairs, count, 1);
+  }
+}
+
+//  ThreadPool, fork-join on the work-stealing deques
+// -----------------------------------------------------------------------------
+
+long long SerialFib(int n) {
+  return n < 2 ? n : SerialFib(n - 1) + SerialFib(n - 2);
+}
+
+//  below cutoff the recursion runs serially, each fork is one task
+long long ForkFib(s21::ThreadPool &pool, int n, int cutoff) {
+  if (n < cutoff) return SerialFib(n);
+  long long left = 0;
+  s21::TaskGroup group(pool);
+  group.run([&pool, &left, n, cutoff]() {
+    left = ForkFib(pool, n - 1, cutoff);
+  });
+  long long right = ForkFib(pool, n - 2, cutoff);
+  group.wait();
+  return left + right;
+}
+
+//  halves the range until it is below grain
+long long ForkSum(s21::ThreadPool &pool, const int *first, const int *last,
+                  size_t grain) {
+  if (static_cast<size_t>(last - first) <= grain) {
+    long long sum = 0;
+    for (; first != last; ++first) sum += *first;
+    return sum;
+  }
+  const int *middle = first + (last - first) / 2;
+  long long left = 0;
+  s21::TaskGroup group(pool);
+  group.run([&pool, &left, first, middle, grain]() {
+    left = ForkSum(pool, first, middle, grain);
+  });
+  long long right = ForkSum(pool, middle, last, grain);
+  group.wait();
+  return left + right;
+}
+
+void BenchForkJoin() {
+  const int n = 32;
+  long long check = 0;
+  PrintResult("serial fib(32)", 1,
+              MeasureSeconds([&check, n]() { check += SerialFib(n); }));
+  for (size_t threads : {1, 2, 4}) {
+    s21::ThreadPool pool(threads);
+    for (int cutoff : {12, 18}) {
+      char label[64];
+      std::snprintf(label, sizeof(label), "fork fib(32) cutoff %d, %zu threads",
+                    cutoff, threads);
+      PrintResult(label, 1, MeasureSeconds([&pool, &check, n, cutoff]() {
+                    check += ForkFib(pool, n, cutoff);
+                  }));
+    }
+  }
+
+  const size_t count = 1 << 24;
+  s21::Vector<int> values;
+  values.reserve(count);
+  for (size_t i = 0; i < count; i++) values.push_back(static_cast<int>(i & 1023));
+  PrintResult("serial sum of s21::Vector<int>", count,
+              MeasureSeconds([&values, &check]() {
+                long long sum = 0;
+                for (size_t i = 0; i < values.size(); i++) sum += values[i];
+                check += sum;
+              }));
+  for (size_t threads : {1, 2, 4}) {
+    s21::ThreadPool pool(threads);
+    char label[64];
+    std::snprintf(label, sizeof(label), "fork sum, grain 64k, %zu threads",
+                  threads);
+    PrintResult(label, count, MeasureSeconds([&pool, &values, &check]() {
+                  check += ForkSum(pool, values.data(),
+                                   values.data() + values.size(), 1 << 16);
+                }));
+  }
+  if (check == -1) std::printf("unreachable\n");
+}
+
+//  Map, a sorted array: appending keys in order is amortized O(1), a key in
+//  random order shifts half of the array on average, so random inserts stop
+//  at 100K keys where the shifts start to dominate
+// -----------------------------------------------------------------------------
+
+std::vector<int> ShuffledKeys(size_t count, unsigned seed = 12345) {
+  std::vector<int> keys(count);
+  for (size_t i = 0; i < count; i++) {
+    keys[i] = static_cast<int>(i);
+  }
+  for (size_t i = count; i > 1; i--) {
+    seed = seed * 1103515245 + 12345;
+    std::swap(keys[i - 1], keys[(seed >> 8) % i]);
+  }
+  return keys;
+}
+
+template <typename MapType>
+void MapInsert(const char *name, const std::vector<int> &keys) {
+  MapType map;
+  PrintResult(name, keys.size(), MeasureSeconds([&map, &keys]() {
+                for (int key : keys) {
+                  map.insert({key, key});
+                }
+              }));
+  if (map.size() != keys.size()) std::printf("size mismatch\n");
+}
+
+template <typename MapType>
+void MapFind(const char *name, const std::vector<int> &keys) {
+  MapType map;
+  for (size_t i = 0; i < keys.size(); i++) {
+    map.insert({static_cast<int>(i), static_cast<int>(i)});
+  }
+  size_t found = 0;
+  PrintResult(name, keys.size(), MeasureSeconds([&map, &keys, &found]() {
+                for (int key : keys) {
+                  found += map.contains(key) ? 1 : 0;
+                }
+              }));
+  if (found != keys.size()) std::printf("lookup mismatch\n");
+}
+
+void BenchMap() {
+  for (size_t count : {1000, 10000, 100000, 1000000, 10000000}) {
+    std::vector<int> sorted(count);
+    for (size_t i = 0; i < count; i++) {
+      sorted[i] = static_cast<int>(i);
+    }
+    std::vector<int> shuffled = ShuffledKeys(count);
+    MapInsert<s21::Map<int, int>>("s21::Map<int, int> sorted insert", sorted);
+    MapInsert<std::map<int, int>>("std::map<int, int> sorted insert", sorted);
+    if (count <= 100000) {
+      MapInsert<s21::Map<int, int>>("s21::Map<int, int> random insert",
+                                    shuffled);
+      MapInsert<std::map<int, int>>("std::map<int, int> random insert",
+                                    shuffled);
+    }
+    MapFind<s21::Map<int, int>>("s21::Map<int, int> random contains",
+                                shuffled);
+    MapFind<std::map<int, int>>("std::map<int, int> random contains",
+                                shuffled);
+  }
+}
+
+//  Hash map, keys looked up in random order. Every size does at least 1M
+//  lookups, so small tables that fit in cache are measured as well. Misses
+//  look up keys beyond the inserted range. The lookup order is another
+//  shuffle than the insertion order, otherwise std::unordered_map would walk
+//  its nodes in the order they were allocated.
+// -----------------------------------------------------------------------------
+
+template <typename MapType>
+void HashInsert(const char *name, const std::vector<int> &keys) {
+  PrintResult(name, keys.size(), MeasureSeconds([&keys]() {
+                MapType map;
+                for (int key : keys) {
+                  map.insert({key, key});
+                }
+              }));
+}
+
+template <typename MapType>
+void HashLookup(const char *name, MapType &map, const std::vector<int> &keys,
+                int offset) {
+  size_t lookups = std::max<size_t>(keys.size(), 1000000);
+  size_t found = 0;
+  PrintResult(name, lookups,
+              MeasureSeconds([&map, &keys, &found, lookups, offset]() {
+                for (size_t i = 0; i < lookups; i++) {
+                  found += map.contains(keys[i % keys.size()] + offset);
+                }
+              }));
+  if (found != (offset == 0 ? lookups : 0)) std::printf("lookup mismatch\n");
+}
+
+void BenchHash() {
+  for (size_t count : {1000, 100000, 1000000, 10000000}) {
+    std::vector<int> keys = ShuffledKeys(count);
+    int miss = static_cast<int>(count);
+    HashInsert<s21::UnorderedMap<int, int>>("s21::UnorderedMap<int, int> insert",
+                                            keys);
+    HashInsert<std::unordered_map<int, int>>(
+        "std::unordered_map<int, int> insert", keys);
+    s21::UnorderedMap<int, int> swiss;
+    std::unordered_map<int, int> chained;
+    std::vector<std::pair<int, int>> sorted;
+    for (size_t i = 0; i < count; i++) {
+      swiss.insert({keys[i], keys[i]});
+      chained.insert({keys[i], keys[i]});
+      sorted.push_back({static_cast<int>(i), static_cast<int>(i)});
+    }
+    auto flat = s21::Map<int, int>::from_sorted(sorted.begin(), sorted.end());
+    keys = ShuffledKeys(count, 777);
+    HashLookup("s21::UnorderedMap<int, int> hit", swiss, keys, 0);
+    HashLookup("std::unordered_map<int, int> hit", chained, keys, 0);
+    HashLookup("s21::Map<int, int> hit", flat, keys, 0);
+    HashLookup("s21::UnorderedMap<int, int> miss", swiss, keys, miss);
+    HashLookup("std::unordered_map<int, int> miss", chained, keys, miss);
+    HashLookup("s21::Map<int, int> miss", flat, keys, miss);
+  }
+}
+
+//  Map lookups on the sorted array against the Eytzinger index, random hits
+//  on maps from the size of L2 to far beyond the last level cache. The
+//  index is built by the first lookup after it is enabled, so that lookup is
+//  done before the clock starts.
+// -----------------------------------------------------------------------------
+
+void BenchLookup() {
+  for (size_t count : {1 << 14, 1 << 18, 1 << 22, 1 << 24}) {
+    std::vector<std::pair<int, int>> sorted;
+    for (size_t i = 0; i < count; i++) {
+      sorted.push_back({static_cast<int>(i), static_cast<int>(i)});
+    }
+    std::vector<int> keys = ShuffledKeys(count, 777);
+    auto flat = s21::Map<int, int>::from_sorted(sorted.begin(), sorted.end());
+    HashLookup("s21::Map<int, int> binary search", flat, keys, 0);
+    flat.enable_lookup_index();
+    flat.contains(0);
+    HashLookup("s21::Map<int, int> eytzinger index", flat, keys, 0);
+    std::map<int, int> tree(sorted.begin(), sorted.end());
+    HashLookup("std::map<int, int>", tree, keys, 0);
+  }
+}
+
+//  Map against SplitMap with 8 byte keys and 128 byte values. A binary
+//  search of Map reads a whole pair per probe, SplitMap only reads keys and
+//  touches a value on a hit. contains never reads a value, at reads one
+//  word of it, the scan reads one word of every value.
+// -----------------------------------------------------------------------------
+
+struct Payload {
+  uint64_t words[16];
+};
+
+template <typename MapType>
+void SplitLookups(const char *name, size_t count) {
+  std::vector<std::pair<uint64_t, Payload>> sorted(count);
+  for (size_t i = 0; i < count; i++) {
+    sorted[i].first = i * 2;
+    sorted[i].second.words[0] = i;
+  }
+  auto map = MapType::from_sorted(sorted.begin(), sorted.end());
+  std::vector<int> keys = ShuffledKeys(std::max<size_t>(count, 1000000), 777);
+  std::string label = std::string(name) + " contains";
+  size_t found = 0;
+  PrintResult(label.c_str(), keys.size(), MeasureSeconds([&]() {
+                for (int key : keys) {
+                  uint64_t probe = static_cast<uint64_t>(key % count) * 2;
+                  found += map.contains(probe);
+                }
+              }));
+  label = std::string(name) + " at";
+  uint64_t sum = 0;
+  PrintResult(label.c_str(), keys.size(), MeasureSeconds([&]() {
+                for (int key : keys) {
+                  uint64_t probe = static_cast<uint64_t>(key % count) * 2;
+                  sum += map.at(probe).words[0];
+                }
+              }));
+  label = std::string(name) + " scan";
+  PrintResult(label.c_str(), count, MeasureSeconds([&]() {
+                for (auto iter = map.begin(); iter != map.end(); ++iter) {
+                  sum += iter->second.words[0];
+                }
+              }));
+  if (found != keys.size() || sum == 0) std::printf("lookup mismatch\n");
+}
+
+template <typename MapType>
+void SplitInsert(const char *name, size_t count) {
+  std::vector<int> keys = ShuffledKeys(count);
+  Payload payload{};
+  PrintResult(name, count, MeasureSeconds([&]() {
+                MapType map;
+                for (int key : keys) {
+                  map.insert(static_cast<uint64_t>(key), payload);
+                }
+              }));
+}
+
+void BenchSplit() {
+  for (size_t count : {1000, 10000, 100000, 1000000}) {
+    SplitLookups<s21::Map<uint64_t, Payload>>("s21::Map<uint64_t, 128B>",
+                                              count);
+    SplitLookups<s21::SplitMap<uint64_t, Payload>>(
+        "s21::SplitMap<uint64_t, 128B>", count);
+    if (count <= 10000) {
+      SplitInsert<s21::Map<uint64_t, Payload>>(
+          "s21::Map<uint64_t, 128B> random insert", count);
+      SplitInsert<s21::SplitMap<uint64_t, Payload>>(
+          "s21::SplitMap<uint64_t, 128B> random insert", count);
+    }
+  }
+}
+
+//  A comparator that carries state in the key: every string key is stored
+//  with its first 8 bytes packed big endian into an integer, so PrefixLess
+//  orders most pairs with one integer compare and only reads the heap
+//  buffers of two strings that share a prefix. Against std::string keys
+//  under the default ordering, which follows both pointers on every probe.
+// -----------------------------------------------------------------------------
+
+struct PrefixedKey {
+  uint64_t prefix;
+  std::string text;
+
+  explicit PrefixedKey(const std::string &source) : prefix(0), text(source) {
+    for (size_t i = 0; i < 8; i++) {
+      uint64_t byte = i < source.size() ? static_cast<uint8_t>(source[i]) : 0;
+      prefix = prefix << 8 | byte;
+    }
+  }
+};
+
+struct PrefixLess {
+  bool operator()(const PrefixedKey &left, const PrefixedKey &right) const {
+    if (left.prefix != right.prefix) return left.prefix < right.prefix;
+    return left.text < right.text;
+  }
+};
+
+//  32 characters, too long for the small string buffer, distinct in the
+//  first 8 of them
+std::vector<std::string> StringKeys(size_t count) {
+  std::vector<int> order = ShuffledKeys(count, 4242);
+  std::vector<std::string> keys(count);
+  char buffer[40];
+  for (size_t i = 0; i < count; i++) {
+    uint64_t hashed = static_cast<uint64_t>(order[i]) * 0x9E3779B97F4A7C15ull;
+    std::snprintf(buffer, sizeof(buffer), "%016llx/record/%09d",
+                  static_cast<unsigned long long>(hashed), order[i]);
+    keys[i] = buffer;
+  }
+  return keys;
+}
+
+template <typename MapType, typename Keys>
+void CompareMap(const char *name, const Keys &keys) {
+  std::vector<std::pair<typename Keys::value_type, int>> pairs;
+  for (const auto &key : keys) {
+    pairs.push_back({key, 0});
+  }
+  std::string label = std::string(name) + " range constructor";
+  MapType map;
+  PrintResult(label.c_str(), keys.size(), MeasureSeconds([&]() {
+                map = MapType(pairs.begin(), pairs.end());
+              }));
+  label = std::string(name) + " contains";
+  size_t found = 0;
+  PrintResult(label.c_str(), keys.size(), MeasureSeconds([&]() {
+                for (const auto &key : keys) {
+                  found += map.contains(key);
+                }
+              }));
+  if (found != keys.size()) std::printf("lookup mismatch\n");
+}
+
+template <typename SetType, typename Keys>
+void CompareSet(const char *name, const Keys &keys) {
+  std::string label = std::string(name) + " insert";
+  SetType set;
+  PrintResult(label.c_str(), keys.size(), MeasureSeconds([&]() {
+                for (const auto &key : keys) {
+                  set.insert(key);
+                }
+              }));
+  label = std::string(name) + " contains";
+  size_t found = 0;
+  PrintResult(label.c_str(), keys.size(), MeasureSeconds([&]() {
+                for (const auto &key : keys) {
+                  found += set.contains(key);
+                }
+              }));
+  if (found != keys.size()) std::printf("lookup mismatch\n");
+}
+
+void BenchCompare() {
+  for (size_t count : {10000, 100000, 1000000}) {
+    std::vector<std::string> keys = StringKeys(count);
+    std::vector<PrefixedKey> prefixed;
+    for (const std::string &key : keys) {
+      prefixed.emplace_back(key);
+    }
+    CompareMap<s21::Map<std::string, int>>("s21::Map<string>", keys);
+    CompareMap<s21::Map<PrefixedKey, int, PrefixLess>>(
+        "s21::Map<PrefixLess>", prefixed);
+    CompareSet<s21::set<std::string>>("s21::set<string>", keys);
+    CompareSet<s21::set<PrefixedKey, PrefixLess>>(
+        "s21::set<PrefixLess>", prefixed);
+  }
+}
+
+//  B+-tree against Map, std::map and set on 8 byte keys: random inserts,
+//  lookups of random present keys, and range scans of 100 elements from a
+//  random start. Map only inserts while the shifted tail stays small. The
+//  node size is varied from four cache lines to a page.
+// -----------------------------------------------------------------------------
+
+template <typename MapType>
+void TreeInsert(const char *name, const std::vector<int> &keys) {
+  PrintResult(name, keys.size(), MeasureSeconds([&keys]() {
+                MapType map;
+                for (int key : keys) {
+                  map.insert({static_cast<uint64_t>(key), 0});
+                }
+              }));
+}
+
+template <typename MapType>
+void TreeLookups(const char *name, MapType &map, const std::vector<int> &keys) {
+  std::string label = std::string(name) + " contains";
+  size_t found = 0;
+  PrintResult(label.c_str(), keys.size(), MeasureSeconds([&]() {
+                for (int key : keys) {
+                  found += map.contains(static_cast<uint64_t>(key));
+                }
+              }));
+  label = std::string(name) + " scan 100";
+  uint64_t sum = 0;
+  size_t scans = keys.size() / 10;
+  PrintResult(label.c_str(), scans, MeasureSeconds([&]() {
+                for (size_t i = 0; i < scans; i++) {
+                  auto iter = map.lower_bound(static_cast<uint64_t>(keys[i]));
+                  for (int step = 0; step < 100 && iter != map.end(); step++) {
+                    sum += iter->second;
+                    ++iter;
+                  }
+                }
+              }));
+  if (found != keys.size() || sum == 0) std::printf("lookup mismatch\n");
+}
+
+template <typename MapType>
+void TreeLookups(const char *name, const std::vector<int> &keys) {
+  std::vector<std::pair<uint64_t, uint64_t>> sorted(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    sorted[i] = {i, i};
+  }
+  MapType map(sorted.begin(), sorted.end());
+  TreeLookups(name, map, keys);
+}
+
+void BenchBTree() {
+  typedef std::pair<uint64_t, uint64_t> Pair;
+  for (size_t count : {100000, 1000000, 10000000}) {
+    std::vector<int> keys = ShuffledKeys(count, 99);
+    if (count <= 100000) {
+      TreeInsert<s21::Map<uint64_t, uint64_t>>("s21::Map insert", keys);
+    }
+    TreeInsert<std::map<uint64_t, uint64_t>>("std::map insert", keys);
+    TreeInsert<s21::BTreeMap<uint64_t, uint64_t>>("s21::BTreeMap insert", keys);
+    PrintResult("s21::BTreeSet insert", count, MeasureSeconds([&keys]() {
+                  s21::BTreeSet<uint64_t> set;
+                  for (int key : keys) {
+                    set.insert(static_cast<uint64_t>(key));
+                  }
+                }));
+    if (count <= 1000000) {
+      PrintResult("s21::set insert", count, MeasureSeconds([&keys]() {
+                    s21::set<uint64_t> set;
+                    for (int key : keys) {
+                      set.insert(static_cast<uint64_t>(key));
+                    }
+                  }));
+    }
+    TreeLookups<s21::Map<uint64_t, uint64_t>>("s21::Map", keys);
+    TreeLookups<std::map<uint64_t, uint64_t>>("std::map", keys);
+    TreeLookups<s21::BTreeMap<uint64_t, uint64_t, std::less<>,
+                              std::allocator<Pair>, 256>>("s21::BTreeMap 256B",
+                                                          keys);
+    TreeLookups<s21::BTreeMap<uint64_t, uint64_t>>("s21::BTreeMap 512B", keys);
+    TreeLookups<s21::BTreeMap<uint64_t, uint64_t, std::less<>,
+                              std::allocator<Pair>, 4096>>(
+        "s21::BTreeMap 4096B", keys);
+  }
+}
+
+//  Bulk load, n random keys with duplicates as read from a file: one insert
+//  per key against the range constructor that sorts once and builds the
+//  layout in one pass
+// -----------------------------------------------------------------------------
+
+template <typename Container, typename Keys>
+void InsertEach(const char *name, const Keys &keys) {
+  PrintResult(name, keys.size(), MeasureSeconds([&keys]() {
+                Container container;
+                for (const auto &key : keys) {
+                  container.insert(key);
+                }
+              }));
+}
+
+template <typename Container, typename Keys>
+void RangeLoad(const char *name, const Keys &keys) {
+  PrintResult(name, keys.size(), MeasureSeconds([&keys]() {
+                Container container(keys.begin(), keys.end());
+              }));
+}
+
+void BenchBulk() {
+  for (size_t count : {100000, 1000000, 10000000}) {
+    std::vector<int> keys = ShuffledKeys(count);
+    for (size_t i = 0; i < count; i += 4) {
+      keys[i] = keys[i / 2];
+    }
+    std::vector<std::pair<int, int>> pairs;
+    for (int key : keys) {
+      pairs.push_back({key, key});
+    }
+    if (count <= 100000) {
+      InsertEach<s21::Map<int, int>>("s21::Map<int, int> insert each", pairs);
+    }
+    RangeLoad<s21::Map<int, int>>("s21::Map<int, int> range constructor",
+                                  pairs);
+    RangeLoad<std::map<int, int>>("std::map<int, int> range constructor",
+                                  pairs);
+    InsertEach<s21::set<int>>("s21::set<int> insert each", keys);
+    RangeLoad<s21::set<int>>("s21::set<int> range constructor", keys);
+    RangeLoad<std::set<int>>("std::set<int> range constructor", keys);
+    InsertEach<s21::multiset<int>>("s21::multiset<int> insert each", keys);
+    RangeLoad<s21::multiset<int>>("s21::multiset<int> range constructor",
+                                  keys);
+    std::sort(keys.begin(), keys.end());
+    PrintResult("s21::set<int> from_sorted", count, MeasureSeconds([&keys]() {
+                  auto set = s21::set<int>::from_sorted(keys.begin(),
+                                                        keys.end());
+                }));
+  }
+}
+
+//  set and multiset, keys arrive sorted which is the worst case for an
+//  unbalanced tree
+// -----------------------------------------------------------------------------
+
+template <typename SetType>
+void SortedInsert(const char *name, size_t count) {
+  SetType set;
+  PrintResult(name, count, MeasureSeconds([&set, count]() {
+                for (size_t i = 0; i < count; i++) {
+                  set.insert(static_cast<int>(i));
+                }
+              }));
+}
+
+template <typename SetType>
+void SortedFind(const char *name, size_t count) {
+  SetType set;
+  for (size_t i = 0; i < count; i++) {
+    set.insert(static_cast<int>(i));
+  }
+  size_t found = 0;
+  PrintResult(name, count, MeasureSeconds([&set, &found, count]() {
+                for (size_t i = 0; i < count; i++) {
+                  found += set.contains(static_cast<int>(i)) ? 1 : 0;
+                }
+              }));
+  if (found != count) std::printf("lookup mismatch\n");
+}
+
+template <typename SetType>
+void SortedErase(const char *name, size_t count) {
+  SetType set;
+  for (size_t i = 0; i < count; i++) {
+    set.insert(static_cast<int>(i));
+  }
+  PrintResult(name, count, MeasureSeconds([&set, count]() {
+                for (size_t i = 0; i < count; i++) {
+                  auto it = set.find(static_cast<int>(i));
+                  set.erase(it);
+                }
+              }));
+}
+
+//  a full scan with end() and size() evaluated on every step
+template <typename SetType>
+void ScanWithSize(const char *name, size_t count) {
+  SetType set;
+  for (size_t i = 0; i < count; i++) {
+    set.insert(static_cast<int>(i));
+  }
+  long long sum = 0;
+  PrintResult(name, count, MeasureSeconds([&set, &sum]() {
+                for (auto it = set.begin(); it != set.end(); ++it) {
+                  sum += *it + static_cast<long long>(set.size());
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+void BenchSet() {
+  for (size_t count : {10000, 100000, 1000000}) {
+    SortedInsert<s21::set<int>>("s21::set<int> sorted insert", count);
+    SortedInsert<std::set<int>>("std::set<int> sorted insert", count);
+    SortedInsert<s21::multiset<int>>("s21::multiset<int> sorted insert",
+                                     count);
+    SortedInsert<std::multiset<int>>("std::multiset<int> sorted insert",
+                                     count);
+    SortedFind<s21::set<int>>("s21::set<int> contains", count);
+    SortedFind<std::set<int>>("std::set<int> contains", count);
+    SortedErase<s21::set<int>>("s21::set<int> sorted erase", count);
+    SortedErase<std::set<int>>("std::set<int> sorted erase", count);
+    ScanWithSize<s21::set<int>>("s21::set<int> scan + size()", count);
+    ScanWithSize<std::set<int>>("std::set<int> scan + size()", count);
+  }
+}
+
+//  List, sort and merge relink the nodes in place
+// -----------------------------------------------------------------------------
+
+template <typename ListType>
+void FillShuffled(ListType &list, size_t count, unsigned seed) {
+  for (size_t i = 0; i < count; i++) {
+    seed = seed * 1103515245 + 12345;
+    list.push_back(static_cast<int>(seed >> 8));
+  }
+}
+
+template <typename ListType>
+void ListSort(const char *name, size_t count) {
+  ListType list;
+  FillShuffled(list, count, 1);
+  PrintResult(name, count, MeasureSeconds([&list]() { list.sort(); }));
+}
+
+template <typename ListType>
+void ListMerge(const char *name, size_t count) {
+  ListType list, other;
+  FillShuffled(list, count / 2, 1);
+  FillShuffled(other, count / 2, 2);
+  list.sort();
+  other.sort();
+  PrintResult(name, count, MeasureSeconds([&list, &other]() {
+                list.merge(other);
+              }));
+}
+
+//  a scheduler moving batches of jobs between two queues
+template <typename ListType>
+void ListSpliceBatches(const char *name, size_t count, size_t batch) {
+  ListType ready, waiting;
+  for (size_t i = 0; i < batch * 4; i++) {
+    ready.push_back(static_cast<int>(i));
+  }
+  PrintResult(name, count, MeasureSeconds([&ready, &waiting, count, batch]() {
+                for (size_t i = 0; i < count; i++) {
+                  auto last = ready.begin();
+                  for (size_t j = 0; j < batch; j++) ++last;
+                  waiting.splice(waiting.end(), ready, ready.begin(), last);
+                  ready.splice(ready.end(), waiting);
+                }
+              }));
+}
+
+void BenchList() {
+  for (size_t count : {10000, 100000, 1000000, 4000000}) {
+    ListSort<s21::List<int>>("s21::List<int>::sort", count);
+    ListSort<std::list<int>>("std::list<int>::sort", count);
+    ListMerge<s21::List<int>>("s21::List<int>::merge", count);
+    ListMerge<std::list<int>>("std::list<int>::merge", count);
+  }
+  for (size_t batch : {1, 16, 256}) {
+    std::printf("batch %zu\n", batch);
+    ListSpliceBatches<s21::List<int>>("s21::List<int>::splice", 1000000, batch);
+    ListSpliceBatches<std::list<int>>("std::list<int>::splice", 1000000, batch);
+  }
+}
+
+//  Node pool, list and tree nodes are cut from chunks instead of being
+//  allocated one by one
+// -----------------------------------------------------------------------------
+
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+template <typename ListType>
+void CountListAllocations(const char *name, size_t count) {
+  CountingResource resource;
+  {
+    ListType list(&resource);
+    for (size_t i = 0; i < count; i++) {
+      list.push_back(static_cast<int>(i));
+    }
+  }
+  std::printf("%-44s n=%-10zu %10zu allocations\n", name, count,
+              resource.allocations);
+}
+
+template <typename SetType>
+void CountSetAllocations(const char *name, size_t count) {
+  CountingResource resource;
+  {
+    SetType set(&resource);
+    for (size_t i = 0; i < count; i++) {
+      set.insert(static_cast<int>(i));
+    }
+  }
+  std::printf("%-44s n=%-10zu %10zu allocations\n", name, count,
+              resource.allocations);
+}
+
+//  two containers are built in turns, so with one allocation per node their
+//  nodes interleave in memory, then one of them is traversed
+template <typename ListType>
+void InterleavedListScan(const char *name, size_t count) {
+  ListType list, other;
+  for (size_t i = 0; i < count; i++) {
+    list.push_back(static_cast<int>(i));
+    other.push_back(static_cast<int>(i));
+  }
+  long long sum = 0;
+  PrintResult(name, count, MeasureSeconds([&list, &sum]() {
+                for (int repeat = 0; repeat < 10; repeat++) {
+                  for (auto it = list.begin(); it != list.end(); ++it) {
+                    sum += *it;
+                  }
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+template <typename SetType>
+void InterleavedSetScan(const char *name, size_t count) {
+  SetType set, other;
+  for (size_t i = 0; i < count; i++) {
+    set.insert(static_cast<int>(i));
+    other.insert(static_cast<int>(i));
+  }
+  long long sum = 0;
+  PrintResult(name, count, MeasureSeconds([&set, &sum]() {
+                for (int repeat = 0; repeat < 10; repeat++) {
+                  for (auto it = set.begin(); it != set.end(); ++it) {
+                    sum += *it;
+                  }
+                }
+              }));
+  if (sum == -1) std::printf("unreachable\n");
+}
+
+//  builds and destroys the container, destruction of trivial nodes is
+//  O(chunks) with the pool
+template <typename SetType>
+void BuildDestroy(const char *name, size_t count) {
+  PrintResult(name, count, MeasureSeconds([count]() {
+                SetType set;
+                for (size_t i = 0; i < count; i++) {
+                  set.insert(static_cast<int>(i));
+                }
+              }));
+}
+
+void BenchPool() {
+  for (size_t count : {1000, 100000, 1000000}) {
+    CountListAllocations<s21::pmr::List<int>>("s21::pmr::List<int>", count);
+    CountListAllocations<std::pmr::list<int>>("std::pmr::list<int>", count);
+    CountSetAllocations<s21::pmr::set<int>>("s21::pmr::set<int>", count);
+    CountSetAllocations<std::pmr::set<int>>("std::pmr::set<int>", count);
+  }
+  for (size_t count : {10000, 100000, 1000000}) {
+    InterleavedListScan<s21::List<int>>("s21::List<int> interleaved scan x10",
+                                        count);
+    InterleavedListScan<std::list<int>>("std::list<int> interleaved scan x10",
+                                        count);
+    InterleavedSetScan<s21::set<int>>("s21::set<int> interleaved scan x10",
+                                      count);
+    InterleavedSetScan<std::set<int>>("std::set<int> interleaved scan x10",
+                                      count);
+    BuildDestroy<s21::set<int>>("s21::set<int> build+destroy", count);
+    BuildDestroy<std::set<int>>("std::set<int> build+destroy", count);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+struct Group {
+  const char *name;
+  std::function<void()> run;
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::vector<Group> groups{
+      {"vector", BenchVector},
+      {"queue", BenchQueue},
+      {"deque", BenchDeque},
+      {"stack", BenchStack},
+      {"priority", BenchPriority},
+      {"spsc", BenchSpsc},
+      {"mpmc", BenchMpmc},
+      {"forkjoin", BenchForkJoin},
+      {"map", BenchMap},
+      {"bulk", BenchBulk},
+      {"hash", BenchHash},
+      {"lookup", BenchLookup},
+      {"split", BenchSplit},
+      {"compare", BenchCompare},
+      {"btree", BenchBTree},
+      {"set", BenchSet},
+      {"list", BenchList},
+      {"pool", BenchPool},
+  };
+  for (auto &group : groups) {
+    if (argc < 2 || std::strcmp(argv[1], group.name) == 0) {
+      std::printf("[%s]\n", group.name);
+      group.run();
+    }
+  }
+  return 0;
+}
@@ -1,4 +1,8 @@
 #include <cmath>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
 
 #pragma once
 
@@ -7,7 +11,7 @@
 
 namespace s21 {
 
-template <typename T, std::size_t N>
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
 class Array {
  public:
   class ArrayIterator;
@@ -30,47 +34,80 @@ class Array {
   // size_t defines the type of the container size (standard type is size_t)
   typedef size_t size_type;
 
+  typedef std::allocator_traits<Allocator> AllocTraits;
+
   size_type _size = 0;
 
   value_type* _head = nullptr;
 
+  [[no_unique_address]] Allocator _alloc;
+
+  // elements are value-initialized through the allocator
   void AllocMem(size_type size) {
+    FreeMem();
     if (size != 0) {
-      if (_head == nullptr) delete _head;
-      _head = new value_type[size];
+      _head = AllocTraits::allocate(_alloc, size);
+      size_type i = 0;
+      try {
+        for (; i < size; i++) AllocTraits::construct(_alloc, _head + i);
+      } catch (...) {
+        while (i > 0) AllocTraits::destroy(_alloc, _head + --i);
+        AllocTraits::deallocate(_alloc, _head, size);
+        _head = nullptr;
+        throw;
+      }
       _size = size;
     }
   }
 
+  void FreeMem() {
+    if (_head != nullptr) {
+      for (size_type i = 0; i < _size; i++)
+        AllocTraits::destroy(_alloc, _head + i);
+      AllocTraits::deallocate(_alloc, _head, _size);
+      _head = nullptr;
+      _size = 0;
+    }
+  }
+
  public:
+  typedef Allocator allocator_type;
+
   Array() { AllocMem(N); }
 
-  Array(std::initializer_list<value_type> const& items) {
+  explicit Array(const Allocator& alloc) : _alloc(alloc) { AllocMem(N); }
+
+  Array(std::initializer_list<value_type> const& items,
+        const Allocator& alloc = Allocator())
+      : _alloc(alloc) {
+    if (items.size() > N)
+      throw std::out_of_range(
+          "array costruct <initializer_list>: not enough space to fit other "
+          "array in");
     AllocMem(N);
-    int i = 0;
+    size_type i = 0;
     for (value_type value : items) {
-      if (i > N)
-        throw std::out_of_range(
-            "array costruct <initializer_list>: not enough space to fit other "
-            "array in");
       _head[i] = value;
       i++;
     }
   }
 
-  Array(const Array& other) {
+  Array(const Array& other)
+      : Array(other, AllocTraits::select_on_container_copy_construction(
+                         other._alloc)) {}
+
+  Array(const Array& other, const Allocator& alloc) : _alloc(alloc) {
     if (N < other._size)
       throw std::out_of_range(
           "array construct (arr other): not enough space to fit other array "
           "in");
     AllocMem(N);
-    for (int i = 0; i < other._size; i++) {
+    for (size_type i = 0; i < other._size; i++) {
       _head[i] = other._head[i];
     }
   }
 
-  Array(Array&& other) {
-    delete _head;
+  Array(Array&& other) : _alloc(std::move(other._alloc)) {
     _head = other._head;
     _size = other._size;
 
@@ -79,7 +116,20 @@ class Array {
   }
 
   void operator=(Array&& other) {
-    delete _head;
+    if (this == &other) return;
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+      FreeMem();
+      _alloc = std::move(other._alloc);
+    } else if (_alloc != other._alloc) {
+      // storage of other cannot be released by this allocator
+      AllocMem(other._size);
+      for (size_type i = 0; i < _size; i++) {
+        _head[i] = std::move(other._head[i]);
+      }
+      return;
+    } else {
+      FreeMem();
+    }
     _head = other._head;
     _size = other._size;
 
@@ -87,9 +137,7 @@ class Array {
     other._size = 0;
   }
 
-  ~Array() {
-    if (_head != nullptr) delete _head;
-  }
+  ~Array() { FreeMem(); }
 
   class ArrayIterator {
    private:
@@ -183,9 +231,14 @@ class Array {
 
   size_type max_size() { return _size; }
 
+  allocator_type get_allocator() { return _alloc; }
+
   void swap(Array& other) {
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      std::swap(_alloc, other._alloc);
+    }
     value_type* swapH = _head;
-    size_type swapS = other._size;
+    size_type swapS = _size;
     _head = other._head;
     _size = other._size;
     other._head = swapH;
@@ -194,12 +247,17 @@ class Array {
 
   // assigns the given value value to all elements in the container.
   void fill(const_reference value) {
-    for (int i = 0; i < _size; i++) {
+    for (size_type i = 0; i < _size; i++) {
       this->at(i) = value;
     }
   }
 };
 
+namespace pmr {
+template <typename T, std::size_t N>
+using Array = s21::Array<T, N, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif // MY_ARRAY_H
\ No newline at end of file
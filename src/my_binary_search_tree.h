@@ -1,13 +1,39 @@
 #ifndef MY_BINARY_SEARCH_TREE_H
 #define MY_BINARY_SEARCH_TREE_H
 
+#include <algorithm>
+#include <concepts>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "my_node_pool.h"
 
 #define BST BinarySearchTree
 
 namespace s21 {
 
-template <class Key>
+// Red-black tree: every path from a node to its leaves has the same number
+// of black nodes and a red node never has a red child, so the height stays
+// below 2 * log2(n + 1) for any insertion order. All operations are
+// iterative, deep trees do not grow the call stack.
+//
+// The tree hangs from a header node: header._parent is the root,
+// header._left and header._right are the leftmost and rightmost nodes and
+// the root's parent is the header. The header is the end() position, it
+// makes begin(), end() and --end() O(1). Together with the cached element
+// count size() is O(1) as well.
+//
+// Keys are ordered by Compare, a strict weak ordering called as
+// compare(left, right). It is a member marked [[no_unique_address]], so an
+// empty comparator such as the default std::less<> takes no space.
+template <class Key, class Compare = std::less<>,
+          class Allocator = std::allocator<Key>>
 class BinarySearchTree {
  protected:
   typedef Key key_type;
@@ -16,146 +42,647 @@ class BinarySearchTree {
   typedef const value_type& const_reference;
   typedef size_t size_type;
   struct Node {
-    key_type _key;
     Node* _left;
     Node* _right;
     Node* _parent;
+    bool _red;
+    // the header never constructs a key
+    union {
+      key_type _key;
+    };
+    Node() {}
+    ~Node() {}
   };
-  Node* _root;
-  void _AddNode(Node*& tree, const key_type& key);
-  Node*& _FindNode(Node*& tree, const key_type& key);
-  void _DeleteNode(Node*& tree, const key_type& key);
-  Node*& _MinimalNode(Node*& tree);
-  Node*& _MaximalNode(Node*& tree);
-  void _DeleteAllTree(Node*& tree);
-  void _InsertInTree(const key_type& key);
-  Node* _MinNodeWithOut(Node*& tree, Node*& changeNode);
-  Node* _MaxNodeWithOut(Node*& tree, Node*& changeNode);
+  // nodes come from a pool that takes its chunks from the user allocator
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node>
+      NodeAllocator;
+  typedef std::allocator_traits<NodeAllocator> NodeTraits;
+  // a K other than Key, a std::string_view for std::string keys, is searched
+  // for as it is when Compare declares is_transparent and orders K against
+  // Key both ways
+  template <class K>
+  static constexpr bool _Transparent =
+      !std::is_same_v<K, Key> &&
+      requires(const Compare& compare, const Key& key, const K& other) {
+        typename Compare::is_transparent;
+        { compare(key, other) } -> std::convertible_to<bool>;
+        { compare(other, key) } -> std::convertible_to<bool>;
+      };
+  Node _header;
+  size_type _size;
+  NodePool<Node, Allocator> _nodePool;
+  [[no_unique_address]] Compare _compare;
+  Node*& _Root() { return _header._parent; }
+  Node* _Header() { return &_header; }
+  Node* _CreateNode(const key_type& key, Node* parent);
+  Node* _LinkNode(const key_type& key, Node* parent, bool toLeft);
+  void _DestroyNode(Node* node);
+  template <class K>
+  Node* _FindNode(Node* tree, const K& key);
+  template <class K>
+  Node* _LowerBoundNode(const K& key);
+  template <class K>
+  Node* _UpperBoundNode(const K& key);
+  static Node* _MinimalNode(Node* tree);
+  static Node* _MaximalNode(Node* tree);
+  static bool _IsHeader(Node* node);
+  static Node* _NextNode(Node* node);
+  static Node* _PrevNode(Node* node);
+  void _Clear();
+  void _SwapTree(BST& other);
+  Node* _InsertInTree(const key_type& key);
+  std::pair<Node*, bool> _InsertUniqueInTree(const key_type& key);
+  void _EraseNode(Node* node);
+  template <class InputIterator>
+  void _BuildTree(InputIterator first, InputIterator last, bool sorted,
+                  bool unique);
+  template <class RandomIterator>
+  void _BuildFromSorted(RandomIterator keys, size_type count);
   BST();
+  explicit BST(const Allocator& alloc);
+  BST(const Compare& compare, const Allocator& alloc);
   ~BST();
+
+ private:
+  static bool _IsRed(Node* node) { return node != nullptr && node->_red; }
+  void _ResetHeader();
+  void _Transplant(Node* node, Node* replacement);
+  void _RotateLeft(Node* node);
+  void _RotateRight(Node* node);
+  void _InsertFixup(Node* node);
+  void _EraseFixup(Node* node, Node* parent);
 };
 
 }  // namespace s21
 
-template <class Key>
-s21::BST<Key>::BST() {
-  this->_root = nullptr;
+template <class Key, class Compare, class Allocator>
+s21::BST<Key, Compare, Allocator>::BST() {
+  _ResetHeader();
+}
+
+template <class Key, class Compare, class Allocator>
+s21::BST<Key, Compare, Allocator>::BST(const Allocator& alloc)
+    : _nodePool(alloc) {
+  _ResetHeader();
+}
+
+template <class Key, class Compare, class Allocator>
+s21::BST<Key, Compare, Allocator>::BST(const Compare& compare,
+                                       const Allocator& alloc)
+    : _nodePool(alloc), _compare(compare) {
+  _ResetHeader();
+}
+
+// the header is red, the root never is, that tells them apart
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_ResetHeader() {
+  _header._parent = nullptr;
+  _header._left = &_header;
+  _header._right = &_header;
+  _header._red = true;
+  _size = 0;
+}
+
+template <class Key, class Compare, class Allocator>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_CreateNode(const key_type& key,
+                                               Node* parent) {
+  NodeAllocator& alloc = _nodePool.get_allocator();
+  Node* node = _nodePool.Allocate();
+  NodeTraits::construct(alloc, node);
+  try {
+    NodeTraits::construct(alloc, std::addressof(node->_key), key);
+  } catch (...) {
+    NodeTraits::destroy(alloc, node);
+    _nodePool.Deallocate(node);
+    throw;
+  }
+  node->_left = nullptr;
+  node->_right = nullptr;
+  node->_parent = parent;
+  node->_red = true;
+  return node;
+}
+
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_DestroyNode(Node* node) {
+  NodeAllocator& alloc = _nodePool.get_allocator();
+  NodeTraits::destroy(alloc, std::addressof(node->_key));
+  NodeTraits::destroy(alloc, node);
+  _nodePool.Deallocate(node);
+}
+
+// equal keys go to the right, so they keep their insertion order
+template <class Key, class Compare, class Allocator>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_InsertInTree(const key_type& key) {
+  Node* parent = &_header;
+  Node* current = _Root();
+  bool toLeft = false;
+  while (current != nullptr) {
+    parent = current;
+    toLeft = _compare(key, current->_key);
+    current = toLeft ? current->_left : current->_right;
+  }
+  return _LinkNode(key, parent, toLeft);
+}
+
+// one descent: the last node we went right from is the only candidate for an
+// equal key
+template <class Key, class Compare, class Allocator>
+std::pair<typename s21::BST<Key, Compare, Allocator>::Node*, bool>
+s21::BST<Key, Compare, Allocator>::_InsertUniqueInTree(const key_type& key) {
+  Node* parent = &_header;
+  Node* candidate = nullptr;
+  Node* current = _Root();
+  bool toLeft = false;
+  while (current != nullptr) {
+    parent = current;
+    toLeft = _compare(key, current->_key);
+    if (toLeft) {
+      current = current->_left;
+    } else {
+      candidate = current;
+      current = current->_right;
+    }
+  }
+  if (candidate != nullptr && !_compare(candidate->_key, key)) {
+    return std::make_pair(candidate, false);
+  }
+  return std::make_pair(_LinkNode(key, parent, toLeft), true);
 }
 
-template <class Key>
-void s21::BST<Key>::_AddNode(Node*& tree, const key_type& key) {
-  if (tree == nullptr) {
-    tree = new Node;
-    tree->_key = key;
-    tree->_left = tree->_right = tree->_parent = nullptr;
+template <class Key, class Compare, class Allocator>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_LinkNode(const key_type& key,
+                                             Node* parent, bool toLeft) {
+  Node* node = _CreateNode(key, parent);
+  if (parent == &_header) {
+    _header._parent = node;
+    _header._left = node;
+    _header._right = node;
+  } else if (toLeft) {
+    parent->_left = node;
+    if (parent == _header._left) {
+      _header._left = node;
+    }
   } else {
-    if (key < tree->_key) {
-      if (tree->_left != nullptr) {
-        _AddNode(tree->_left, key);
-      } else {
-        tree->_left = new Node;
-        tree->_left->_left = tree->_left->_right = nullptr;
-        tree->_left->_parent = tree;
-        tree->_left->_key = key;
-      }
+    parent->_right = node;
+    if (parent == _header._right) {
+      _header._right = node;
+    }
+  }
+  _size++;
+  _InsertFixup(node);
+  return node;
+}
+
+// returns the leftmost node holding key, so a multiset lookup starts at the
+// first of equal keys
+template <class Key, class Compare, class Allocator>
+template <class K>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_FindNode(Node* tree, const K& key) {
+  Node* found = nullptr;
+  while (tree != nullptr) {
+    if (_compare(key, tree->_key)) {
+      tree = tree->_left;
+    } else if (_compare(tree->_key, key)) {
+      tree = tree->_right;
     } else {
-      if (tree->_right != nullptr) {
-        _AddNode(tree->_right, key);
-      } else {
-        tree->_right = new Node;
-        tree->_right->_left = tree->_right->_right = nullptr;
-        tree->_right->_parent = tree;
-        tree->_right->_key = key;
-      }
+      found = tree;
+      tree = tree->_left;
     }
   }
+  return found;
 }
 
-template <class Key>
-void s21::BST<Key>::_InsertInTree(const key_type& key) {
-  _AddNode(this->_root, key);
+// first node not less than key, the header if there is none
+template <class Key, class Compare, class Allocator>
+template <class K>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_LowerBoundNode(const K& key) {
+  Node* result = &_header;
+  Node* current = _Root();
+  while (current != nullptr) {
+    if (_compare(current->_key, key)) {
+      current = current->_right;
+    } else {
+      result = current;
+      current = current->_left;
+    }
+  }
+  return result;
 }
 
-template <class Key>
-typename s21::BST<Key>::Node*& s21::BST<Key>::_FindNode(Node*& tree,
-                                                        const key_type& key) {
-  return tree == nullptr || tree->_key == key ? tree
-         : key < tree->_key                   ? _FindNode(tree->_left, key)
-                                              : _FindNode(tree->_right, key);
+// first node greater than key, the header if there is none
+template <class Key, class Compare, class Allocator>
+template <class K>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_UpperBoundNode(const K& key) {
+  Node* result = &_header;
+  Node* current = _Root();
+  while (current != nullptr) {
+    if (_compare(key, current->_key)) {
+      result = current;
+      current = current->_left;
+    } else {
+      current = current->_right;
+    }
+  }
+  return result;
 }
 
-template <class Key>
-typename s21::BST<Key>::Node*& s21::BST<Key>::_MinimalNode(Node*& tree) {
-  return tree->_left == nullptr ? tree : _MinimalNode(tree->_left);
+template <class Key, class Compare, class Allocator>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_MinimalNode(Node* tree) {
+  while (tree != nullptr && tree->_left != nullptr) {
+    tree = tree->_left;
+  }
+  return tree;
 }
 
-template <class Key>
-typename s21::BST<Key>::Node*& s21::BST<Key>::_MaximalNode(Node*& tree) {
-  return tree->_right == nullptr ? tree : _MaximalNode(tree->_right);
+template <class Key, class Compare, class Allocator>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_MaximalNode(Node* tree) {
+  while (tree != nullptr && tree->_right != nullptr) {
+    tree = tree->_right;
+  }
+  return tree;
 }
 
-template <class Key>
-void s21::BST<Key>::_DeleteNode(Node*& tree, const key_type& key) {
-  if (tree != nullptr) {
-    if (tree->_key == key) {
-      if (tree->_right == nullptr && tree->_left == nullptr) {
-        delete tree;
-        tree = nullptr;
-      } else if (tree->_left != nullptr && tree->_right == nullptr) {
-        tree->_left->_parent = tree->_parent;
-        Node* tempNode = tree;
-        tree = tree->_left;
-        delete tempNode;
-      } else if (tree->_right != nullptr && tree->_left == nullptr) {
-        tree->_right->_parent = tree->_parent;
-        Node* tempNode = tree;
-        tree = tree->_right;
-        delete tempNode;
-      } else {
-        tree->_key = _MinimalNode(tree->_right)->_key;
-        _DeleteNode(tree->_right, tree->_key);
-      }
-    } else if (key < tree->_key) {
-      _DeleteNode(tree->_left, key);
+template <class Key, class Compare, class Allocator>
+bool s21::BST<Key, Compare, Allocator>::_IsHeader(Node* node) {
+  return node->_red &&
+         (node->_parent == nullptr || node->_parent->_parent == node);
+}
+
+// in-order successor, the rightmost node is followed by the header
+template <class Key, class Compare, class Allocator>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_NextNode(Node* node) {
+  if (node->_right != nullptr) {
+    return _MinimalNode(node->_right);
+  }
+  Node* parent = node->_parent;
+  while (node == parent->_right) {
+    node = parent;
+    parent = parent->_parent;
+  }
+  // the root without a right subtree climbs to the header and back
+  return node->_right != parent ? parent : node;
+}
+
+// in-order predecessor, the header is preceded by the rightmost node
+template <class Key, class Compare, class Allocator>
+typename s21::BST<Key, Compare, Allocator>::Node*
+s21::BST<Key, Compare, Allocator>::_PrevNode(Node* node) {
+  if (_IsHeader(node)) {
+    return node->_right;
+  }
+  if (node->_left != nullptr) {
+    return _MaximalNode(node->_left);
+  }
+  Node* parent = node->_parent;
+  while (node == parent->_left) {
+    node = parent;
+    parent = parent->_parent;
+  }
+  return parent;
+}
+
+// the node is unlinked, not copied over, so iterators to other elements stay
+// valid
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_EraseNode(Node* node) {
+  if (node == _header._left) {
+    _header._left = node->_right != nullptr ? _MinimalNode(node->_right)
+                                            : node->_parent;
+  }
+  if (node == _header._right) {
+    _header._right = node->_left != nullptr ? _MaximalNode(node->_left)
+                                            : node->_parent;
+  }
+  bool removedRed = node->_red;
+  Node* child;
+  Node* childParent;
+  if (node->_left == nullptr) {
+    child = node->_right;
+    childParent = node->_parent;
+    _Transplant(node, node->_right);
+  } else if (node->_right == nullptr) {
+    child = node->_left;
+    childParent = node->_parent;
+    _Transplant(node, node->_left);
+  } else {
+    Node* successor = _MinimalNode(node->_right);
+    removedRed = successor->_red;
+    child = successor->_right;
+    if (successor->_parent == node) {
+      childParent = successor;
+    } else {
+      childParent = successor->_parent;
+      _Transplant(successor, successor->_right);
+      successor->_right = node->_right;
+      successor->_right->_parent = successor;
+    }
+    _Transplant(node, successor);
+    successor->_left = node->_left;
+    successor->_left->_parent = successor;
+    successor->_red = node->_red;
+  }
+  _DestroyNode(node);
+  _size--;
+  if (_size == 0) {
+    _ResetHeader();
+  } else if (!removedRed) {
+    _EraseFixup(child, childParent);
+  }
+}
+
+// Fills an empty tree from [first, last). Unsorted keys are copied and
+// stably sorted once, so equal keys keep their order, and with unique only
+// the first of equal keys is kept. Sorted random access input without
+// duplicates to drop is read in place.
+template <class Key, class Compare, class Allocator>
+template <class InputIterator>
+void s21::BST<Key, Compare, Allocator>::_BuildTree(InputIterator first,
+                                          InputIterator last, bool sorted,
+                                          bool unique) {
+  auto equal = [this](const key_type& left, const key_type& right) {
+    return !_compare(left, right) && !_compare(right, left);
+  };
+  if constexpr (std::random_access_iterator<InputIterator>) {
+    if (sorted && (!unique || std::adjacent_find(first, last, equal) == last)) {
+      _BuildFromSorted(first, static_cast<size_type>(last - first));
+      return;
+    }
+  }
+  std::vector<key_type, Allocator> keys(first, last,
+                                        Allocator(_nodePool.get_allocator()));
+  if (!sorted) {
+    std::stable_sort(keys.begin(), keys.end(), _compare);
+  }
+  auto keysEnd = keys.end();
+  if (unique) {
+    keysEnd = std::unique(keys.begin(), keys.end(), equal);
+  }
+  _BuildFromSorted(keys.begin(),
+                   static_cast<size_type>(keysEnd - keys.begin()));
+}
+
+// Links count sorted keys into a perfectly balanced tree in one pass, each
+// range hangs its middle key from the parent and splits into the halves. The
+// halves differ by at most one key, so every level except the deepest one
+// is full, and making the deepest level red keeps the black height of all
+// paths equal without any rotation. The tree must be empty.
+template <class Key, class Compare, class Allocator>
+template <class RandomIterator>
+void s21::BST<Key, Compare, Allocator>::_BuildFromSorted(RandomIterator keys,
+                                                size_type count) {
+  struct Range {
+    size_type first;
+    size_type last;
+    size_type depth;
+    Node* parent;
+    bool toLeft;
+  };
+  size_type height = 0;
+  while ((size_type(2) << height) - 1 < count) {
+    height++;
+  }
+  // a range is split before its halves are pushed, so the stack never holds
+  // more than one pending right half per level
+  Range pending[2 * std::numeric_limits<size_type>::digits];
+  size_type top = 0;
+  if (count != 0) {
+    pending[top++] = Range{0, count, 0, &_header, false};
+  }
+  while (top != 0) {
+    Range range = pending[--top];
+    size_type middle = range.first + (range.last - range.first) / 2;
+    Node* node = _CreateNode(keys[middle], range.parent);
+    node->_red = range.depth == height && height != 0;
+    if (range.parent == &_header) {
+      _header._parent = node;
+    } else if (range.toLeft) {
+      range.parent->_left = node;
     } else {
-      _DeleteNode(tree->_right, key);
+      range.parent->_right = node;
+    }
+    _size++;
+    if (middle == 0) {
+      _header._left = node;
+    }
+    if (middle == count - 1) {
+      _header._right = node;
+    }
+    if (middle + 1 < range.last) {
+      pending[top++] = Range{middle + 1, range.last, range.depth + 1, node,
+                             false};
+    }
+    if (range.first < middle) {
+      pending[top++] = Range{range.first, middle, range.depth + 1, node, true};
     }
   }
 }
 
-template <class Key>
-void s21::BST<Key>::_DeleteAllTree(Node*& tree) {
-  if (tree != nullptr) {
+// rotates left subtrees up into a right spine and frees the spine, no
+// recursion and no parent bookkeeping. Trivial keys need no destructor, so
+// the pool chunks are returned without visiting the nodes at all
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_Clear() {
+  Node* tree = _Root();
+  if constexpr (std::is_trivially_destructible_v<key_type>) {
+    tree = nullptr;
+  }
+  while (tree != nullptr) {
     if (tree->_left != nullptr) {
-      _DeleteAllTree(tree->_left);
+      Node* left = tree->_left;
+      tree->_left = left->_right;
+      left->_right = tree;
+      tree = left;
+    } else {
+      Node* right = tree->_right;
+      _DestroyNode(tree);
+      tree = right;
     }
-    if (tree->_right != nullptr) {
-      _DeleteAllTree(tree->_right);
+  }
+  _nodePool.Release();
+  _ResetHeader();
+}
+
+// exchanges the nodes of two trees together with the pools that own them,
+// the headers stay where they are
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_SwapTree(BST& other) {
+  _nodePool.Swap(other._nodePool);
+  std::swap(_header._parent, other._header._parent);
+  std::swap(_header._left, other._header._left);
+  std::swap(_header._right, other._header._right);
+  std::swap(_size, other._size);
+  std::swap(_compare, other._compare);
+  for (BST* tree : {this, &other}) {
+    if (tree->_size == 0) {
+      tree->_ResetHeader();
+    } else {
+      tree->_header._parent->_parent = &tree->_header;
     }
-    delete tree;
-    tree = nullptr;
   }
 }
 
-template <class Key>
-s21::BST<Key>::~BST() {
-  _DeleteAllTree(this->_root);
+template <class Key, class Compare, class Allocator>
+s21::BST<Key, Compare, Allocator>::~BST() {
+  _Clear();
+}
+
+// Balancing
+// -----------------------------------------------------------------------------
+
+// puts replacement where node hangs from its parent
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_Transplant(Node* node,
+                                                    Node* replacement) {
+  if (node->_parent == &_header) {
+    _header._parent = replacement;
+  } else if (node == node->_parent->_left) {
+    node->_parent->_left = replacement;
+  } else {
+    node->_parent->_right = replacement;
+  }
+  if (replacement != nullptr) {
+    replacement->_parent = node->_parent;
+  }
+}
+
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_RotateLeft(Node* node) {
+  Node* pivot = node->_right;
+  node->_right = pivot->_left;
+  if (pivot->_left != nullptr) {
+    pivot->_left->_parent = node;
+  }
+  _Transplant(node, pivot);
+  pivot->_left = node;
+  node->_parent = pivot;
+}
+
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_RotateRight(Node* node) {
+  Node* pivot = node->_left;
+  node->_left = pivot->_right;
+  if (pivot->_right != nullptr) {
+    pivot->_right->_parent = node;
+  }
+  _Transplant(node, pivot);
+  pivot->_right = node;
+  node->_parent = pivot;
 }
 
-template <class Key>
-typename s21::BST<Key>::Node* s21::BST<Key>::_MinNodeWithOut(
-    Node*& tree, Node*& changeNode) {
-  return tree->_left == nullptr || tree->_left == changeNode
-             ? tree
-             : _MinNodeWithOut(tree->_left, changeNode);
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_InsertFixup(Node* node) {
+  while (node != _Root() && node->_parent->_red) {
+    Node* parent = node->_parent;
+    Node* grand = parent->_parent;
+    if (parent == grand->_left) {
+      Node* uncle = grand->_right;
+      if (_IsRed(uncle)) {
+        parent->_red = false;
+        uncle->_red = false;
+        grand->_red = true;
+        node = grand;
+      } else {
+        if (node == parent->_right) {
+          node = parent;
+          _RotateLeft(node);
+          parent = node->_parent;
+        }
+        parent->_red = false;
+        grand->_red = true;
+        _RotateRight(grand);
+      }
+    } else {
+      Node* uncle = grand->_left;
+      if (_IsRed(uncle)) {
+        parent->_red = false;
+        uncle->_red = false;
+        grand->_red = true;
+        node = grand;
+      } else {
+        if (node == parent->_left) {
+          node = parent;
+          _RotateRight(node);
+          parent = node->_parent;
+        }
+        parent->_red = false;
+        grand->_red = true;
+        _RotateLeft(grand);
+      }
+    }
+  }
+  _Root()->_red = false;
 }
 
-template <class Key>
-typename s21::BST<Key>::Node* s21::BST<Key>::_MaxNodeWithOut(
-    Node*& tree, Node*& changeNode) {
-  return tree->_right == nullptr || tree->_right == changeNode
-             ? tree
-             : _MaxNodeWithOut(tree->_right, changeNode);
+// node carries an extra black and may be null, hence the explicit parent
+template <class Key, class Compare, class Allocator>
+void s21::BST<Key, Compare, Allocator>::_EraseFixup(Node* node, Node* parent) {
+  while (node != _Root() && !_IsRed(node)) {
+    if (node == parent->_left) {
+      Node* sibling = parent->_right;
+      if (sibling->_red) {
+        sibling->_red = false;
+        parent->_red = true;
+        _RotateLeft(parent);
+        sibling = parent->_right;
+      }
+      if (!_IsRed(sibling->_left) && !_IsRed(sibling->_right)) {
+        sibling->_red = true;
+        node = parent;
+        parent = node->_parent;
+      } else {
+        if (!_IsRed(sibling->_right)) {
+          sibling->_left->_red = false;
+          sibling->_red = true;
+          _RotateRight(sibling);
+          sibling = parent->_right;
+        }
+        sibling->_red = parent->_red;
+        parent->_red = false;
+        sibling->_right->_red = false;
+        _RotateLeft(parent);
+        node = _Root();
+      }
+    } else {
+      Node* sibling = parent->_left;
+      if (sibling->_red) {
+        sibling->_red = false;
+        parent->_red = true;
+        _RotateRight(parent);
+        sibling = parent->_left;
+      }
+      if (!_IsRed(sibling->_left) && !_IsRed(sibling->_right)) {
+        sibling->_red = true;
+        node = parent;
+        parent = node->_parent;
+      } else {
+        if (!_IsRed(sibling->_left)) {
+          sibling->_right->_red = false;
+          sibling->_red = true;
+          _RotateLeft(sibling);
+          sibling = parent->_left;
+        }
+        sibling->_red = parent->_red;
+        parent->_red = false;
+        sibling->_left->_red = false;
+        _RotateRight(parent);
+        node = _Root();
+      }
+    }
+  }
+  if (node != nullptr) {
+    node->_red = false;
+  }
 }
+// -----------------------------------------------------------------------------
 
 #endif  // S21_BINARY_SEARCH_TREE_H
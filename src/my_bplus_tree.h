@@ -0,0 +1,1107 @@
+#ifndef MY_BPLUS_TREE_H
+#define MY_BPLUS_TREE_H
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace s21 {
+namespace bplus_tree {
+//  Arithmetic keys under the default ordering are searched inside a node
+//  with SIMD compares, any other key with a binary search through Compare.
+template<typename Key, typename Compare>
+inline constexpr bool SimdSearch{std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool> &&
+                                 (sizeof(Key) == 1 || sizeof(Key) == 2 || sizeof(Key) == 4 || sizeof(Key) == 8) &&
+                                 (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>>)};
+
+#if defined(__SSE2__)
+template<typename Key>
+inline __m128i Splat(Key key) {
+  if constexpr (sizeof(Key) == 1) {
+    return _mm_set1_epi8(static_cast<char>(key));
+  } else if constexpr (sizeof(Key) == 2) {
+    return _mm_set1_epi16(static_cast<short>(key));
+  } else if constexpr (sizeof(Key) == 4) {
+    return _mm_set1_epi32(static_cast<int>(key));
+  } else {
+    return _mm_set1_epi64x(static_cast<long long>(key));
+  }
+}
+
+//  signed lane-wise left > right, SSE2 has no 64-bit compare: there the high
+//  halves decide unless they are equal, then the low halves compared as
+//  unsigned do, and only the sign bit of each lane is meaningful
+template<size_t Size>
+inline __m128i Greater(__m128i left, __m128i right) {
+  if constexpr (Size == 1) {
+    return _mm_cmpgt_epi8(left, right);
+  } else if constexpr (Size == 2) {
+    return _mm_cmpgt_epi16(left, right);
+  } else if constexpr (Size == 4) {
+    return _mm_cmpgt_epi32(left, right);
+  } else {
+#if defined(__SSE4_2__)
+    return _mm_cmpgt_epi64(left, right);
+#else
+    const __m128i bias = _mm_set_epi32(0, INT32_MIN, 0, INT32_MIN);
+    __m128i high = _mm_cmpgt_epi32(left, right);
+    __m128i equal = _mm_cmpeq_epi32(left, right);
+    __m128i low = _mm_cmpgt_epi32(_mm_xor_si128(left, bias), _mm_xor_si128(right, bias));
+    return _mm_or_si128(high, _mm_and_si128(equal, _mm_slli_epi64(low, 32)));
+#endif
+  }
+}
+
+//  one bit per lane, taken from the sign bit of the lane
+template<size_t Size>
+inline unsigned LaneBits(__m128i mask) {
+  if constexpr (Size == 1) {
+    return static_cast<unsigned>(_mm_movemask_epi8(mask));
+  } else if constexpr (Size == 2) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(mask, _mm_setzero_si128())));
+  } else if constexpr (Size == 4) {
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+  } else {
+    return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(mask)));
+  }
+}
+
+//  a bit for every key of the 16 bytes at block that is less than key, or
+//  with Upper not greater than it; unsigned keys are biased into signed
+//  ones so that the signed compares order them
+template<bool Upper, typename Key>
+inline unsigned MatchBlock(const Key *block, Key key) {
+  constexpr unsigned AllLanes{(1u << (16 / sizeof(Key))) - 1};
+  if constexpr (std::is_same_v<Key, float>) {
+    __m128 keys = _mm_loadu_ps(block), probe = _mm_set1_ps(key);
+    return static_cast<unsigned>(_mm_movemask_ps(Upper ? _mm_cmple_ps(keys, probe) : _mm_cmplt_ps(keys, probe)));
+  } else if constexpr (std::is_floating_point_v<Key>) {
+    __m128d keys = _mm_loadu_pd(block), probe = _mm_set1_pd(key);
+    return static_cast<unsigned>(_mm_movemask_pd(Upper ? _mm_cmple_pd(keys, probe) : _mm_cmplt_pd(keys, probe)));
+  } else {
+    __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+    __m128i probe = Splat(key);
+    if constexpr (std::is_unsigned_v<Key>) {
+      __m128i bias = Splat(static_cast<Key>(static_cast<Key>(1) << (sizeof(Key) * 8 - 1)));
+      keys = _mm_xor_si128(keys, bias);
+      probe = _mm_xor_si128(probe, bias);
+    }
+    if constexpr (Upper) {
+      return ~LaneBits<sizeof(Key)>(Greater<sizeof(Key)>(keys, probe)) & AllLanes;
+    } else {
+      return LaneBits<sizeof(Key)>(Greater<sizeof(Key)>(probe, keys));
+    }
+  }
+}
+#endif
+
+//  The number of keys in [keys, keys + count) less than key, or with Upper
+//  not greater than it: the lower or upper bound, since the keys are sorted.
+//  A branchless binary search narrows the keys down to one cache line,
+//  which is compared 16 bytes at a time, so a search reads about as many
+//  lines as a binary search but takes no unpredictable branch and only a
+//  few compares in the last line. The matching lanes of sorted keys are
+//  the lowest ones, so they are counted with one bit scan rather than a
+//  popcount, which x86-64 only has as an extension. The tail that does not
+//  fill a register is counted one key at a time.
+template<bool Upper, typename Key>
+inline size_t Rank(const Key *keys, size_t count, Key key) {
+  constexpr size_t Window{64 / sizeof(Key)};
+  const Key *window = keys;
+  while (count > Window) {
+    size_t half = count / 2;
+    bool right = Upper ? !(key < window[half - 1]) : window[half - 1] < key;
+    window += right ? half : 0;
+    count = right ? count - half : half;
+  }
+  size_t rank = static_cast<size_t>(window - keys), i{0};
+#if defined(__SSE2__)
+  constexpr size_t Lanes{16 / sizeof(Key)};
+  uint64_t matched{0};
+  for (; i + Lanes <= count; i += Lanes) {
+    matched |= static_cast<uint64_t>(MatchBlock<Upper>(window + i, key)) << i;
+  }
+  rank += static_cast<size_t>(std::countr_one(matched));
+#endif
+  for (; i < count; i++) {
+    rank += static_cast<size_t>(Upper ? !(key < window[i]) : window[i] < key);
+  }
+  return rank;
+}
+
+//  How the tree gets the key of an element, and what its iterators yield.
+template<typename Key, typename T>
+struct MapTraits {
+  typedef std::pair<Key, T> value_type;
+  typedef value_type iterated_type;
+  static const Key &KeyOf(const value_type &value) {return value.first;}
+};
+
+template<typename Key>
+struct SetTraits {
+  typedef Key value_type;
+  typedef const Key iterated_type;
+  static const Key &KeyOf(const value_type &value) {return value;}
+};
+
+//  Nodes are aligned to a cache line. The arrays sit in unions so that the
+//  tree constructs and destroys their live prefix itself.
+inline constexpr size_t CacheLine{64};
+
+struct Node {
+  size_t Count{0};
+};
+
+template<typename Value, size_t Slots>
+struct alignas(CacheLine) Leaf : Node {
+  Leaf *Prev{nullptr};
+  Leaf *Next{nullptr};
+  union {
+    Value Values[Slots];
+  };
+
+  Leaf() {}
+  ~Leaf() {}
+};
+
+template<typename Key, size_t Slots>
+struct alignas(CacheLine) Inner : Node {
+  //  Keys[i] is the smallest key under Children[i + 1]
+  union {
+    Key Keys[Slots];
+  };
+  Node *Children[Slots + 1];
+
+  Inner() {}
+  ~Inner() {}
+};
+}
+
+//  Walks the linked leaves, the end of a tree is one past the last element
+//  of its last leaf, so it can be decremented like any other position.
+template<typename LeafType, typename Type>
+class BPlusTreeIterator {
+ public:
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef std::remove_cv_t<Type> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Type *pointer;
+  typedef Type &reference;
+
+  BPlusTreeIterator() {}
+
+  BPlusTreeIterator(LeafType *leaf, size_t slot) : Leaf(leaf), Slot(slot) {}
+
+  reference operator*() const {return Leaf->Values[Slot];}
+
+  pointer operator->() const {return Leaf->Values + Slot;}
+
+  BPlusTreeIterator &operator++() {
+    if (++Slot == Leaf->Count && Leaf->Next != nullptr) {
+      Leaf = Leaf->Next;
+      Slot = 0;
+    }
+    return *this;
+  }
+
+  BPlusTreeIterator operator++(int) {
+    BPlusTreeIterator old{*this};
+    ++*this;
+    return old;
+  }
+
+  BPlusTreeIterator &operator--() {
+    if (Slot == 0) {
+      Leaf = Leaf->Prev;
+      Slot = Leaf->Count;
+    }
+    Slot--;
+    return *this;
+  }
+
+  BPlusTreeIterator operator--(int) {
+    BPlusTreeIterator old{*this};
+    --*this;
+    return old;
+  }
+
+  bool operator==(const BPlusTreeIterator &other) const {return Leaf == other.Leaf && Slot == other.Slot;}
+
+ private:
+  template<typename, typename, typename, typename, size_t>
+  friend class BPlusTree;
+
+  LeafType *Leaf{nullptr};
+  size_t Slot{0};
+};
+
+//  B+-tree: the elements live in the leaves, which are linked in order, and
+//  the inner nodes hold only separator keys and child pointers. A node is
+//  NodeBytes large, so a lookup in a tree of n elements touches about
+//  log(n) / log(NodeBytes / (sizeof(Key) + 8)) nodes, each a few adjacent
+//  cache lines that the prefetcher streams in, instead of one scattered
+//  node per level of a binary tree. An insert shifts at most one leaf,
+//  instead of the tail of a whole sorted array.
+//
+//  Arithmetic keys under the default ordering are searched inside a node
+//  by comparing 16 bytes of keys at a time (bplus_tree::Rank). The leaves
+//  of a map hold whole pairs, so there the search is a binary one over the
+//  slots, while the leaves of a set are plain key arrays and use Rank too.
+//
+//  Nodes are split when an insert finds them full and merged with, or
+//  topped up from, a sibling when an erase leaves them less than half full.
+//  Any insert or erase may invalidate iterators. BTreeMap and BTreeSet fill
+//  in the interface of Map and set on top of this class.
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+class BPlusTree {
+ protected:
+  //  as in Map, lookups take any K a transparent Compare orders against Key
+  template<typename K>
+  static constexpr bool Transparent{!std::is_same_v<K, Key> &&
+                                    requires(const Compare &comp, const Key &key, const K &other) {
+    typename Compare::is_transparent;
+    {comp(key, other)} -> std::convertible_to<bool>;
+    {comp(other, key)} -> std::convertible_to<bool>;
+  }};
+
+ public:
+  typedef Key key_type;
+  typedef typename Traits::value_type value_type;
+  typedef value_type &reference;
+  typedef size_t size_type;
+
+  //  the slots of a node are what fits in NodeBytes after its header
+  static constexpr size_type LeafSlots{std::max<size_type>(
+      4, (NodeBytes - sizeof(bplus_tree::Node) - 2 * sizeof(void *)) / sizeof(value_type))};
+  static constexpr size_type InnerSlots{std::max<size_type>(
+      4, (NodeBytes - sizeof(bplus_tree::Node) - sizeof(bplus_tree::Node *)) / (sizeof(Key) + sizeof(bplus_tree::Node *)))};
+
+  typedef bplus_tree::Leaf<value_type, LeafSlots> LeafNode;
+  typedef bplus_tree::Inner<Key, InnerSlots> InnerNode;
+  typedef BPlusTreeIterator<LeafNode, typename Traits::iterated_type> iterator;
+  typedef std::pair<iterator, bool> isInserted;
+  typedef Allocator allocator_type;
+  typedef Compare key_compare;
+
+  BPlusTree() {}
+
+  explicit BPlusTree(const Allocator &alloc) : Alloc(alloc) {}
+
+  explicit BPlusTree(const Compare &comp, const Allocator &alloc = Allocator()) : Comp(comp), Alloc(alloc) {}
+
+  BPlusTree(std::initializer_list<value_type> const &items, const Allocator &alloc = Allocator())
+      : Alloc(alloc) {
+    for (auto iter{items.begin()}; iter != items.end(); iter++) {
+      Emplace(Traits::KeyOf(*iter), *iter);
+    }
+  }
+
+  //  sorts the elements by key once and fills the leaves in one pass, the
+  //  first of equal keys is kept
+  template<std::input_iterator InputIterator>
+  BPlusTree(InputIterator first, InputIterator last, const Allocator &alloc = Allocator()) : Alloc(alloc) {
+    Build(first, last, false);
+  }
+
+  template<std::input_iterator InputIterator>
+  BPlusTree(InputIterator first, InputIterator last, const Compare &comp, const Allocator &alloc = Allocator())
+      : Comp(comp), Alloc(alloc) {
+    Build(first, last, false);
+  }
+
+  BPlusTree(const BPlusTree &other)
+      : BPlusTree(other, AllocatorTraits::select_on_container_copy_construction(other.Alloc)) {}
+
+  BPlusTree(const BPlusTree &other, const Allocator &alloc) : Comp(other.Comp), Alloc(alloc) {
+    Build(iterator(other.First, 0), iterator(other.Last, other.Last == nullptr ? 0 : other.Last->Count), true);
+  }
+
+  BPlusTree(BPlusTree &&other) : Comp(other.Comp), Alloc(std::move(other.Alloc)) {SwapTree(other);}
+
+  ~BPlusTree() {clear();}
+
+  void operator=(BPlusTree &&other);
+
+  void clear();
+
+  void erase(iterator position);
+
+  void swap(BPlusTree &other);
+
+  //  inserts the elements of other whose keys are missing here, a key
+  //  present in both keeps the element of this tree
+  void merge(BPlusTree &other);
+
+  //  nodes are allocated as the tree grows, kept for the interface of Map
+  void reserve(size_type) {}
+
+  bool empty() {return TreeSize == 0;}
+
+  size_type size() {return TreeSize;}
+
+  //  the slots of the allocated leaves
+  size_type max_size() {return LeafCount * LeafSlots;}
+
+  //  the levels of inner nodes above the leaves
+  size_type height() {return Height;}
+
+  iterator begin() {return iterator(First, 0);}
+
+  iterator end() {return iterator(Last, Last == nullptr ? 0 : Last->Count);}
+
+  allocator_type get_allocator() {return Alloc;}
+
+  key_compare key_comp() {return Comp;}
+
+  bool contains(const key_type &key) {return Find(key) != end();}
+
+  template<typename K>
+  requires Transparent<K>
+  bool contains(const K &key) {return Find(key) != end();}
+
+  size_type count(const key_type &key) {return contains(key) ? 1 : 0;}
+
+  template<typename K>
+  requires Transparent<K>
+  size_type count(const K &key) {return contains(key) ? 1 : 0;}
+
+  iterator find(const key_type &key) {return Find(key);}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator find(const K &key) {return Find(key);}
+
+  //  the first element whose key is not less than key, a range scan walks
+  //  on from here through the linked leaves
+  iterator lower_bound(const key_type &key) {return Bound<false>(key);}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator lower_bound(const K &key) {return Bound<false>(key);}
+
+  //  the first element whose key is greater than key
+  iterator upper_bound(const key_type &key) {return Bound<true>(key);}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator upper_bound(const K &key) {return Bound<true>(key);}
+
+ protected:
+  //  the inner nodes met on the way down and which child was taken in each
+  struct PathStep {
+    InnerNode *Inner;
+    size_type Child;
+  };
+
+  //  deeper than any tree that fits in memory, every inner node but the
+  //  root has at least InnerSlots / 2 + 1 children
+  static constexpr size_type MaxHeight{64};
+
+  //  inserts an element built from args when key is absent, args may refer
+  //  to an element of the tree
+  template<typename K, typename... Args>
+  isInserted Emplace(const K &key, Args &&...args);
+
+  //  from an already sorted range into an empty tree, in O(n)
+  template<typename InputIterator>
+  void Build(InputIterator first, InputIterator last, bool sorted);
+
+ private:
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<Key> KeyAllocator;
+  typedef std::allocator_traits<KeyAllocator> KeyTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<LeafNode> LeafAllocator;
+  typedef std::allocator_traits<LeafAllocator> LeafTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<InnerNode> InnerAllocator;
+  typedef std::allocator_traits<InnerAllocator> InnerTraits;
+
+  static constexpr size_type PrefetchLines{std::min<size_type>(NodeBytes, 512) / bplus_tree::CacheLine};
+
+  static constexpr size_type MinLeaf{LeafSlots / 2};
+  static constexpr size_type MinInner{InnerSlots / 2};
+
+  bplus_tree::Node *Root{nullptr};
+  //  the ends of the list of leaves
+  LeafNode *First{nullptr};
+  LeafNode *Last{nullptr};
+  size_type TreeSize{0};
+  size_type Height{0};
+  size_type LeafCount{0};
+  [[no_unique_address]] Compare Comp;
+  [[no_unique_address]] Allocator Alloc;
+
+  template<typename Element>
+  static const Key &KeyFrom(const Element &element) {
+    if constexpr (std::is_same_v<Element, Key>) {
+      return element;
+    } else {
+      return Traits::KeyOf(element);
+    }
+  }
+
+  //  the lower bound of key in elements, or with Upper the upper bound
+  template<bool Upper, typename Element, typename K>
+  size_type Search(const Element *elements, size_type count, const K &key) const;
+
+  //  the child of inner whose subtree holds key
+  template<typename K>
+  size_type ChildIndex(const InnerNode *inner, const K &key) const {return Search<true>(inner->Keys, inner->Count, key);}
+
+  //  requests the first lines of a node at once, before its search reads
+  //  them one after another
+  static void Prefetch(const bplus_tree::Node *node) {
+#if defined(__GNUC__)
+    for (size_type line{0}; line < PrefetchLines; line++) {
+      __builtin_prefetch(reinterpret_cast<const char *>(node) + line * bplus_tree::CacheLine);
+    }
+#endif
+  }
+
+  template<typename K>
+  LeafNode *FindLeaf(const K &key, PathStep *path) const;
+
+  template<typename K>
+  iterator Find(const K &key);
+
+  template<bool Upper, typename K>
+  iterator Bound(const K &key);
+
+  LeafNode *NewLeaf();
+
+  InnerNode *NewInner();
+
+  void FreeLeaf(LeafNode *leaf);
+
+  //  destroys the keys of inner but not its children
+  void FreeInner(InnerNode *inner);
+
+  void DestroySubtree(bplus_tree::Node *node, size_type level);
+
+  void SwapTree(BPlusTree &other);
+
+  //  puts a new leaf after Last, for Build
+  LeafNode *AppendLeaf();
+
+  void InsertValue(LeafNode *leaf, size_type slot, value_type &&value);
+
+  void InsertKey(InnerNode *inner, size_type at, Key &&key, bplus_tree::Node *child);
+
+  //  slow path of Emplace, kept apart so the common case stays small
+  isInserted SplitInsert(PathStep *path, LeafNode *leaf, size_type slot, value_type &&value);
+
+  //  moves count elements of array starting at from into the start of to
+  template<typename Type>
+  void MoveRange(Type *from, size_type count, Type *to);
+
+  void MergeLeaves(LeafNode *left, LeafNode *right);
+
+  void RebalanceLeaf(PathStep *path, LeafNode *leaf);
+
+  //  drops the key before the child at child and the child itself from the
+  //  inner node at level of path, the child is already freed
+  void RemoveChild(PathStep *path, size_type level, size_type child);
+
+  void RebalanceInner(PathStep *path, size_type level);
+};
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+template<bool Upper, typename Element, typename K>
+inline typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::size_type
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::Search(const Element *elements, size_type count,
+                                                               const K &key) const {
+  if constexpr (std::is_same_v<Element, Key> && std::is_same_v<K, Key> && bplus_tree::SimdSearch<Key, Compare>) {
+    return bplus_tree::Rank<Upper>(elements, count, key);
+  } else {
+    size_type left{0};
+    while (count != 0) {
+      size_type half = count / 2;
+      bool right = Upper ? !Comp(key, KeyFrom(elements[left + half])) : Comp(KeyFrom(elements[left + half]), key);
+      if (right) {
+        left += half + 1;
+        count -= half + 1;
+      } else {
+        count = half;
+      }
+    }
+    return left;
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+template<typename K>
+inline typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::LeafNode *
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::FindLeaf(const K &key, PathStep *path) const {
+  bplus_tree::Node *node = Root;
+  for (size_type level{0}; level < Height; level++) {
+    InnerNode *inner = static_cast<InnerNode *>(node);
+    size_type child = ChildIndex(inner, key);
+    if (path != nullptr) {
+      path[level] = PathStep{inner, child};
+    }
+    node = inner->Children[child];
+    Prefetch(node);
+  }
+  return static_cast<LeafNode *>(node);
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+template<typename K>
+typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::iterator
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::Find(const K &key) {
+  if (Root == nullptr) {
+    return end();
+  }
+  LeafNode *leaf = FindLeaf(key, nullptr);
+  size_type slot = Search<false>(leaf->Values, leaf->Count, key);
+  if (slot == leaf->Count || Comp(key, KeyFrom(leaf->Values[slot]))) {
+    return end();
+  }
+  return iterator(leaf, slot);
+}
+
+//  the bound may fall past the last element of a leaf, it is then the first
+//  element of the next one
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+template<bool Upper, typename K>
+typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::iterator
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::Bound(const K &key) {
+  if (Root == nullptr) {
+    return end();
+  }
+  LeafNode *leaf = FindLeaf(key, nullptr);
+  size_type slot = Search<Upper>(leaf->Values, leaf->Count, key);
+  if (slot == leaf->Count && leaf->Next != nullptr) {
+    return iterator(leaf->Next, 0);
+  }
+  return iterator(leaf, slot);
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::LeafNode *
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::NewLeaf() {
+  LeafAllocator leafAlloc(Alloc);
+  LeafNode *leaf = LeafTraits::allocate(leafAlloc, 1);
+  LeafTraits::construct(leafAlloc, leaf);
+  LeafCount++;
+  return leaf;
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::InnerNode *
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::NewInner() {
+  InnerAllocator innerAlloc(Alloc);
+  InnerNode *inner = InnerTraits::allocate(innerAlloc, 1);
+  InnerTraits::construct(innerAlloc, inner);
+  return inner;
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::FreeLeaf(LeafNode *leaf) {
+  for (size_type i{0}; i < leaf->Count; i++) {
+    AllocatorTraits::destroy(Alloc, leaf->Values + i);
+  }
+  LeafAllocator leafAlloc(Alloc);
+  LeafTraits::destroy(leafAlloc, leaf);
+  LeafTraits::deallocate(leafAlloc, leaf, 1);
+  LeafCount--;
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::FreeInner(InnerNode *inner) {
+  KeyAllocator keyAlloc(Alloc);
+  for (size_type i{0}; i < inner->Count; i++) {
+    KeyTraits::destroy(keyAlloc, inner->Keys + i);
+  }
+  InnerAllocator innerAlloc(Alloc);
+  InnerTraits::destroy(innerAlloc, inner);
+  InnerTraits::deallocate(innerAlloc, inner, 1);
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::DestroySubtree(bplus_tree::Node *node, size_type level) {
+  if (level == 0) {
+    FreeLeaf(static_cast<LeafNode *>(node));
+  } else {
+    InnerNode *inner = static_cast<InnerNode *>(node);
+    for (size_type i{0}; i <= inner->Count; i++) {
+      DestroySubtree(inner->Children[i], level - 1);
+    }
+    FreeInner(inner);
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::clear() {
+  if (Root != nullptr) {
+    DestroySubtree(Root, Height);
+  }
+  Root = nullptr;
+  First = nullptr;
+  Last = nullptr;
+  TreeSize = 0;
+  Height = 0;
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::SwapTree(BPlusTree &other) {
+  std::swap(Root, other.Root);
+  std::swap(First, other.First);
+  std::swap(Last, other.Last);
+  std::swap(TreeSize, other.TreeSize);
+  std::swap(Height, other.Height);
+  std::swap(LeafCount, other.LeafCount);
+  std::swap(Comp, other.Comp);
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::swap(BPlusTree &other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
+  }
+  SwapTree(other);
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::operator=(BPlusTree &&other) {
+  if (this != &other) {
+    clear();
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+      Alloc = std::move(other.Alloc);
+      SwapTree(other);
+    } else if (Alloc == other.Alloc) {
+      SwapTree(other);
+    } else {
+      Comp = other.Comp;
+      merge(other);
+    }
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::merge(BPlusTree &other) {
+  if (this != &other) {
+    for (LeafNode *leaf = other.First; leaf != nullptr; leaf = leaf->Next) {
+      for (size_type i{0}; i < leaf->Count; i++) {
+        Emplace(KeyFrom(leaf->Values[i]), std::as_const(leaf->Values[i]));
+      }
+    }
+    other.clear();
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+template<typename Type>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::MoveRange(Type *from, size_type count, Type *to) {
+  if constexpr (std::is_same_v<Type, Key> && !std::is_same_v<Key, value_type>) {
+    KeyAllocator keyAlloc(Alloc);
+    for (size_type i{0}; i < count; i++) {
+      KeyTraits::construct(keyAlloc, to + i, std::move(from[i]));
+      KeyTraits::destroy(keyAlloc, from + i);
+    }
+  } else {
+    for (size_type i{0}; i < count; i++) {
+      AllocatorTraits::construct(Alloc, to + i, std::move(from[i]));
+      AllocatorTraits::destroy(Alloc, from + i);
+    }
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::InsertValue(LeafNode *leaf, size_type slot,
+                                                                         value_type &&value) {
+  value_type *values = leaf->Values;
+  if (slot == leaf->Count) {
+    AllocatorTraits::construct(Alloc, values + slot, std::move(value));
+  } else {
+    AllocatorTraits::construct(Alloc, values + leaf->Count, std::move(values[leaf->Count - 1]));
+    std::move_backward(values + slot, values + leaf->Count - 1, values + leaf->Count);
+    values[slot] = std::move(value);
+  }
+  leaf->Count++;
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::InsertKey(InnerNode *inner, size_type at, Key &&key,
+                                                                       bplus_tree::Node *child) {
+  KeyAllocator keyAlloc(Alloc);
+  Key *keys = inner->Keys;
+  if (at == inner->Count) {
+    KeyTraits::construct(keyAlloc, keys + at, std::move(key));
+  } else {
+    KeyTraits::construct(keyAlloc, keys + inner->Count, std::move(keys[inner->Count - 1]));
+    std::move_backward(keys + at, keys + inner->Count - 1, keys + inner->Count);
+    keys[at] = std::move(key);
+  }
+  std::copy_backward(inner->Children + at + 1, inner->Children + inner->Count + 1, inner->Children + inner->Count + 2);
+  inner->Children[at + 1] = child;
+  inner->Count++;
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+template<typename K, typename... Args>
+typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::isInserted
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::Emplace(const K &key, Args &&...args) {
+  if (Root == nullptr) {
+    First = Last = NewLeaf();
+    Root = First;
+  }
+  PathStep path[MaxHeight];
+  LeafNode *leaf = FindLeaf(key, path);
+  size_type slot = Search<false>(leaf->Values, leaf->Count, key);
+  if (slot != leaf->Count && !Comp(key, KeyFrom(leaf->Values[slot]))) {
+    return std::make_pair(iterator(leaf, slot), false);
+  }
+  value_type value(std::forward<Args>(args)...);
+  if (leaf->Count == LeafSlots) {
+    return SplitInsert(path, leaf, slot, std::move(value));
+  }
+  InsertValue(leaf, slot, std::move(value));
+  TreeSize++;
+  return std::make_pair(iterator(leaf, slot), true);
+}
+
+//  Every node that is split is allocated, and the separator for the new
+//  leaf copied, before anything moves, so running out of memory leaves the
+//  tree as it was. A full leaf keeps the lower half of its elements and the
+//  new one goes to the half it belongs to; a full inner node on the way up
+//  is split the same way and its middle key moves up to the parent.
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::isInserted
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::SplitInsert(PathStep *path, LeafNode *leaf, size_type slot,
+                                                                    value_type &&value) {
+  size_type splits{0};
+  while (splits < Height && path[Height - 1 - splits].Inner->Count == InnerSlots) {
+    splits++;
+  }
+  size_type needed = splits + (splits == Height ? 1 : 0);
+  InnerNode *spare[MaxHeight + 1];
+  size_type made{0};
+  LeafNode *right = NewLeaf();
+  const size_type half{(LeafSlots + 1) / 2};
+  try {
+    for (; made < needed; made++) {
+      spare[made] = NewInner();
+    }
+    Key separator(slot == half ? KeyFrom(value) : KeyFrom(leaf->Values[slot < half ? half - 1 : half]));
+
+    size_type moved = slot < half ? half - 1 : half;
+    MoveRange(leaf->Values + moved, LeafSlots - moved, right->Values);
+    right->Count = LeafSlots - moved;
+    leaf->Count = moved;
+    right->Prev = leaf;
+    right->Next = leaf->Next;
+    (leaf->Next != nullptr ? leaf->Next->Prev : Last) = right;
+    leaf->Next = right;
+    iterator result = slot < half ? iterator(leaf, slot) : iterator(right, slot - half);
+    InsertValue(result.Leaf, result.Slot, std::move(value));
+    TreeSize++;
+
+    bplus_tree::Node *child = right;
+    for (size_type level{Height}; level-- > 0;) {
+      InnerNode *inner = path[level].Inner;
+      size_type at = path[level].Child;
+      if (inner->Count < InnerSlots) {
+        InsertKey(inner, at, std::move(separator), child);
+        return std::make_pair(result, true);
+      }
+      InnerNode *sibling = spare[--made];
+      const size_type middle{(InnerSlots + 1) / 2};
+      KeyAllocator keyAlloc(Alloc);
+      if (at < middle) {
+        MoveRange(inner->Keys + middle, InnerSlots - middle, sibling->Keys);
+        std::copy(inner->Children + middle, inner->Children + InnerSlots + 1, sibling->Children);
+        sibling->Count = InnerSlots - middle;
+        Key up(std::move(inner->Keys[middle - 1]));
+        KeyTraits::destroy(keyAlloc, inner->Keys + middle - 1);
+        inner->Count = middle - 1;
+        InsertKey(inner, at, std::move(separator), child);
+        separator = std::move(up);
+      } else if (at == middle) {
+        MoveRange(inner->Keys + middle, InnerSlots - middle, sibling->Keys);
+        std::copy(inner->Children + middle + 1, inner->Children + InnerSlots + 1, sibling->Children + 1);
+        sibling->Children[0] = child;
+        sibling->Count = InnerSlots - middle;
+        inner->Count = middle;
+      } else {
+        MoveRange(inner->Keys + middle + 1, InnerSlots - middle - 1, sibling->Keys);
+        std::copy(inner->Children + middle + 1, inner->Children + InnerSlots + 1, sibling->Children);
+        sibling->Count = InnerSlots - middle - 1;
+        Key up(std::move(inner->Keys[middle]));
+        KeyTraits::destroy(keyAlloc, inner->Keys + middle);
+        inner->Count = middle;
+        InsertKey(sibling, at - middle - 1, std::move(separator), child);
+        separator = std::move(up);
+      }
+      child = sibling;
+    }
+    InnerNode *root = spare[--made];
+    KeyAllocator keyAlloc(Alloc);
+    KeyTraits::construct(keyAlloc, root->Keys, std::move(separator));
+    root->Children[0] = Root;
+    root->Children[1] = child;
+    root->Count = 1;
+    Root = root;
+    Height++;
+    return std::make_pair(result, true);
+  } catch (...) {
+    while (made != 0) {
+      FreeInner(spare[--made]);
+    }
+    if (right->Count == 0) {
+      FreeLeaf(right);
+    }
+    throw;
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::erase(iterator position) {
+  PathStep path[MaxHeight];
+  LeafNode *leaf = FindLeaf(KeyFrom(*position), path);
+  value_type *values = leaf->Values;
+  std::move(values + position.Slot + 1, values + leaf->Count, values + position.Slot);
+  AllocatorTraits::destroy(Alloc, values + leaf->Count - 1);
+  leaf->Count--;
+  TreeSize--;
+  if (Height == 0) {
+    if (leaf->Count == 0) {
+      clear();
+    }
+  } else if (leaf->Count < MinLeaf) {
+    RebalanceLeaf(path, leaf);
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::MergeLeaves(LeafNode *left, LeafNode *right) {
+  MoveRange(right->Values, right->Count, left->Values + left->Count);
+  left->Count += right->Count;
+  right->Count = 0;
+  left->Next = right->Next;
+  (right->Next != nullptr ? right->Next->Prev : Last) = left;
+  FreeLeaf(right);
+}
+
+//  an underfull leaf is merged with a sibling when both fit in one leaf,
+//  otherwise it takes one element from that sibling
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::RebalanceLeaf(PathStep *path, LeafNode *leaf) {
+  InnerNode *parent = path[Height - 1].Inner;
+  size_type at = path[Height - 1].Child;
+  if (at != 0) {
+    LeafNode *left = static_cast<LeafNode *>(parent->Children[at - 1]);
+    if (left->Count + leaf->Count <= LeafSlots) {
+      MergeLeaves(left, leaf);
+      RemoveChild(path, Height - 1, at);
+    } else {
+      value_type borrowed(std::move(left->Values[left->Count - 1]));
+      AllocatorTraits::destroy(Alloc, left->Values + left->Count - 1);
+      left->Count--;
+      InsertValue(leaf, 0, std::move(borrowed));
+      parent->Keys[at - 1] = KeyFrom(leaf->Values[0]);
+    }
+  } else {
+    LeafNode *right = static_cast<LeafNode *>(parent->Children[1]);
+    if (leaf->Count + right->Count <= LeafSlots) {
+      MergeLeaves(leaf, right);
+      RemoveChild(path, Height - 1, 1);
+    } else {
+      AllocatorTraits::construct(Alloc, leaf->Values + leaf->Count, std::move(right->Values[0]));
+      leaf->Count++;
+      std::move(right->Values + 1, right->Values + right->Count, right->Values);
+      AllocatorTraits::destroy(Alloc, right->Values + right->Count - 1);
+      right->Count--;
+      parent->Keys[0] = KeyFrom(right->Values[0]);
+    }
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::RemoveChild(PathStep *path, size_type level,
+                                                                         size_type child) {
+  InnerNode *inner = path[level].Inner;
+  KeyAllocator keyAlloc(Alloc);
+  std::move(inner->Keys + child, inner->Keys + inner->Count, inner->Keys + child - 1);
+  KeyTraits::destroy(keyAlloc, inner->Keys + inner->Count - 1);
+  std::copy(inner->Children + child + 1, inner->Children + inner->Count + 1, inner->Children + child);
+  inner->Count--;
+  if (level == 0) {
+    if (inner->Count == 0) {
+      Root = inner->Children[0];
+      FreeInner(inner);
+      Height--;
+    }
+  } else if (inner->Count < MinInner) {
+    RebalanceInner(path, level);
+  }
+}
+
+//  as for leaves, except that the separator in the parent comes down into
+//  the merged node, or rotates through the parent when a key is borrowed
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::RebalanceInner(PathStep *path, size_type level) {
+  InnerNode *node = path[level].Inner;
+  InnerNode *parent = path[level - 1].Inner;
+  size_type at = path[level - 1].Child;
+  KeyAllocator keyAlloc(Alloc);
+  if (at != 0) {
+    InnerNode *left = static_cast<InnerNode *>(parent->Children[at - 1]);
+    if (left->Count + node->Count + 1 <= InnerSlots) {
+      KeyTraits::construct(keyAlloc, left->Keys + left->Count, std::move(parent->Keys[at - 1]));
+      MoveRange(node->Keys, node->Count, left->Keys + left->Count + 1);
+      std::copy(node->Children, node->Children + node->Count + 1, left->Children + left->Count + 1);
+      left->Count += node->Count + 1;
+      node->Count = 0;
+      FreeInner(node);
+      RemoveChild(path, level - 1, at);
+    } else {
+      InsertKey(node, 0, std::move(parent->Keys[at - 1]), node->Children[0]);
+      node->Children[0] = left->Children[left->Count];
+      parent->Keys[at - 1] = std::move(left->Keys[left->Count - 1]);
+      KeyTraits::destroy(keyAlloc, left->Keys + left->Count - 1);
+      left->Count--;
+    }
+  } else {
+    InnerNode *right = static_cast<InnerNode *>(parent->Children[1]);
+    if (node->Count + right->Count + 1 <= InnerSlots) {
+      KeyTraits::construct(keyAlloc, node->Keys + node->Count, std::move(parent->Keys[0]));
+      MoveRange(right->Keys, right->Count, node->Keys + node->Count + 1);
+      std::copy(right->Children, right->Children + right->Count + 1, node->Children + node->Count + 1);
+      node->Count += right->Count + 1;
+      right->Count = 0;
+      FreeInner(right);
+      RemoveChild(path, level - 1, 1);
+    } else {
+      InsertKey(node, node->Count, std::move(parent->Keys[0]), right->Children[0]);
+      parent->Keys[0] = std::move(right->Keys[0]);
+      std::move(right->Keys + 1, right->Keys + right->Count, right->Keys);
+      KeyTraits::destroy(keyAlloc, right->Keys + right->Count - 1);
+      std::copy(right->Children + 1, right->Children + right->Count + 1, right->Children);
+      right->Count--;
+    }
+  }
+}
+
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+typename BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::LeafNode *
+BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::AppendLeaf() {
+  LeafNode *leaf = NewLeaf();
+  leaf->Prev = Last;
+  (Last != nullptr ? Last->Next : First) = leaf;
+  Last = leaf;
+  return leaf;
+}
+
+//  The leaves are filled completely from left to right, then every level
+//  of inner nodes is built over the one below with the children spread
+//  evenly, the separators are copies of the first key under each child.
+template<typename Key, typename Traits, typename Compare, typename Allocator, size_t NodeBytes>
+template<typename InputIterator>
+void BPlusTree<Key, Traits, Compare, Allocator, NodeBytes>::Build(InputIterator first, InputIterator last,
+                                                                   bool sorted) {
+  if (!sorted) {
+    std::vector<value_type, Allocator> values(first, last, Alloc);
+    std::stable_sort(values.begin(), values.end(), [this](const value_type &left, const value_type &right) {
+      return Comp(KeyFrom(left), KeyFrom(right));
+    });
+    Build(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()), true);
+    return;
+  }
+  std::vector<bplus_tree::Node *> level;
+  std::vector<const Key *> lowest;
+  std::vector<InnerNode *> inners;
+  const value_type *previous{nullptr};
+  try {
+    for (; first != last; ++first) {
+      if (Last == nullptr || Last->Count == LeafSlots) {
+        AppendLeaf();
+        level.push_back(Last);
+      }
+      value_type *value = Last->Values + Last->Count;
+      AllocatorTraits::construct(Alloc, value, *first);
+      if (previous != nullptr && !Comp(KeyFrom(*previous), KeyFrom(*value))) {
+        AllocatorTraits::destroy(Alloc, value);
+        continue;
+      }
+      Last->Count++;
+      TreeSize++;
+      previous = value;
+    }
+    if (Last != nullptr && Last->Count == 0) {
+      LeafNode *empty = Last;
+      Last = empty->Prev;
+      (Last != nullptr ? Last->Next : First) = nullptr;
+      level.pop_back();
+      FreeLeaf(empty);
+    }
+    for (bplus_tree::Node *leaf : level) {
+      lowest.push_back(&KeyFrom(static_cast<LeafNode *>(leaf)->Values[0]));
+    }
+    inners.reserve(level.size());
+    KeyAllocator keyAlloc(Alloc);
+    while (level.size() > 1) {
+      size_type groups = (level.size() + InnerSlots) / (InnerSlots + 1);
+      std::vector<bplus_tree::Node *> above;
+      std::vector<const Key *> aboveLowest;
+      size_type next{0};
+      for (size_type group{0}; group < groups; group++) {
+        size_type children = level.size() / groups + (group < level.size() % groups ? 1 : 0);
+        InnerNode *inner = NewInner();
+        inners.push_back(inner);
+        inner->Children[0] = level[next];
+        for (size_type i{1}; i < children; i++) {
+          KeyTraits::construct(keyAlloc, inner->Keys + inner->Count, *lowest[next + i]);
+          inner->Children[i] = level[next + i];
+          inner->Count++;
+        }
+        above.push_back(inner);
+        aboveLowest.push_back(lowest[next]);
+        next += children;
+      }
+      level.swap(above);
+      lowest.swap(aboveLowest);
+      Height++;
+    }
+  } catch (...) {
+    for (InnerNode *inner : inners) {
+      FreeInner(inner);
+    }
+    while (First != nullptr) {
+      LeafNode *leaf = First;
+      First = leaf->Next;
+      FreeLeaf(leaf);
+    }
+    Last = nullptr;
+    TreeSize = 0;
+    Height = 0;
+    throw;
+  }
+  Root = level.empty() ? nullptr : level[0];
+}
+
+namespace bplus_tree {
+template<typename Key, typename T, typename Compare, typename Allocator, size_t NodeBytes>
+using MapTree = BPlusTree<Key, MapTraits<Key, T>, Compare, Allocator, NodeBytes>;
+
+template<typename Key, typename Compare, typename Allocator, size_t NodeBytes>
+using SetTree = BPlusTree<Key, SetTraits<Key>, Compare, Allocator, NodeBytes>;
+}
+}
+
+#endif // MY_BPLUS_TREE_H
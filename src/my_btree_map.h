@@ -0,0 +1,139 @@
+#ifndef MY_BTREE_MAP_H
+#define MY_BTREE_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "my_bplus_tree.h"
+#include "my_vector.h"
+
+namespace s21 {
+//  Ordered map on a B+-tree with the interface of Map, for maps too large
+//  for Map to insert into: an insert shifts one leaf instead of the tail of
+//  the whole array. Lookups touch a handful of NodeBytes sized nodes and a
+//  range scan runs along the linked leaves. Unlike Map it has no position
+//  lookup (FindPosition) and no Eytzinger index, and its iterators are
+//  bidirectional.
+template<typename Key, typename T, typename Compare = std::less<>,
+         typename Allocator = std::allocator<std::pair<Key, T>>, size_t NodeBytes = 512>
+class BTreeMap : public bplus_tree::MapTree<Key, T, Compare, Allocator, NodeBytes> {
+  typedef bplus_tree::MapTree<Key, T, Compare, Allocator, NodeBytes> Tree;
+
+  template<typename K>
+  static constexpr bool Transparent{Tree::template Transparent<K>};
+
+ public:
+  typedef T mapped_type;
+  typedef typename Tree::key_type key_type;
+  typedef typename Tree::value_type value_type;
+  typedef typename Tree::iterator iterator;
+  typedef typename Tree::isInserted isInserted;
+
+  using Tree::Tree;
+
+  //  from pairs already sorted by key, in O(n)
+  template<std::input_iterator InputIterator>
+  static BTreeMap from_sorted(InputIterator first, InputIterator last, const Allocator &alloc = Allocator()) {
+    return from_sorted(first, last, Compare(), alloc);
+  }
+
+  template<std::input_iterator InputIterator>
+  static BTreeMap from_sorted(InputIterator first, InputIterator last, const Compare &comp,
+                              const Allocator &alloc = Allocator()) {
+    BTreeMap result(comp, alloc);
+    result.Build(first, last, true);
+    return result;
+  }
+
+  isInserted insert(const value_type &value) {return this->Emplace(value.first, value);}
+
+  isInserted insert(const Key &key, const T &obj) {return this->Emplace(key, key, obj);}
+
+  isInserted insert_or_assign(const value_type &value) {
+    isInserted result = insert(value);
+    if (!result.second) {
+      result.first->second = value.second;
+      result.second = true;
+    }
+    return result;
+  }
+
+  mapped_type &at(const key_type &key) {return AtIterator(this->find(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  mapped_type &at(const K &key) {return AtIterator(this->find(key));}
+
+  //  inserts a value-initialized element when key is absent
+  mapped_type &operator[](const key_type &key) {
+    return this->Emplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple())
+        .first->second;
+  }
+
+  void emplace_back() {}
+  template <class Type, class... Args>
+  Vector<std::pair<iterator, bool>> emplace_back(Type data, Args... args) {
+    Vector<std::pair<iterator, bool>> res{};
+    std::initializer_list<Type> List{args...};
+    res.push_back(insert(data));
+    for (auto iter = List.begin(); iter < List.end(); iter++) {
+      res.push_back(insert(*iter));
+    }
+    return res;
+  }
+
+ private:
+  mapped_type &AtIterator(iterator found) {
+    if (found == this->end()) {
+      throw std::out_of_range("No such element");
+    }
+    return found->second;
+  }
+};
+
+//  The set counterpart, its leaves are plain sorted key arrays, so with
+//  arithmetic keys every level of a lookup is searched with SIMD.
+template<typename Key, typename Compare = std::less<>, typename Allocator = std::allocator<Key>,
+         size_t NodeBytes = 512>
+class BTreeSet : public bplus_tree::SetTree<Key, Compare, Allocator, NodeBytes> {
+  typedef bplus_tree::SetTree<Key, Compare, Allocator, NodeBytes> Tree;
+
+ public:
+  typedef typename Tree::value_type value_type;
+  typedef typename Tree::isInserted isInserted;
+
+  using Tree::Tree;
+
+  //  from keys already sorted, in O(n)
+  template<std::input_iterator InputIterator>
+  static BTreeSet from_sorted(InputIterator first, InputIterator last, const Allocator &alloc = Allocator()) {
+    return from_sorted(first, last, Compare(), alloc);
+  }
+
+  template<std::input_iterator InputIterator>
+  static BTreeSet from_sorted(InputIterator first, InputIterator last, const Compare &comp,
+                              const Allocator &alloc = Allocator()) {
+    BTreeSet result(comp, alloc);
+    result.Build(first, last, true);
+    return result;
+  }
+
+  isInserted insert(const value_type &value) {return this->Emplace(value, value);}
+};
+
+namespace pmr {
+template<typename Key, typename T, typename Compare = std::less<>>
+using BTreeMap = s21::BTreeMap<Key, T, Compare, std::pmr::polymorphic_allocator<std::pair<Key, T>>>;
+
+template<typename Key, typename Compare = std::less<>>
+using BTreeSet = s21::BTreeSet<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}
+}
+
+#endif // MY_BTREE_MAP_H
@@ -0,0 +1,298 @@
+#ifndef MY_CHUNKED_STORAGE_H
+#define MY_CHUNKED_STORAGE_H
+
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+//  Sequence that grows and shrinks at the back only. Elements are kept in a
+//  doubly linked list of fixed-size chunks, so push_back and pop_back are
+//  O(1) without amortization, an element never moves once constructed and
+//  chunks emptied by pop_back are kept and filled again by the next pushes.
+template<typename Type, typename Allocator = std::allocator<Type>>
+class ChunkedStorage {
+ public:
+  typedef size_t size_type;
+  typedef Type value_type;
+  typedef Type &reference;
+  typedef const Type &const_reference;
+  typedef Allocator allocator_type;
+
+  ChunkedStorage() {}
+
+  explicit ChunkedStorage(const Allocator &alloc) : Alloc(alloc) {}
+
+  ChunkedStorage(const ChunkedStorage &other)
+      : Alloc(AllocatorTraits::select_on_container_copy_construction(other.Alloc)) {
+    try {
+      CopyFrom(other);
+    } catch (...) {
+      clear();
+      ReleaseChunks(Bottom);
+      throw;
+    }
+  }
+
+  ChunkedStorage(ChunkedStorage &&other) : Alloc(std::move(other.Alloc)) {
+    SwapChunks(other);
+  }
+
+  ~ChunkedStorage() {
+    clear();
+    ReleaseChunks(Bottom);
+  }
+
+  void operator=(ChunkedStorage &&other);
+
+  void push_back(const_reference value) {emplace_back(value);}
+
+  void push_back(value_type &&value) {emplace_back(std::move(value));}
+
+  template<typename... Args>
+  reference emplace_back(Args &&...args);
+
+  void pop_back();
+
+  reference back();
+
+  bool empty() const {return Cursor == Floor;}
+
+  size_type size() const {
+    return Top == nullptr ? 0 : Top->Index * ChunkElements + Used(Top);
+  }
+
+  //  destroys the elements, the chunks stay for the next pushes
+  void clear();
+
+  //  frees the chunks that hold no element
+  void shrink_to_fit();
+
+  void swap(ChunkedStorage &other);
+
+  allocator_type get_allocator() const {return Alloc;}
+
+  //  elements per chunk, a chunk holds about 4 KiB of elements
+  static constexpr size_type ChunkElements{
+      sizeof(Type) * 8 > 4096 ? 8 : 4096 / sizeof(Type)};
+
+ private:
+  //  Index is the position of the chunk from the bottom, the size follows
+  //  from it and Cursor without a separate counter
+  struct Chunk {
+    Chunk *Prev;
+    Chunk *Next;
+    size_type Index;
+    alignas(Type) unsigned char Storage[ChunkElements * sizeof(Type)];
+
+    Type *Data() {return reinterpret_cast<Type *>(Storage);}
+  };
+
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<Chunk> ChunkAllocator;
+  typedef std::allocator_traits<ChunkAllocator> ChunkTraits;
+
+  //  Bottom is the first chunk, Top the one holding the last element, the
+  //  chunks after Top are spare. Floor and Limit are the bounds of Top and
+  //  Cursor is one past the last element. Top only stays empty when it is
+  //  Bottom, so the stack is empty exactly when Cursor meets Floor
+  Chunk *Bottom{nullptr};
+  Chunk *Top{nullptr};
+  Type *Floor{nullptr};
+  Type *Cursor{nullptr};
+  Type *Limit{nullptr};
+  [[no_unique_address]] Allocator Alloc;
+
+  Chunk *NewChunk(Chunk *Prev);
+
+  template<typename... Args>
+  reference EmplaceInNextChunk(Args &&...args);
+
+  void SetTop(Chunk *chunk) {
+    Top = chunk;
+    Floor = chunk->Data();
+    Limit = Floor + ChunkElements;
+  }
+
+  size_type Used(const Chunk *chunk) const {
+    return chunk == Top ? Cursor - Floor : ChunkElements;
+  }
+
+  void ReleaseChunks(Chunk *First);
+
+  void CopyFrom(const ChunkedStorage &other);
+
+  void SwapChunks(ChunkedStorage &other);
+};
+
+template<typename Type, typename Allocator>
+typename ChunkedStorage<Type, Allocator>::Chunk *
+ChunkedStorage<Type, Allocator>::NewChunk(Chunk *Prev) {
+  ChunkAllocator chunkAlloc(Alloc);
+  Chunk *chunk = ChunkTraits::allocate(chunkAlloc, 1);
+  chunk->Prev = Prev;
+  chunk->Next = nullptr;
+  chunk->Index = Prev == nullptr ? 0 : Prev->Index + 1;
+  if (Prev != nullptr) {
+    Prev->Next = chunk;
+  }
+  return chunk;
+}
+
+template<typename Type, typename Allocator>
+void ChunkedStorage<Type, Allocator>::ReleaseChunks(Chunk *First) {
+  ChunkAllocator chunkAlloc(Alloc);
+  if (First != nullptr && First->Prev != nullptr) {
+    First->Prev->Next = nullptr;
+  }
+  while (First != nullptr) {
+    Chunk *next = First->Next;
+    ChunkTraits::deallocate(chunkAlloc, First, 1);
+    First = next;
+  }
+}
+
+template<typename Type, typename Allocator>
+template<typename... Args>
+inline typename ChunkedStorage<Type, Allocator>::reference
+ChunkedStorage<Type, Allocator>::emplace_back(Args &&...args) {
+  if (Cursor == Limit) {
+    return EmplaceInNextChunk(std::forward<Args>(args)...);
+  }
+  AllocatorTraits::construct(Alloc, Cursor, std::forward<Args>(args)...);
+  return *Cursor++;
+}
+
+//  the state is updated only after the element is constructed
+template<typename Type, typename Allocator>
+template<typename... Args>
+typename ChunkedStorage<Type, Allocator>::reference
+ChunkedStorage<Type, Allocator>::EmplaceInNextChunk(Args &&...args) {
+  Chunk *target{nullptr};
+  if (Top == nullptr) {
+    //  a chunk left by a constructor that threw is reused
+    if (Bottom == nullptr) {
+      Bottom = NewChunk(nullptr);
+    }
+    target = Bottom;
+  } else if (Top->Next == nullptr) {
+    target = NewChunk(Top);
+  } else {
+    target = Top->Next;
+  }
+  AllocatorTraits::construct(Alloc, target->Data(), std::forward<Args>(args)...);
+  SetTop(target);
+  Cursor = Floor + 1;
+  return *target->Data();
+}
+
+template<typename Type, typename Allocator>
+inline void ChunkedStorage<Type, Allocator>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  AllocatorTraits::destroy(Alloc, --Cursor);
+  if (Cursor == Floor && Top->Prev != nullptr) {
+    SetTop(Top->Prev);
+    Cursor = Limit;
+  }
+}
+
+template<typename Type, typename Allocator>
+typename ChunkedStorage<Type, Allocator>::reference ChunkedStorage<Type, Allocator>::back() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  return Cursor[-1];
+}
+
+template<typename Type, typename Allocator>
+void ChunkedStorage<Type, Allocator>::clear() {
+  if constexpr (!std::is_trivially_destructible_v<Type>) {
+    while (!empty()) {
+      pop_back();
+    }
+  }
+  if (Bottom != nullptr) {
+    SetTop(Bottom);
+    Cursor = Floor;
+  }
+}
+
+template<typename Type, typename Allocator>
+void ChunkedStorage<Type, Allocator>::shrink_to_fit() {
+  if (empty()) {
+    ReleaseChunks(Bottom);
+    Bottom = Top = nullptr;
+    Floor = Cursor = Limit = nullptr;
+  } else {
+    ReleaseChunks(Top->Next);
+  }
+}
+
+template<typename Type, typename Allocator>
+void ChunkedStorage<Type, Allocator>::swap(ChunkedStorage &other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
+  }
+  SwapChunks(other);
+}
+
+template<typename Type, typename Allocator>
+void ChunkedStorage<Type, Allocator>::operator=(ChunkedStorage &&other) {
+  if (this == &other) {
+    return;
+  }
+  clear();
+  if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+    ReleaseChunks(Bottom);
+    Bottom = Top = nullptr;
+    Floor = Cursor = Limit = nullptr;
+    Alloc = std::move(other.Alloc);
+    SwapChunks(other);
+  } else if (Alloc == other.Alloc) {
+    SwapChunks(other);
+  } else {
+    if (!other.empty()) {
+      for (Chunk *chunk{other.Bottom}; chunk != other.Top->Next; chunk = chunk->Next) {
+        size_type used{other.Used(chunk)};
+        for (size_type i{0}; i < used; i++) {
+          emplace_back(std::move(chunk->Data()[i]));
+        }
+      }
+    }
+    other.clear();
+  }
+}
+
+template<typename Type, typename Allocator>
+void ChunkedStorage<Type, Allocator>::CopyFrom(const ChunkedStorage &other) {
+  if (other.empty()) {
+    return;
+  }
+  for (Chunk *chunk{other.Bottom}; chunk != other.Top->Next; chunk = chunk->Next) {
+    size_type used{other.Used(chunk)};
+    for (size_type i{0}; i < used; i++) {
+      push_back(chunk->Data()[i]);
+    }
+  }
+}
+
+template<typename Type, typename Allocator>
+void ChunkedStorage<Type, Allocator>::SwapChunks(ChunkedStorage &other) {
+  std::swap(Bottom, other.Bottom);
+  std::swap(Top, other.Top);
+  std::swap(Floor, other.Floor);
+  std::swap(Cursor, other.Cursor);
+  std::swap(Limit, other.Limit);
+}
+
+namespace pmr {
+template<typename Type>
+using ChunkedStorage = s21::ChunkedStorage<Type, std::pmr::polymorphic_allocator<Type>>;
+}
+}
+
+#endif // MY_CHUNKED_STORAGE_H
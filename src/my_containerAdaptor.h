@@ -2,186 +2,162 @@
 #define MY_CONTAINERADAPTOR_H
 
 #include <memory>
+#include <memory_resource>
 #include <initializer_list>
-#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "my_chunked_storage.h"
+#include "my_deque.h"
+#include "my_ring_buffer.h"
+#include "my_vector.h"
 
 namespace s21 {
-template<typename Type>
+//  Common part of Stack and Queue. The elements live in Container, which is
+//  chosen per workload like the container of std::stack: Vector keeps them
+//  contiguous, RingBuffer pops both ends in O(1) from one buffer, Deque pops
+//  both ends in O(1) and never moves them, ChunkedStorage never moves them
+//  either but grows at the back only. Pushes go straight to the back of the
+//  container, emplace builds the element in place and push_range hands the
+//  whole range to the container.
+template<typename Container>
 class ContainerAdaptor {
  public:
-  typedef size_t size_type;
-  typedef Type value_type;
-  typedef Type &reference;
-  typedef Type &const_reference;
+  typedef Container container_type;
+  typedef typename Container::size_type size_type;
+  typedef typename Container::value_type value_type;
+  typedef typename Container::reference reference;
+  typedef typename Container::const_reference const_reference;
+  typedef typename Container::allocator_type allocator_type;
 
   ContainerAdaptor() {
   }
 
-  ContainerAdaptor(std::initializer_list<value_type> const &items) {
-    Position = items.size() - 1;
-    Store.reset(new Type[items.size()]{});
-    auto iter{items.begin()};
-    for (int i{0}; iter != items.end(); i++, iter++) {
-      GetStore(i) = *iter;
-    }
+  explicit ContainerAdaptor(const allocator_type &alloc) : Store(alloc) {
   }
 
-  ContainerAdaptor(const ContainerAdaptor &old) {
-    Position = old.Position;
-    ReallocateStoreAfterPush(old);
+  explicit ContainerAdaptor(const Container &store) : Store(store) {
   }
 
-  ContainerAdaptor(ContainerAdaptor &&old) {
-    Position = old.Position;
-    Store.swap(old.Store);
-    old.Position = -1;
+  explicit ContainerAdaptor(Container &&store) : Store(std::move(store)) {
   }
 
-  ~ContainerAdaptor() {
+  ContainerAdaptor(std::initializer_list<value_type> const &items, const allocator_type &alloc = allocator_type())
+      : Store(alloc) {
+    push_range(items);
   }
 
-  void push(Type &value);
+  ContainerAdaptor(const ContainerAdaptor &old) = default;
 
-  bool empty();
+  ContainerAdaptor(ContainerAdaptor &&old) = default;
 
-  void swap(ContainerAdaptor &other);
+  void push(const value_type &value) {Store.push_back(value);}
 
-  void operator=(ContainerAdaptor &&old);
+  void push(value_type &&value) {Store.push_back(std::move(value));}
 
-  size_type size() {return Position + 1;}
+  template<typename... Args>
+  reference emplace(Args &&...args);
 
-  //  auxiliary methods
+  template<typename Range>
+  void push_range(Range &&range);
 
-  Type& GetStore(int pos) {return Store[pos];};
+  bool empty() {return Store.empty();}
 
-  int GetPosition() {return Position;}
+  void swap(ContainerAdaptor &other) {Store.swap(other.Store);}
 
-  void DecreasePosition() {Position -= 1;}
+  void operator=(ContainerAdaptor &&old) {Store = std::move(old.Store);}
 
- protected:
+  size_type size() {return Store.size();}
 
-  void ReallocateStoreAfterPush(const ContainerAdaptor &old);
+  allocator_type get_allocator() {return Store.get_allocator();}
 
-  void ReallocateStoreAfterPop(const ContainerAdaptor &old);
-
- private:
-  int Position{-1};
-  std::unique_ptr<Type[]> Store{new Type[1]{}};
+ protected:
+  Container Store;
 };
 
-template<typename Type>
-class Stack : public ContainerAdaptor<Type> {
-  using ContainerAdaptor<Type>::ContainerAdaptor;
+//  The storage throws std::out_of_range when top or pop is called on an
+//  empty stack.
+template<typename Type, typename Container = Vector<Type>>
+class Stack : public ContainerAdaptor<Container> {
+  using ContainerAdaptor<Container>::ContainerAdaptor;
+  static_assert(std::is_same_v<Type, typename Container::value_type>);
  public:
-  void pop() {
-    if (ContainerAdaptor<Type>::empty()) {
-      throw std::out_of_range("No such element");
-    }
-    top() = 0;
-    ContainerAdaptor<Type>::DecreasePosition();
+  ContainerAdaptor<Container>::reference top() {
+    return this->Store.back();
   }
 
-  ContainerAdaptor<Type>::reference top() {
-    if (ContainerAdaptor<Type>::empty()) {
-      throw std::out_of_range("No such element");
-    }
-    return ContainerAdaptor<Type>::GetStore(ContainerAdaptor<Type>::GetPosition());
+  void pop() {
+    this->Store.pop_back();
   }
 
   void emplace_front() {}
   template <class T, class... Args>
   void emplace_front(T data, Args... args) {
-    ContainerAdaptor<Type>::push(data);
+    ContainerAdaptor<Container>::push(std::move(data));
     emplace_front(args...);
   }
  private:
 };
 
-template<typename Type>
-class Queue : public ContainerAdaptor<Type> {
-  using ContainerAdaptor<Type>::ContainerAdaptor;
+template<typename Type, typename Container = Deque<Type>>
+class Queue : public ContainerAdaptor<Container> {
+  using ContainerAdaptor<Container>::ContainerAdaptor;
+  static_assert(std::is_same_v<Type, typename Container::value_type>);
  public:
-  ContainerAdaptor<Type>::reference front() {
-    if (ContainerAdaptor<Type>::empty()) {
-      throw std::out_of_range("No such element");
-    }
-    return ContainerAdaptor<Type>::GetStore(0);
+  ContainerAdaptor<Container>::reference front() {
+    return this->Store.front();
   }
 
-  ContainerAdaptor<Type>::reference back() {
-    if (ContainerAdaptor<Type>::empty()) {
-      throw std::out_of_range("No such element");
-    }
-    return ContainerAdaptor<Type>::GetStore(ContainerAdaptor<Type>::GetPosition());
+  ContainerAdaptor<Container>::reference back() {
+    return this->Store.back();
   }
 
   void emplace_back() {}
   template <class T, class... Args>
   void emplace_back(T data, Args... args) {
-    ContainerAdaptor<Type>::push(data);
+    ContainerAdaptor<Container>::push(std::move(data));
     emplace_back(args...);
   }
 
   void pop() {
-    if (ContainerAdaptor<Type>::empty()) {
-      throw std::out_of_range("No such element");
-    }
-    front() = 0;
-    ContainerAdaptor<Type>::DecreasePosition();
-    ContainerAdaptor<Type>::ReallocateStoreAfterPop(*this);
+    this->Store.pop_front();
   }
  private:
 };
 
-template<typename Type>
-void ContainerAdaptor<Type>::operator=(ContainerAdaptor &&old) {
-  Position = old.Position;
-  ReallocateStoreAfterPush(old);
-}
-
-template<typename Type>
-void ContainerAdaptor<Type>::swap(ContainerAdaptor &other){
-  std::swap(Position, other.Position);
-  Store.swap(other.Store);
-}
-
-
-template<typename Type>
-void ContainerAdaptor<Type>::push(Type &value) {
-    Position += 1;
-    ReallocateStoreAfterPush(*this);
-    Store[Position] = value;
+//  the s21 sequences use emplace_back to push each of its arguments, they
+//  build a single element with EmplaceBack
+template<typename Container>
+template<typename... Args>
+typename ContainerAdaptor<Container>::reference ContainerAdaptor<Container>::emplace(Args &&...args) {
+  if constexpr (requires {Store.EmplaceBack(std::forward<Args>(args)...);}) {
+    return Store.EmplaceBack(std::forward<Args>(args)...);
+  } else {
+    return Store.emplace_back(std::forward<Args>(args)...);
   }
+}
 
-
-template<typename Type>
-bool ContainerAdaptor<Type>::empty() {
-    bool result = false;
-    if (Position < 0) {
-      result = true;
+//  elements are forwarded as the range yields them, a range of rvalues is
+//  moved into the container
+template<typename Container>
+template<typename Range>
+void ContainerAdaptor<Container>::push_range(Range &&range) {
+  if constexpr (requires {Store.append_range(std::forward<Range>(range));}) {
+    Store.append_range(std::forward<Range>(range));
+  } else {
+    for (auto &&item : range) {
+      emplace(std::forward<decltype(item)>(item));
     }
-    return result;
   }
+}
 
-
+namespace pmr {
 template<typename Type>
-void ContainerAdaptor<Type>::ReallocateStoreAfterPush(const ContainerAdaptor &old) {
-    std::unique_ptr<Type[]> store{new Type[Position+1]{}};
-    for (int i{0}; i <= Position; i++) {
-      store[i] = old.Store[i];
-    }
-    Store = std::move(store);
-  }
-
+using Stack = s21::Stack<Type, s21::pmr::Vector<Type>>;
 
 template<typename Type>
-void ContainerAdaptor<Type>::ReallocateStoreAfterPop(const ContainerAdaptor &old) {
-    std::unique_ptr<Type[]> store{new Type[Position+1]{}};
-    for (int i{Position}, j{Position + 1}; i >= 0; i--, j--) {
-      store[i] = old.Store[j];
-    }
-    Store = std::move(store);
-  }
+using Queue = s21::Queue<Type, s21::pmr::Deque<Type>>;
+}
 }
 
 
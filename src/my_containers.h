@@ -2,6 +2,7 @@
 #define MY_CONTAINERS_H
 
 #include "my_containerAdaptor.h"
+#include "my_deque.h"
 #include "my_list.h"
 #include "my_set.h"
 #include "my_vector.h"
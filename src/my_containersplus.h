@@ -3,5 +3,13 @@
 
 #include "my_multiset.h"
 #include "my_array.h"
+#include "my_priority_queue.h"
+#include "my_spsc_queue.h"
+#include "my_mpmc_queue.h"
+#include "my_work_stealing_deque.h"
+#include "my_thread_pool.h"
+#include "my_unordered_map.h"
+#include "my_split_map.h"
+#include "my_btree_map.h"
 
 #endif // MY_CONTAINERS_PLUS_H
@@ -0,0 +1,107 @@
+#ifndef MY_CONTIGUOUS_ITERATOR_H
+#define MY_CONTIGUOUS_ITERATOR_H
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace s21 {
+//  Iterator over a contiguous store shared by Vector and Map. It is a plain
+//  element pointer, so it is cheap to copy and satisfies
+//  std::contiguous_iterator, which lets the standard algorithms work on it
+//  directly.
+template<typename Type>
+class ContiguousIterator {
+ public:
+  typedef std::contiguous_iterator_tag iterator_concept;
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef std::remove_cv_t<Type> value_type;
+  typedef Type element_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Type *pointer;
+  typedef Type &reference;
+
+  ContiguousIterator() {}
+
+  explicit ContiguousIterator(pointer InitPointer) : Pointer(InitPointer) {}
+
+  template<typename Other>
+  requires std::is_convertible_v<Other *, Type *>
+  ContiguousIterator(const ContiguousIterator<Other> &other)
+      : Pointer(other.GetPointer()) {}
+
+  reference operator*() const {return *Pointer;}
+
+  pointer operator->() const {return Pointer;}
+
+  reference operator[](difference_type offset) const {return Pointer[offset];}
+
+  ContiguousIterator &operator++() {
+    ++Pointer;
+    return *this;
+  }
+
+  ContiguousIterator operator++(int) {
+    ContiguousIterator previous{*this};
+    ++Pointer;
+    return previous;
+  }
+
+  ContiguousIterator &operator--() {
+    --Pointer;
+    return *this;
+  }
+
+  ContiguousIterator operator--(int) {
+    ContiguousIterator previous{*this};
+    --Pointer;
+    return previous;
+  }
+
+  ContiguousIterator &operator+=(difference_type offset) {
+    Pointer += offset;
+    return *this;
+  }
+
+  ContiguousIterator &operator-=(difference_type offset) {
+    Pointer -= offset;
+    return *this;
+  }
+
+  ContiguousIterator operator+(difference_type offset) const {
+    return ContiguousIterator(Pointer + offset);
+  }
+
+  friend ContiguousIterator operator+(difference_type offset,
+                                      const ContiguousIterator &iter) {
+    return iter + offset;
+  }
+
+  ContiguousIterator operator-(difference_type offset) const {
+    return ContiguousIterator(Pointer - offset);
+  }
+
+  difference_type operator-(const ContiguousIterator &other) const {
+    return Pointer - other.Pointer;
+  }
+
+  bool operator==(const ContiguousIterator &other) const = default;
+
+  auto operator<=>(const ContiguousIterator &other) const = default;
+
+  void Advance(size_t repeat) {Pointer += repeat;}
+
+  void Decrease(size_t repeat) {Pointer -= repeat;}
+
+  pointer GetPointer() const {return Pointer;}
+
+ private:
+  pointer Pointer{nullptr};
+};
+
+static_assert(std::contiguous_iterator<ContiguousIterator<int>>);
+static_assert(std::contiguous_iterator<ContiguousIterator<const int>>);
+}
+
+#endif // MY_CONTIGUOUS_ITERATOR_H
@@ -0,0 +1,599 @@
+#ifndef MY_DEQUE_H
+#define MY_DEQUE_H
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+//  Iterator over the blocks of a Deque. Current is the element, First the
+//  start of its block and Node the slot of the map holding that block, so
+//  stepping within a block is a pointer increment and only the step over a
+//  block boundary reads the map. The slot after the last block is always
+//  present and holds nullptr, which is where end() points when the last
+//  block is full.
+template<typename Type, size_t BlockElements>
+class DequeIterator {
+ public:
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef std::remove_cv_t<Type> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Type *pointer;
+  typedef Type &reference;
+
+  DequeIterator() {}
+
+  DequeIterator(pointer InitCurrent, Type *const *InitNode)
+      : Current(InitCurrent), First(*InitNode), Node(InitNode) {}
+
+  template<typename Other>
+  requires std::is_convertible_v<Other *, Type *>
+  DequeIterator(const DequeIterator<Other, BlockElements> &other)
+      : Current(other.Current), First(other.First), Node(other.Node) {}
+
+  reference operator*() const {return *Current;}
+
+  pointer operator->() const {return Current;}
+
+  reference operator[](difference_type offset) const {return *(*this + offset);}
+
+  DequeIterator &operator++() {
+    if (++Current == First + BlockElements) [[unlikely]] {
+      First = *++Node;
+      Current = First;
+    }
+    return *this;
+  }
+
+  DequeIterator operator++(int) {
+    DequeIterator previous{*this};
+    ++*this;
+    return previous;
+  }
+
+  DequeIterator &operator--() {
+    if (Current == First) [[unlikely]] {
+      First = *--Node;
+      Current = First + BlockElements;
+    }
+    --Current;
+    return *this;
+  }
+
+  DequeIterator operator--(int) {
+    DequeIterator previous{*this};
+    --*this;
+    return previous;
+  }
+
+  DequeIterator &operator+=(difference_type offset);
+
+  DequeIterator &operator-=(difference_type offset) {return *this += -offset;}
+
+  DequeIterator operator+(difference_type offset) const {
+    DequeIterator moved{*this};
+    return moved += offset;
+  }
+
+  friend DequeIterator operator+(difference_type offset, const DequeIterator &iter) {
+    return iter + offset;
+  }
+
+  DequeIterator operator-(difference_type offset) const {
+    DequeIterator moved{*this};
+    return moved -= offset;
+  }
+
+  difference_type operator-(const DequeIterator &other) const {
+    return (Node - other.Node) * static_cast<difference_type>(BlockElements) + (Current - First) -
+           (other.Current - other.First);
+  }
+
+  bool operator==(const DequeIterator &other) const {return Current == other.Current;}
+
+  std::strong_ordering operator<=>(const DequeIterator &other) const {
+    return Node == other.Node ? Current <=> other.Current : Node <=> other.Node;
+  }
+
+ private:
+  template<typename, size_t>
+  friend class DequeIterator;
+
+  pointer Current{nullptr};
+  pointer First{nullptr};
+  Type *const *Node{nullptr};
+};
+
+template<typename Type, size_t BlockElements>
+DequeIterator<Type, BlockElements> &DequeIterator<Type, BlockElements>::operator+=(difference_type offset) {
+  constexpr difference_type block{static_cast<difference_type>(BlockElements)};
+  difference_type target{(Current - First) + offset};
+  if (target >= 0 && target < block) {
+    Current += offset;
+  } else {
+    difference_type nodes{target >= 0 ? target / block : -((-target - 1) / block) - 1};
+    Node += nodes;
+    First = *Node;
+    Current = First + (target - nodes * block);
+  }
+  return *this;
+}
+
+//  Double-ended queue kept in fixed-size blocks of about 4 KiB whose
+//  addresses are held in a map, as in std::deque. Element i lives at the
+//  absolute position Offset + i, its block is the position divided by the
+//  block size and the rest is the slot inside the block, the block size is
+//  a power of two so both are a shift and a mask. Pushing at either end
+//  fills the end block or adds a block next to it, elements never move, so
+//  references stay valid; only the map of block pointers is recentred or
+//  grown when it runs out of slots at one side.
+//
+//  Only blocks holding elements are kept, plus one spare block, so a queue
+//  that pushes at one end and pops at the other moves the same two blocks
+//  along the map instead of allocating. The first element and the slot
+//  after the last one are also kept as pointers together with the bounds
+//  of their blocks, so pushing and popping within a block does not read
+//  the map.
+template<typename Type, typename Allocator = std::allocator<Type>>
+class Deque {
+ public:
+  //  elements per block, a power of two close to 4 KiB of elements
+  static constexpr size_t BlockElements{std::bit_floor(sizeof(Type) * 16 > 4096 ? size_t{16} : 4096 / sizeof(Type))};
+
+  typedef size_t size_type;
+  typedef Type value_type;
+  typedef Type &reference;
+  typedef const Type &const_reference;
+  typedef DequeIterator<Type, BlockElements> iterator;
+  typedef DequeIterator<const Type, BlockElements> const_iterator;
+  typedef Allocator allocator_type;
+
+  Deque() {
+  }
+
+  explicit Deque(const Allocator &alloc) : Alloc(alloc) {
+  }
+
+  Deque(std::initializer_list<value_type> const &items, const Allocator &alloc = Allocator()) : Alloc(alloc) {
+    append_range(items);
+  }
+
+  Deque(const Deque &other) : Alloc(AllocatorTraits::select_on_container_copy_construction(other.Alloc)) {
+    try {
+      for (size_type i{0}; i < other.Count; i++) {
+        EmplaceBack(other.At(i));
+      }
+    } catch (...) {
+      Release();
+      throw;
+    }
+  }
+
+  Deque(Deque &&other) : Alloc(std::move(other.Alloc)) {
+    SwapBlocks(other);
+  }
+
+  ~Deque() {
+    Release();
+  }
+
+  void operator=(Deque &&other);
+
+  void push_back(const_reference value) {EmplaceBack(value);}
+
+  void push_back(value_type &&value) {EmplaceBack(std::move(value));}
+
+  void push_front(const_reference value) {EmplaceFront(value);}
+
+  void push_front(value_type &&value) {EmplaceFront(std::move(value));}
+
+  //  construct one element in place from args, unlike emplace_back and
+  //  emplace_front which push each of their arguments
+  template<typename... Args>
+  reference EmplaceBack(Args &&...args);
+
+  template<typename... Args>
+  reference EmplaceFront(Args &&...args);
+
+  void emplace_back() {}
+  template <class T, class... Args>
+  void emplace_back(T data, Args... args) {
+    push_back(std::move(data));
+    emplace_back(args...);
+  }
+
+  void emplace_front() {}
+  template <class T, class... Args>
+  void emplace_front(T data, Args... args) {
+    push_front(std::move(data));
+    emplace_front(args...);
+  }
+
+  template<typename Range>
+  void append_range(Range &&range) {
+    for (auto &&item : range) {
+      EmplaceBack(std::forward<decltype(item)>(item));
+    }
+  }
+
+  void pop_back();
+
+  void pop_front();
+
+  reference front();
+
+  reference back();
+
+  reference at(size_type pos);
+
+  reference operator[](size_type pos) {return At(pos);}
+
+  iterator begin() {return MakeIterator<iterator>(Offset);}
+
+  iterator end() {return MakeIterator<iterator>(Offset + Count);}
+
+  const_iterator begin() const {return MakeIterator<const_iterator>(Offset);}
+
+  const_iterator end() const {return MakeIterator<const_iterator>(Offset + Count);}
+
+  bool empty() const {return Count == 0;}
+
+  size_type size() const {return Count;}
+
+  void clear();
+
+  //  frees the spare block
+  void shrink_to_fit();
+
+  void swap(Deque &other);
+
+  allocator_type get_allocator() const {return Alloc;}
+
+ private:
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<Type *> MapAllocator;
+  typedef std::allocator_traits<MapAllocator> MapTraits;
+
+  static constexpr size_type Shift{static_cast<size_type>(std::countr_zero(BlockElements))};
+  static constexpr size_type Mask{BlockElements - 1};
+  static constexpr size_type MinMapSize{8};
+
+  //  Map slots FirstBlock to LastBlock hold the blocks in use, every other
+  //  slot is nullptr and LastBlock is always below MapSize. An empty deque
+  //  has no block, Offset at the start of FirstBlock and null cursors.
+  //  FrontCursor is the first element and FrontFloor the start of its
+  //  block, BackCursor is one past the last element and BackLimit the end
+  //  of its block, so BackCursor equals BackLimit when that block is full
+  Type **Map{nullptr};
+  size_type MapSize{0};
+  size_type FirstBlock{0};
+  size_type LastBlock{0};
+  size_type Offset{0};
+  size_type Count{0};
+  Type *FrontCursor{nullptr};
+  Type *FrontFloor{nullptr};
+  Type *BackCursor{nullptr};
+  Type *BackLimit{nullptr};
+  Type *Spare{nullptr};
+  [[no_unique_address]] Allocator Alloc;
+
+  Type *Slot(size_type position) const {return Map[position >> Shift] + (position & Mask);}
+
+  reference At(size_type pos) const {return *Slot(Offset + pos);}
+
+  template<typename Iterator>
+  Iterator MakeIterator(size_type position) const {
+    if (Count == 0) {
+      return Iterator();
+    }
+    Type *const *node{Map + (position >> Shift)};
+    return Iterator(*node + (position & Mask), node);
+  }
+
+  //  slow paths of EmplaceBack and EmplaceFront, the element goes into a new
+  //  block at that end
+  template<typename... Args>
+  reference EmplaceInBackBlock(Args &&...args);
+
+  template<typename... Args>
+  reference EmplaceInFrontBlock(Args &&...args);
+
+  Type *NewBlock();
+
+  void ReleaseBlock(Type *block);
+
+  //  makes room for one more block at both ends of the map
+  void ReserveMap();
+
+  //  called when the last element is gone, the map is recentred
+  void ResetEmpty();
+
+  void Release();
+
+  void SwapBlocks(Deque &other);
+};
+
+template<typename Type, typename Allocator>
+template<typename... Args>
+inline typename Deque<Type, Allocator>::reference Deque<Type, Allocator>::EmplaceBack(Args &&...args) {
+  if (BackCursor == BackLimit) [[unlikely]] {
+    return EmplaceInBackBlock(std::forward<Args>(args)...);
+  }
+  AllocatorTraits::construct(Alloc, BackCursor, std::forward<Args>(args)...);
+  Count += 1;
+  return *BackCursor++;
+}
+
+template<typename Type, typename Allocator>
+template<typename... Args>
+inline typename Deque<Type, Allocator>::reference Deque<Type, Allocator>::EmplaceFront(Args &&...args) {
+  if (FrontCursor == FrontFloor) [[unlikely]] {
+    return EmplaceInFrontBlock(std::forward<Args>(args)...);
+  }
+  AllocatorTraits::construct(Alloc, FrontCursor - 1, std::forward<Args>(args)...);
+  Offset -= 1;
+  Count += 1;
+  return *--FrontCursor;
+}
+
+//  the block is linked into the map only after the element is constructed
+template<typename Type, typename Allocator>
+template<typename... Args>
+typename Deque<Type, Allocator>::reference Deque<Type, Allocator>::EmplaceInBackBlock(Args &&...args) {
+  if (Map == nullptr || LastBlock + 1 >= MapSize) {
+    ReserveMap();
+  }
+  Type *block{NewBlock()};
+  try {
+    AllocatorTraits::construct(Alloc, block, std::forward<Args>(args)...);
+  } catch (...) {
+    ReleaseBlock(block);
+    throw;
+  }
+  Map[LastBlock] = block;
+  LastBlock += 1;
+  Count += 1;
+  if (Count == 1) {
+    FrontCursor = FrontFloor = block;
+  }
+  BackCursor = block + 1;
+  BackLimit = block + BlockElements;
+  return *block;
+}
+
+template<typename Type, typename Allocator>
+template<typename... Args>
+typename Deque<Type, Allocator>::reference Deque<Type, Allocator>::EmplaceInFrontBlock(Args &&...args) {
+  if (Map == nullptr || FirstBlock == 0) {
+    ReserveMap();
+  }
+  Type *block{NewBlock()};
+  try {
+    AllocatorTraits::construct(Alloc, block + Mask, std::forward<Args>(args)...);
+  } catch (...) {
+    ReleaseBlock(block);
+    throw;
+  }
+  FirstBlock -= 1;
+  Map[FirstBlock] = block;
+  Offset -= 1;
+  Count += 1;
+  if (Count == 1) {
+    BackCursor = BackLimit = block + BlockElements;
+  }
+  FrontFloor = block;
+  FrontCursor = block + Mask;
+  return *FrontCursor;
+}
+
+template<typename Type, typename Allocator>
+inline void Deque<Type, Allocator>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  AllocatorTraits::destroy(Alloc, --BackCursor);
+  Count -= 1;
+  if (Count == 0) [[unlikely]] {
+    ResetEmpty();
+  } else if (BackCursor == BackLimit - BlockElements) [[unlikely]] {
+    LastBlock -= 1;
+    ReleaseBlock(Map[LastBlock]);
+    Map[LastBlock] = nullptr;
+    BackCursor = BackLimit = Map[LastBlock - 1] + BlockElements;
+  }
+}
+
+template<typename Type, typename Allocator>
+inline void Deque<Type, Allocator>::pop_front() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  AllocatorTraits::destroy(Alloc, FrontCursor++);
+  Offset += 1;
+  Count -= 1;
+  if (Count == 0) [[unlikely]] {
+    ResetEmpty();
+  } else if (FrontCursor == FrontFloor + BlockElements) [[unlikely]] {
+    ReleaseBlock(Map[FirstBlock]);
+    Map[FirstBlock] = nullptr;
+    FirstBlock += 1;
+    FrontCursor = FrontFloor = Map[FirstBlock];
+  }
+}
+
+template<typename Type, typename Allocator>
+typename Deque<Type, Allocator>::reference Deque<Type, Allocator>::front() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  return *FrontCursor;
+}
+
+template<typename Type, typename Allocator>
+typename Deque<Type, Allocator>::reference Deque<Type, Allocator>::back() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  return BackCursor[-1];
+}
+
+template<typename Type, typename Allocator>
+typename Deque<Type, Allocator>::reference Deque<Type, Allocator>::at(size_type pos) {
+  if (pos >= Count) {
+    throw std::out_of_range("No such element");
+  }
+  return At(pos);
+}
+
+template<typename Type, typename Allocator>
+Type *Deque<Type, Allocator>::NewBlock() {
+  if (Spare != nullptr) {
+    return std::exchange(Spare, nullptr);
+  }
+  return AllocatorTraits::allocate(Alloc, BlockElements);
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::ReleaseBlock(Type *block) {
+  if (Spare == nullptr) {
+    Spare = block;
+  } else {
+    AllocatorTraits::deallocate(Alloc, block, BlockElements);
+  }
+}
+
+//  The blocks in use are centred in the map, which is doubled when they
+//  would take more than half of it, so both ends get a quarter of the map
+//  at least. Offset keeps its place inside the block.
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::ReserveMap() {
+  size_type used{LastBlock - FirstBlock};
+  size_type newSize{MapSize < MinMapSize ? MinMapSize : MapSize};
+  if (used + 2 > newSize / 2) {
+    newSize *= 2;
+  }
+  size_type newFirst{(newSize - used) / 2};
+  if (newSize == MapSize) {
+    std::memmove(Map + newFirst, Map + FirstBlock, used * sizeof(Type *));
+    std::fill(Map, Map + newFirst, nullptr);
+    std::fill(Map + newFirst + used, Map + MapSize, nullptr);
+  } else {
+    MapAllocator mapAlloc(Alloc);
+    Type **newMap{MapTraits::allocate(mapAlloc, newSize)};
+    std::fill(newMap, newMap + newSize, nullptr);
+    if (Map != nullptr) {
+      std::copy(Map + FirstBlock, Map + LastBlock, newMap + newFirst);
+      MapTraits::deallocate(mapAlloc, Map, MapSize);
+    }
+    Map = newMap;
+    MapSize = newSize;
+  }
+  Offset = (newFirst << Shift) + (Offset - (FirstBlock << Shift));
+  FirstBlock = newFirst;
+  LastBlock = newFirst + used;
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::ResetEmpty() {
+  for (size_type block{FirstBlock}; block < LastBlock; block++) {
+    ReleaseBlock(Map[block]);
+    Map[block] = nullptr;
+  }
+  FirstBlock = LastBlock = MapSize / 2;
+  Offset = FirstBlock << Shift;
+  FrontCursor = FrontFloor = BackCursor = BackLimit = nullptr;
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::clear() {
+  if constexpr (!std::is_trivially_destructible_v<Type>) {
+    for (size_type i{0}; i < Count; i++) {
+      AllocatorTraits::destroy(Alloc, Slot(Offset + i));
+    }
+  }
+  Count = 0;
+  ResetEmpty();
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::shrink_to_fit() {
+  if (Spare != nullptr) {
+    AllocatorTraits::deallocate(Alloc, Spare, BlockElements);
+    Spare = nullptr;
+  }
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::Release() {
+  clear();
+  shrink_to_fit();
+  if (Map != nullptr) {
+    MapAllocator mapAlloc(Alloc);
+    MapTraits::deallocate(mapAlloc, Map, MapSize);
+  }
+  Map = nullptr;
+  MapSize = FirstBlock = LastBlock = Offset = 0;
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::swap(Deque &other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
+  }
+  SwapBlocks(other);
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::operator=(Deque &&other) {
+  if (this == &other) {
+    return;
+  }
+  Release();
+  if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+    Alloc = std::move(other.Alloc);
+    SwapBlocks(other);
+  } else if (Alloc == other.Alloc) {
+    SwapBlocks(other);
+  } else {
+    for (size_type i{0}; i < other.Count; i++) {
+      EmplaceBack(std::move(other.At(i)));
+    }
+    other.clear();
+  }
+}
+
+template<typename Type, typename Allocator>
+void Deque<Type, Allocator>::SwapBlocks(Deque &other) {
+  std::swap(Map, other.Map);
+  std::swap(MapSize, other.MapSize);
+  std::swap(FirstBlock, other.FirstBlock);
+  std::swap(LastBlock, other.LastBlock);
+  std::swap(Offset, other.Offset);
+  std::swap(Count, other.Count);
+  std::swap(FrontCursor, other.FrontCursor);
+  std::swap(FrontFloor, other.FrontFloor);
+  std::swap(BackCursor, other.BackCursor);
+  std::swap(BackLimit, other.BackLimit);
+  std::swap(Spare, other.Spare);
+}
+
+static_assert(std::random_access_iterator<DequeIterator<int, 1024>>);
+static_assert(std::random_access_iterator<DequeIterator<const int, 1024>>);
+
+namespace pmr {
+template<typename Type>
+using Deque = s21::Deque<Type, std::pmr::polymorphic_allocator<Type>>;
+}
+}
+
+#endif // MY_DEQUE_H
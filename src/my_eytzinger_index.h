@@ -0,0 +1,194 @@
+#ifndef MY_EYTZINGER_INDEX_H
+#define MY_EYTZINGER_INDEX_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+//  Copy of the keys of a sorted array in Eytzinger order: the array is an
+//  implicit complete binary search tree with the root at 1 and the children
+//  of k at 2k and 2k + 1, so the first levels of every search share a few
+//  cache lines and the descendants of k four levels down (for 4 byte keys)
+//  lie next to each other and can be prefetched with one request.
+//
+//  The search has no data dependent branch: each step only decides whether
+//  to add one to 2k, and the lower bound is recovered from the final k by
+//  dropping the trailing right turns. Position maps a slot back to the index
+//  of its key in the sorted array.
+//
+//  The index keeps no allocator of its own: its owner passes its allocator
+//  to Build and Release, so the buffers always go back to the allocator
+//  they came from, also after the owner has swapped or moved allocators,
+//  and the owner has to Release the index before it is destroyed.
+template<typename Key, typename Allocator>
+class EytzingerIndex {
+ public:
+  typedef size_t size_type;
+
+  EytzingerIndex() = default;
+
+  EytzingerIndex(const EytzingerIndex &other) = delete;
+
+  void operator=(const EytzingerIndex &other) = delete;
+
+  bool Stale() const {return IsStale;}
+
+  //  called after every change of the sorted array
+  void Invalidate() {IsStale = true;}
+
+  //  rebuilds from count sorted elements, key(i) returns the key of the i-th
+  template<typename KeyOf>
+  void Build(size_type count, KeyOf key, const Allocator &alloc);
+
+  //  lower bound of key in the sorted array, and whether the key there is
+  //  equal to it, under the comparator the array is sorted by; key may be of
+  //  any type it orders against Key
+  template<typename K, typename Compare>
+  std::pair<size_type, bool> Find(const K &key, const Compare &comp) const;
+
+  void Release(const Allocator &alloc);
+
+  void Swap(EytzingerIndex &other);
+
+ private:
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Key> KeyAllocator;
+  typedef std::allocator_traits<KeyAllocator> KeyTraits;
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<size_type> PositionAllocator;
+  typedef std::allocator_traits<PositionAllocator> PositionTraits;
+
+  //  keys per cache line, the line that holds the descendants of k that
+  //  many levels down is prefetched on every step
+  static constexpr size_type PrefetchStride{sizeof(Key) <= 64 ? std::bit_floor(64 / sizeof(Key)) : 0};
+
+  //  both arrays are used from 1 to Count, slot 0 of Keys is never built
+  Key *Keys{nullptr};
+  size_type *Position{nullptr};
+  size_type Count{0};
+  size_type Capacity{0};
+  bool IsStale{true};
+
+  void DestroyKeys(const Allocator &alloc);
+
+  template<typename Visit>
+  static void InOrder(size_type count, size_type limit, Visit visit);
+};
+
+template<typename Key, typename Allocator>
+void EytzingerIndex<Key, Allocator>::DestroyKeys(const Allocator &alloc) {
+  KeyAllocator keyAlloc(alloc);
+  for (size_type slot{1}; slot <= Count; slot++) {
+    KeyTraits::destroy(keyAlloc, Keys + slot);
+  }
+  Count = 0;
+}
+
+template<typename Key, typename Allocator>
+void EytzingerIndex<Key, Allocator>::Release(const Allocator &alloc) {
+  DestroyKeys(alloc);
+  if (Capacity != 0) {
+    KeyAllocator keyAlloc(alloc);
+    PositionAllocator positionAlloc(alloc);
+    KeyTraits::deallocate(keyAlloc, Keys, Capacity + 1);
+    PositionTraits::deallocate(positionAlloc, Position, Capacity + 1);
+  }
+  Keys = nullptr;
+  Position = nullptr;
+  Capacity = 0;
+  IsStale = true;
+}
+
+template<typename Key, typename Allocator>
+void EytzingerIndex<Key, Allocator>::Swap(EytzingerIndex &other) {
+  std::swap(Keys, other.Keys);
+  std::swap(Position, other.Position);
+  std::swap(Count, other.Count);
+  std::swap(Capacity, other.Capacity);
+  std::swap(IsStale, other.IsStale);
+}
+
+//  visits the first limit slots of a tree of count slots in order, without
+//  recursion: down the left spine, then to the right child or up past the
+//  right turns
+template<typename Key, typename Allocator>
+template<typename Visit>
+void EytzingerIndex<Key, Allocator>::InOrder(size_type count, size_type limit, Visit visit) {
+  size_type slot{1};
+  while (slot * 2 <= count) {
+    slot *= 2;
+  }
+  for (size_type index{0}; index < limit; index++) {
+    visit(slot, index);
+    if (slot * 2 + 1 <= count) {
+      slot = slot * 2 + 1;
+      while (slot * 2 <= count) {
+        slot *= 2;
+      }
+    } else {
+      slot >>= std::countr_one(slot) + 1;
+    }
+  }
+}
+
+//  The sorted keys are handed out by an in-order walk of the implicit tree,
+//  in O(count). The arrays are only reallocated when the map has outgrown
+//  them.
+template<typename Key, typename Allocator>
+template<typename KeyOf>
+void EytzingerIndex<Key, Allocator>::Build(size_type count, KeyOf key, const Allocator &alloc) {
+  DestroyKeys(alloc);
+  if (count > Capacity) {
+    Release(alloc);
+    KeyAllocator keyAlloc(alloc);
+    PositionAllocator positionAlloc(alloc);
+    Keys = KeyTraits::allocate(keyAlloc, count + 1);
+    try {
+      Position = PositionTraits::allocate(positionAlloc, count + 1);
+    } catch (...) {
+      KeyTraits::deallocate(keyAlloc, Keys, count + 1);
+      Keys = nullptr;
+      throw;
+    }
+    Capacity = count;
+  }
+  KeyAllocator keyAlloc(alloc);
+  size_type built{0};
+  try {
+    InOrder(count, count, [&](size_type slot, size_type index) {
+      KeyTraits::construct(keyAlloc, Keys + slot, key(index));
+      Position[slot] = index;
+      built++;
+    });
+  } catch (...) {
+    InOrder(count, built, [&](size_type slot, size_type) {KeyTraits::destroy(keyAlloc, Keys + slot);});
+    throw;
+  }
+  Count = count;
+  IsStale = false;
+}
+
+template<typename Key, typename Allocator>
+template<typename K, typename Compare>
+inline std::pair<typename EytzingerIndex<Key, Allocator>::size_type, bool>
+EytzingerIndex<Key, Allocator>::Find(const K &key, const Compare &comp) const {
+  size_type slot{1};
+  while (slot <= Count) {
+#if defined(__GNUC__)
+    if constexpr (PrefetchStride != 0) {
+      __builtin_prefetch(reinterpret_cast<const void *>(reinterpret_cast<uintptr_t>(Keys + slot) +
+                                                        (PrefetchStride - 1) * slot * sizeof(Key)));
+    }
+#endif
+    slot = slot * 2 + static_cast<size_type>(comp(Keys[slot], key));
+  }
+  slot >>= std::countr_one(slot) + 1;
+  if (slot == 0) {
+    return std::make_pair(Count, false);
+  }
+  return std::make_pair(Position[slot], !comp(key, Keys[slot]));
+}
+}
+
+#endif // MY_EYTZINGER_INDEX_H
@@ -1,12 +1,19 @@
 #pragma once
 #include <cmath>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_node_pool.h"
 
 #ifndef MY_LIST_H
 #define MY_LIST_H
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class List {
  public:
   class ListIterator;
@@ -25,44 +32,183 @@ class List {
     Node* _prev = nullptr;
   };
 
+  // nodes come from a pool that takes its chunks from the user allocator
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node>
+      NodeAllocator;
+  typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
   Node* _first = nullptr;
   Node* _end = nullptr;
   Node* _head = nullptr;
 
   int _size = 0;
 
+  NodePool<Node, Allocator> _nodePool;
+
+  template <typename... Args>
+  Node* CreateNode(Args&&... args) {
+    Node* node = _nodePool.Allocate();
+    try {
+      NodeTraits::construct(_nodePool.get_allocator(), node,
+                            std::forward<Args>(args)...);
+    } catch (...) {
+      _nodePool.Deallocate(node);
+      throw;
+    }
+    return node;
+  }
+
+  void DestroyNode(Node* node) {
+    NodeTraits::destroy(_nodePool.get_allocator(), node);
+    _nodePool.Deallocate(node);
+  }
+
+  // destroys every node including the sentinels and gives the pool chunks
+  // back, nodes of trivial values are not visited at all unless the store
+  // is shared with a list that nodes were spliced to or from
+  void DestroyAllNodes() {
+    if (_nodePool.Shared()) {
+      Node* ptr = _first;
+      while (ptr != nullptr) {
+        Node* del = ptr;
+        ptr = ptr->_next;
+        DestroyNode(del);
+      }
+    } else if constexpr (!std::is_trivially_destructible_v<Node>) {
+      Node* ptr = _first;
+      while (ptr != nullptr) {
+        Node* del = ptr;
+        ptr = ptr->_next;
+        NodeTraits::destroy(_nodePool.get_allocator(), del);
+      }
+    }
+    _nodePool.Release();
+  }
+
   void InitList() {
-    _first = new Node;
-    _end = new Node;
+    _first = CreateNode();
+    _end = CreateNode();
+    _first->_next = _end;
+    _end->_prev = _first;
+  }
+
+  // stable merge of two null terminated chains, on equal values the node
+  // from left goes first. _prev is set on the way, the remainder of the
+  // longer chain keeps its own _prev links
+  template <typename Compare>
+  static Node* MergeChains(Node* left, Node* right, Compare& comp) {
+    Node* merged = nullptr;
+    Node** tail = &merged;
+    Node* last = nullptr;
+    while (left != nullptr && right != nullptr) {
+      if (comp(right->_value, left->_value)) {
+        *tail = right;
+        right = right->_next;
+      } else {
+        *tail = left;
+        left = left->_next;
+      }
+      (*tail)->_prev = last;
+      last = *tail;
+      tail = &last->_next;
+    }
+    *tail = left != nullptr ? left : right;
+    if (*tail != nullptr) (*tail)->_prev = last;
+    return merged;
+  }
+
+  // the tail of MergeChains(left, right) without walking the result
+  template <typename Compare>
+  static Node* MergedTail(Node* leftTail, Node* rightTail, Compare& comp) {
+    return comp(rightTail->_value, leftTail->_value) ? leftTail : rightTail;
+  }
+
+  // puts a sorted chain between the sentinels
+  void LinkChain(Node* chain, Node* tail) {
+    _head = chain;
+    chain->_prev = _first;
+    _first->_next = chain;
+    tail->_next = _end;
+    _end->_prev = tail;
+  }
+
+  void SyncHead() { _head = _first->_next == _end ? nullptr : _first->_next; }
+
+  // cuts first..last out of the list, they stay linked to each other
+  void CutRange(Node* first, Node* last) {
+    first->_prev->_next = last->_next;
+    last->_next->_prev = first->_prev;
+    SyncHead();
+  }
+
+  // links a range cut by CutRange before where
+  void LinkBefore(Node* where, Node* first, Node* last) {
+    first->_prev = where->_prev;
+    last->_next = where;
+    where->_prev->_next = first;
+    where->_prev = last;
+    SyncHead();
+  }
+
+  // joins the pool of other and returns the node before which spliced nodes
+  // go, an empty list hands out null iterators that stand for its end
+  Node* SplicePosition(const_iterator pos, List& other) {
+    _nodePool.Join(other._nodePool);
+    if (_first == nullptr) this->InitList();
+    iterator iter = pos;
+    Node* where = iter.GetPointer();
+    return where == nullptr ? _end : where;
+  }
+
+  // cuts the elements off the sentinels as a null terminated chain
+  Node* UnlinkChain() {
+    if (_head == nullptr) return nullptr;
+    Node* chain = _head;
+    _end->_prev->_next = nullptr;
     _first->_next = _end;
     _end->_prev = _first;
+    _head = nullptr;
+    return chain;
   }
 
  public:
+  typedef Allocator allocator_type;
+
   List() { this->InitList(); }
 
+  explicit List(const Allocator& alloc) : _nodePool(alloc) {
+    this->InitList();
+  }
+
   // без префикса explicit т.к. в тестах используется конвертация из такой
   // конструкции: {double, double ,etc} в initializer list
-  List(std::initializer_list<value_type> const& items) {
+  List(std::initializer_list<value_type> const& items,
+       const Allocator& alloc = Allocator())
+      : _nodePool(alloc) {
     this->InitList();
     for (value_type value : items) {
       this->push_back(value);
-      _size++;
     }
   }
 
-  List(List const& other) { *this = other; }
+  List(List const& other)
+      : _nodePool(NodeTraits::select_on_container_copy_construction(
+            other._nodePool.get_allocator())) {
+    *this = other;
+  }
+
+  List(List const& other, const Allocator& alloc) : _nodePool(alloc) {
+    *this = other;
+  }
 
   explicit List(size_type size) {
     InitList();
     for (int i = 0; i < size; i++) {
       push_back();
     }
-    _size = size;
   }
 
-  List(List&& other) {
-    this->clear();
+  List(List&& other) : _nodePool(std::move(other._nodePool)) {
     _head = other._head;
     _first = other._first;
     _end = other._end;
@@ -75,14 +221,8 @@ class List {
   }
 
   ~List() {
-    Node* r = _first;
-    if (r != nullptr) {
-      // delete _end;
-      while (r != nullptr) {
-        Node* temp = r;
-        r = r->_next;
-        delete temp;
-      }
+    if (_first != nullptr) {
+      DestroyAllNodes();
       _head = nullptr;
       _size = 0;
     }
@@ -92,19 +232,17 @@ class List {
     this->clear();
     this->InitList();
     Node* r = other._head;
-    while (r != other._end) {
+    while (r != nullptr && r != other._end) {
       push_back(r->_value);
       r = r->_next;
     }
-
-    _size = other._size;
   }
 
   void operator=(List&& other) {
     this->clear();
     this->InitList();
     Node* r = other._head;
-    while (r != other._end) {
+    while (r != nullptr && r != other._end) {
       push_back(r->_value);
       r = r->_next;
     }
@@ -118,8 +256,7 @@ class List {
     Node* ptr = pos.GetPointer();
     if (ptr == nullptr)
       throw std::out_of_range("insert : iterator point to null");
-    Node* elemNew = new Node;
-    elemNew->_value = value;
+    Node* elemNew = CreateNode(value);
     elemNew->_next = ptr;
     elemNew->_prev = ptr->_prev;
     ptr->_prev->_next = elemNew;
@@ -145,12 +282,12 @@ class List {
     }
     _size--;
     if (_size == 0) _head = nullptr;
-    delete del;
+    DestroyNode(del);
   }
 
   void pop_back() {
     if (!this->empty()) {
-      List<value_type>::iterator end = this->end();
+      iterator end = this->end();
       --end;
       this->erase(end);
     }
@@ -158,12 +295,13 @@ class List {
 
   void pop_front() {
     if (!this->empty()) {
-      List<value_type>::iterator begin = this->begin();
+      iterator begin = this->begin();
       this->erase(begin);
     }
   }
 
   void swap(List& other) {
+    _nodePool.Swap(other._nodePool);
     Node *swapH = _head, *swapE = _end, *swapF = _first;
     int swapS = _size;
     _head = other._head;
@@ -176,24 +314,73 @@ class List {
     other._size = swapS;
   }
 
-  void merge(List& other) {
-    List<value_type>::iterator iter = other.begin(), end = other.end();
-    for (; iter != end; ++iter) {
-      this->push_back(*iter);
-    }
+  // merges two sorted lists by relinking the nodes of other, which is left
+  // empty, the allocators must compare equal
+  template <typename Compare = std::less<value_type>>
+  void merge(List& other, Compare comp = Compare()) {
+    if (this == &other || other._head == nullptr) return;
+    _nodePool.Join(other._nodePool);
+    if (_first == nullptr) this->InitList();
+    Node* tail = other._end->_prev;
+    if (_head != nullptr) tail = MergedTail(_end->_prev, tail, comp);
+    LinkChain(MergeChains(UnlinkChain(), other.UnlinkChain(), comp), tail);
+    _size += other._size;
+    other._size = 0;
   }
 
+  // splice moves nodes by relinking them, nothing is allocated or copied.
+  // Iterators to the moved elements stay valid, the allocators must compare
+  // equal
+
+  // moves all elements of other before pos in O(1)
   void splice(const_iterator pos, List& other) {
-    List<value_type>::iterator end = other.end(), iter = other.begin(),
-                               temp = pos;
-    for (; iter != end; ++iter) {
-      insert(pos, *iter);
+    if (this == &other || other._head == nullptr) return;
+    Node* where = SplicePosition(pos, other);
+    Node *first = other._head, *last = other._end->_prev;
+    other.CutRange(first, last);
+    LinkBefore(where, first, last);
+    _size += other._size;
+    other._size = 0;
+  }
+
+  // moves the element at it before pos in O(1)
+  void splice(const_iterator pos, List& other, const_iterator it) {
+    iterator iter = it;
+    Node* node = iter.GetPointer();
+    if (node == nullptr)
+      throw std::out_of_range("splice : iterator point to null");
+    Node* where = SplicePosition(pos, other);
+    if (where == node || where == node->_next) return;
+    other.CutRange(node, node);
+    LinkBefore(where, node, node);
+    if (this != &other) {
+      other._size--;
+      _size++;
     }
   }
 
+  // moves [first, last) before pos, O(1) within one list and O(distance)
+  // between two lists to keep the sizes
+  void splice(const_iterator pos, List& other, const_iterator first,
+              const_iterator last) {
+    iterator from = first, to = last;
+    Node *begin = from.GetPointer(), *end = to.GetPointer();
+    if (begin == nullptr || begin == end) return;
+    Node* where = SplicePosition(pos, other);
+    Node* back = end->_prev;
+    if (this != &other) {
+      int count = 1;
+      for (Node* node = begin; node != back; node = node->_next) count++;
+      other._size -= count;
+      _size += count;
+    }
+    other.CutRange(begin, back);
+    LinkBefore(where, begin, back);
+  }
+
   void reverse() {
-    List<value_type> newList;
-    List<value_type>::iterator iter = this->end(), start = this->begin();
+    List newList(_nodePool.get_allocator());
+    iterator iter = this->end(), start = this->begin();
     --start;
     --iter;
     for (; iter != start; --iter) {
@@ -203,10 +390,10 @@ class List {
   }
 
   void unique() {
-    List<value_type>::iterator iter = this->begin(), end = this->end();
+    iterator iter = this->begin(), end = this->end();
     for (; iter != end; ++iter) {
       bool uniq = true;
-      for (List<value_type>::iterator iter2 = iter + 1; uniq && iter2 != end;
+      for (iterator iter2 = iter + 1; uniq && iter2 != end;
            ++iter2) {
         if (*iter2 == *iter) {
           --iter;
@@ -217,13 +404,46 @@ class List {
     }
   }
 
-  void sort();
+  // bottom-up merge sort that only relinks the nodes, no value is copied or
+  // moved. bins[i] holds a sorted run of 2^i nodes, higher bins hold the
+  // earlier nodes, so merging them in order keeps the sort stable
+  template <typename Compare = std::less<value_type>>
+  void sort(Compare comp = Compare()) {
+    if (_head == nullptr || _head->_next == _end) return;
+    Node* bins[64] = {};
+    Node* tails[64];
+    Node* chain = UnlinkChain();
+    while (chain != nullptr) {
+      Node* run = chain;
+      Node* runTail = run;
+      chain = chain->_next;
+      run->_next = nullptr;
+      size_t bin = 0;
+      for (; bins[bin] != nullptr; bin++) {
+        runTail = MergedTail(tails[bin], runTail, comp);
+        run = MergeChains(bins[bin], run, comp);
+        bins[bin] = nullptr;
+      }
+      bins[bin] = run;
+      tails[bin] = runTail;
+    }
+    Node* sorted = nullptr;
+    Node* sortedTail = nullptr;
+    for (size_t bin = 0; bin < 64; bin++) {
+      if (bins[bin] == nullptr) continue;
+      sortedTail = sorted == nullptr
+                       ? tails[bin]
+                       : MergedTail(tails[bin], sortedTail, comp);
+      sorted = MergeChains(bins[bin], sorted, comp);
+    }
+    LinkChain(sorted, sortedTail);
+  }
 
   void push_back() {
     if (_first == nullptr) {
       this->InitList();
     }
-    Node* elemNew = new Node;
+    Node* elemNew = CreateNode();
     if (_head == nullptr) {
       _head = elemNew;
       _head->_prev = _first;
@@ -237,14 +457,14 @@ class List {
       last->_next = elemNew;
       _end->_prev = elemNew;
     }
+    _size++;
   }
 
   void push_back(value_type value) {
     if (_first == nullptr) {
       this->InitList();
     }
-    Node* elemNew = new Node;
-    elemNew->_value = value;
+    Node* elemNew = CreateNode(value);
     if (_head == nullptr) {
       _head = elemNew;
       _head->_prev = _first;
@@ -258,14 +478,14 @@ class List {
       last->_next = elemNew;
       _end->_prev = elemNew;
     }
+    _size++;
   }
 
   void push_front(value_type value) {
     if (_first == nullptr) {
       this->InitList();
     }
-    Node* elemNew = new Node;
-    elemNew->_value = value;
+    Node* elemNew = CreateNode(value);
     if (_head == nullptr) {
       _head = elemNew;
       _head->_prev = _first;
@@ -279,6 +499,7 @@ class List {
       _head->_prev = elemNew;
       _head = elemNew;
     }
+    _size++;
   }
 
   bool empty() {
@@ -304,12 +525,7 @@ class List {
   }
 
   void clear() {
-    Node* ptr = _first;
-    while (ptr != nullptr) {
-      Node* del = ptr;
-      ptr = ptr->_next;
-      delete del;
-    }
+    DestroyAllNodes();
     _head = nullptr;
     _first = nullptr;
     _end = nullptr;
@@ -320,6 +536,10 @@ class List {
 
   size_type max_size() { return pow(2, 32) - 1; }
 
+  allocator_type get_allocator() {
+    return allocator_type(_nodePool.get_allocator());
+  }
+
   /// iterators
 
   class ListIterator {
@@ -481,6 +701,11 @@ class List {
   }
 };
 
+namespace pmr {
+template <typename T>
+using List = s21::List<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif // MY_LIST_H
\ No newline at end of file
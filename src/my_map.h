@@ -1,14 +1,51 @@
 #ifndef MY_MAP_H
 #define MY_MAP_H
 
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "my_contiguous_iterator.h"
+#include "my_eytzinger_index.h"
 #include "my_vector.h"
 
 namespace s21 {
-template<typename Key, typename T>
+//  Sorted array of pairs. Lookups are a binary search, an insert finds its
+//  position the same way and shifts the tail of the array by one slot, so
+//  the elements stay contiguous and a scan runs at the speed of an array.
+//  Like Vector the store grows geometrically and only its first MapSize
+//  slots hold live pairs.
+//
+//  A map that is read much more than it is written can keep a copy of its
+//  keys in Eytzinger order, see enable_lookup_index. Lookups then walk that
+//  copy, which is rebuilt on the first lookup after a change, while inserts
+//  keep searching the sorted array and never pay for a rebuild.
+//
+//  The keys are ordered by Compare, std::less<> unless given, which is held
+//  in a [[no_unique_address]] member and costs nothing when it is empty.
+template<typename Key, typename T, typename Compare = std::less<>,
+         typename Allocator = std::allocator<std::pair<Key, T>>>
 class Map {
+  //  when Compare is transparent, lookups take any K it orders against Key,
+  //  a std::string_view or a const char* for std::string keys, and compare
+  //  it to the keys as it is
+  template<typename K>
+  static constexpr bool Transparent{!std::is_same_v<K, Key> &&
+                                    requires(const Compare &comp, const Key &key, const K &other) {
+    typename Compare::is_transparent;
+    {comp(key, other)} -> std::convertible_to<bool>;
+    {comp(other, key)} -> std::convertible_to<bool>;
+  }};
+
  public:
   typedef Key key_type;
   typedef T mapped_type;
@@ -17,82 +54,71 @@ class Map {
   typedef size_t size_type;
 
  public:
-  class MapIterator {
-   public:
-
-    MapIterator() {}
-
-    MapIterator(const MapIterator &other) {
-      pointer = other.pointer;
-      position = other.position;
-    }
-
-    void SetIterator(std::shared_ptr<value_type[]> newPointer) {pointer = newPointer;}
-
-    value_type& operator*() {return pointer[position];}
-
-    void operator++() {position += 1;}
+  typedef ContiguousIterator<value_type> MapIterator;
 
-    void operator--(){position -= 1;}
-
-    size_type GetPosition() {return position;}
-
-    bool operator==(const MapIterator other) {return position == other.position;}
-
-    bool operator!=(const MapIterator other) {return position != other.position;}
-
-    bool operator>=(const MapIterator other) {return position >= other.position;}
+  typedef MapIterator iterator;
+  typedef std::pair<iterator, bool> isInserted;
+  typedef std::pair<size_type, bool> isFound;
+  typedef Allocator allocator_type;
+  typedef Compare key_compare;
 
-    bool operator<=(const MapIterator other) {return position <= other.position;}
+  Map() {}
 
-    void Advance(size_t repeat) {position += repeat;}
+  explicit Map(const Allocator &alloc) : Alloc(alloc) {}
 
-    void Decrease(size_t repeat) {position -= repeat;}
+  explicit Map(const Compare &comp, const Allocator &alloc = Allocator()) : Comp(comp), Alloc(alloc) {}
 
-    void swap(MapIterator &other) {
-      pointer.swap(other.pointer);
-      std::swap(position, other.position);
+  Map(std::initializer_list<value_type> const &items, const Allocator &alloc = Allocator())
+      : Alloc(alloc) {
+    reserve(items.size());
+    for (auto iter{items.begin()}; iter != items.end(); iter++) {
+      insert(*iter);
     }
+  }
 
-    void copy(const MapIterator other) {position = other.position;}
-
-   private:
-    std::shared_ptr<value_type[]> pointer;
-    size_type position{};
-  };
-
-  typedef MapIterator iterator;
-  typedef std::pair<iterator, bool> isInserted;
-  typedef std::pair<size_type, bool> isFound;
+  //  copies the pairs and sorts them by key once, the first of equal keys is
+  //  kept as when they are inserted one by one
+  template<std::input_iterator InputIterator>
+  Map(InputIterator first, InputIterator last, const Allocator &alloc = Allocator()) : Alloc(alloc) {
+    Build(first, last, false);
+  }
 
-  Map() {
-    EndIterator.SetIterator(Store);
-    BeginIterator.SetIterator(Store);
+  template<std::input_iterator InputIterator>
+  Map(InputIterator first, InputIterator last, const Compare &comp, const Allocator &alloc = Allocator())
+      : Comp(comp), Alloc(alloc) {
+    Build(first, last, false);
   }
 
-  Map(std::initializer_list<value_type> const &items) {
-    Store.reset(new value_type [MapMaxSize]{});
-    BeginIterator.SetIterator(Store);
-    EndIterator.SetIterator(Store);
-    for (auto iter{items.begin()}; iter != items.end(); iter++) {
-      insert(*iter);
-    }
+  //  the same for pairs already sorted by key, in O(n)
+  template<std::input_iterator InputIterator>
+  static Map from_sorted(InputIterator first, InputIterator last, const Allocator &alloc = Allocator()) {
+    return from_sorted(first, last, Compare(), alloc);
   }
 
-  Map(const Map &other) {
-    MapSize = other.MapSize;
+  template<std::input_iterator InputIterator>
+  static Map from_sorted(InputIterator first, InputIterator last, const Compare &comp,
+                         const Allocator &alloc = Allocator());
+
+  Map(const Map &other)
+      : Map(other, AllocatorTraits::select_on_container_copy_construction(other.Alloc)) {}
+
+  Map(const Map &other, const Allocator &alloc)
+      : IndexEnabled(other.IndexEnabled), Comp(other.Comp), Alloc(alloc) {
+    Store = AllocateStore(other.MapMaxSize);
     MapMaxSize = other.MapMaxSize;
-    Store.reset(new value_type [MapMaxSize]{});
-    for (int i{0}; i < MapSize; i++) {
-      Store[i] = other.Store[i];
+    try {
+      for (; MapSize < other.MapSize; MapSize++) {
+        AllocatorTraits::construct(Alloc, Store + MapSize, other.Store[MapSize]);
+      }
+    } catch (...) {
+      clear();
+      throw;
     }
-    BeginIterator.SetIterator(Store);
-    BeginIterator.copy(other.BeginIterator);
-    EndIterator.SetIterator(Store);
-    EndIterator.copy(other.EndIterator);
   }
 
-  Map(Map &&other) {swap(other);}
+  Map(Map &&other) : Comp(other.Comp), Alloc(std::move(other.Alloc)) {SwapStore(other);}
+
+  ~Map() {clear();}
 
   void operator=(Map &&other);
 
@@ -110,22 +136,67 @@ class Map {
 
   void merge(Map& other);
 
+  void reserve(size_type NewSize);
+
   bool empty() {return MapSize == 0;}
 
   size_type size() {return MapSize;}
 
   size_type max_size() {return MapMaxSize;}
 
-  iterator begin() {return BeginIterator;}
+  iterator begin() {return iterator(Store);}
+
+  iterator end() {return iterator(Store + MapSize);}
 
-  iterator end() {return EndIterator;}
+  allocator_type get_allocator() {return Alloc;}
+
+  key_compare key_comp() {return Comp;}
 
   bool contains(const key_type& key) {return FindPosition(key).second;}
 
-  isFound FindPosition(const key_type& key);
+  template<typename K>
+  requires Transparent<K>
+  bool contains(const K& key) {return FindPosition(key).second;}
+
+  size_type count(const key_type& key) {return contains(key) ? 1 : 0;}
+
+  template<typename K>
+  requires Transparent<K>
+  size_type count(const K& key) {return contains(key) ? 1 : 0;}
+
+  iterator find(const key_type& key) {return IteratorAt(FindPosition(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator find(const K& key) {return IteratorAt(FindPosition(key));}
+
+  //  the first element whose key is not less than key
+  iterator lower_bound(const key_type& key) {return iterator(Store + FindPosition(key).first);}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator lower_bound(const K& key) {return iterator(Store + FindPosition(key).first);}
+
+  //  the position of key, or where it would be inserted when it is absent
+  isFound FindPosition(const key_type& key) {return Lookup(key);}
+
+  template<typename K>
+  requires Transparent<K>
+  isFound FindPosition(const K& key) {return Lookup(key);}
+
+  //  keeps a read-optimized copy of the keys for contains, at and
+  //  FindPosition, false drops it
+  void enable_lookup_index(bool enabled = true);
 
-  mapped_type& at(const key_type& key);
+  bool lookup_index_enabled() {return IndexEnabled;}
 
+  mapped_type& at(const key_type& key) {return AtPosition(FindPosition(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  mapped_type& at(const K& key) {return AtPosition(FindPosition(key));}
+
+  //  inserts a value-initialized element when key is absent
   mapped_type& operator[](const key_type& key);
 
   void emplace_back() {}
@@ -141,232 +212,381 @@ class Map {
   }
 
  private:
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+
+  //  std::pair assigns through its own operators and so is never trivially
+  //  copyable, but a pair of trivially copyable members can still be moved
+  //  around with memmove
+  static constexpr bool Relocatable{std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>};
+
   size_type MapSize{};
   size_type MapMaxSize{};
-  std::shared_ptr<value_type[]> Store{new value_type[0]};
-  iterator EndIterator;
-  iterator BeginIterator;
+  bool IndexEnabled{false};
+  //  capacity is raw memory, only the first MapSize slots hold live pairs
+  value_type *Store{nullptr};
+  [[no_unique_address]] Compare Comp;
+  [[no_unique_address]] Allocator Alloc;
+  //  invalidated by every change of the store, built by the next lookup
+  EytzingerIndex<Key, Allocator> Index;
+
+  value_type *AllocateStore(size_type Count) {
+    return Count == 0 ? nullptr : AllocatorTraits::allocate(Alloc, Count);
+  }
 
-  void IncreaseStoreAllocation(const Map &old);
+  void ReplaceStore(value_type *NewStore, size_type NewMaxSize) {
+    if (Store != nullptr) {
+      AllocatorTraits::deallocate(Alloc, Store, MapMaxSize);
+    }
+    Store = NewStore;
+    MapMaxSize = NewMaxSize;
+  }
 
-  void DecreaseStoreAllocation(const Map &old);
+  void SwapStore(Map &other);
+
+  //  through the index when it is enabled
+  template<typename K>
+  isFound Lookup(const K& key);
+
+  //  binary search of the store itself, used by the inserting methods
+  template<typename K>
+  isFound SortedPosition(const K& key);
+
+  iterator IteratorAt(isFound found) {return found.second ? iterator(Store + found.first) : end();}
+
+  mapped_type& AtPosition(isFound found);
+
+  size_type NextCapacity(size_type MinimalSize) {
+    return MapMaxSize * 2 < MinimalSize ? MinimalSize : MapMaxSize * 2;
+  }
 
-  void CheckEmptyToIncreaseIterator();
+  void RelocateTo(value_type *NewStore, size_type Gap);
 
-  void IncreaseSizeForInsert();
+  template<typename... Args>
+  void InsertAt(size_type Position, Args &&...args);
 
-  bool InsertToEmptyCase(const value_type& value);
+  template<typename InputIterator>
+  void Build(InputIterator first, InputIterator last, bool sorted);
 
-  void StoreReset(std::shared_ptr<value_type[]> newStore);
+  //  slow path of InsertAt, kept apart so the common case stays small
+  template<typename... Args>
+  void InsertWithGrowth(size_type Position, Args &&...args);
 };
 
-template<typename Key, typename T>
-void Map<Key, T>::StoreReset(std::shared_ptr<value_type[]> newStore) {
-  Store = std::move(newStore);
-  EndIterator.SetIterator(Store);
-  BeginIterator.SetIterator(Store);
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::SwapStore(Map &other) {
+  std::swap(Store, other.Store);
+  std::swap(MapSize, other.MapSize);
+  std::swap(MapMaxSize, other.MapMaxSize);
+  std::swap(IndexEnabled, other.IndexEnabled);
+  std::swap(Comp, other.Comp);
+  Index.Swap(other.Index);
 }
 
-template<typename Key, typename T>
-bool Map<Key, T>::InsertToEmptyCase(const value_type& value) {
-  bool inserted{false};
-  if (empty()) {
-    MapSize += 1;
-    if (MapSize >= MapMaxSize) {
-      MapMaxSize += 1;
+//  Moves the pairs into NewStore leaving the slot at Gap uninitialized, as
+//  Vector::RelocateTo does. On exception the map is left untouched.
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::RelocateTo(value_type *NewStore, size_type Gap) {
+  if constexpr (Relocatable) {
+    if (MapSize != 0) {
+      std::memcpy(static_cast<void *>(NewStore), Store, Gap * sizeof(value_type));
+      std::memcpy(static_cast<void *>(NewStore + Gap + 1), Store + Gap, (MapSize - Gap) * sizeof(value_type));
+    }
+  } else {
+    size_type i{0};
+    try {
+      for (; i < MapSize; i++) {
+        AllocatorTraits::construct(Alloc, NewStore + (i < Gap ? i : i + 1), std::move_if_noexcept(Store[i]));
+      }
+    } catch (...) {
+      for (size_type j{0}; j < i; j++) {
+        AllocatorTraits::destroy(Alloc, NewStore + (j < Gap ? j : j + 1));
+      }
+      throw;
+    }
+    for (size_type j{0}; j < MapSize; j++) {
+      AllocatorTraits::destroy(Alloc, Store + j);
     }
-    IncreaseStoreAllocation(*this);
-    Store[0] = value;
-    inserted = true;
   }
-  return inserted;
 }
 
-template<typename Key, typename T>
-void Map<Key, T>::IncreaseSizeForInsert() {
-      MapSize += 1;
-      if (MapSize >= MapMaxSize) {
-        MapMaxSize += 1;
-      }
+//  the pairs after Position move up by one slot, with a single memmove when
+//  they are relocatable
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename... Args>
+inline void Map<Key, T, Compare, Allocator>::InsertAt(size_type Position, Args &&...args) {
+  Index.Invalidate();
+  if (MapSize == MapMaxSize) {
+    InsertWithGrowth(Position, std::forward<Args>(args)...);
+  } else if (Position == MapSize) {
+    AllocatorTraits::construct(Alloc, Store + MapSize, std::forward<Args>(args)...);
+    MapSize += 1;
+  } else if constexpr (Relocatable) {
+    value_type Inserted(std::forward<Args>(args)...);
+    std::memmove(static_cast<void *>(Store + Position + 1), Store + Position,
+                 (MapSize - Position) * sizeof(value_type));
+    AllocatorTraits::construct(Alloc, Store + Position, Inserted);
+    MapSize += 1;
+  } else {
+    value_type Inserted(std::forward<Args>(args)...);
+    AllocatorTraits::construct(Alloc, Store + MapSize, std::move(Store[MapSize - 1]));
+    MapSize += 1;
+    std::move_backward(Store + Position, Store + MapSize - 2, Store + MapSize - 1);
+    Store[Position] = std::move(Inserted);
+  }
 }
 
-template<typename Key, typename T>
-void Map<Key, T>::DecreaseStoreAllocation(const Map &old) {
-      std::shared_ptr<value_type []> store{new value_type [MapMaxSize]{}};
-      for (size_t i{0}; i < MapSize; i++) {
-        store[i] = old.Store[i];
-      }
-      Store = std::move(store);
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename... Args>
+void Map<Key, T, Compare, Allocator>::InsertWithGrowth(size_type Position, Args &&...args) {
+  size_type NewMaxSize = NextCapacity(MapSize + 1);
+  value_type *NewStore = AllocateStore(NewMaxSize);
+  try {
+    AllocatorTraits::construct(Alloc, NewStore + Position, std::forward<Args>(args)...);
+    try {
+      RelocateTo(NewStore, Position);
+    } catch (...) {
+      AllocatorTraits::destroy(Alloc, NewStore + Position);
+      throw;
+    }
+  } catch (...) {
+    AllocatorTraits::deallocate(Alloc, NewStore, NewMaxSize);
+    throw;
+  }
+  ReplaceStore(NewStore, NewMaxSize);
+  MapSize += 1;
 }
 
-    template<typename Key, typename T>
-void Map<Key, T>::IncreaseStoreAllocation(const Map &old) {
-      std::shared_ptr<value_type []> store{new value_type [MapMaxSize]{}};
-      for (size_t i{0}; i < MapSize; i++) {
-        store[i] = old.Store[i];
-      }
-      Store = std::move(store);
-      BeginIterator.SetIterator(Store);
-      EndIterator.SetIterator(Store);
+//  appends the pairs unordered, then one stable sort and one pass that drops
+//  the later of equal keys, so the store is filled in O(n log n)
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename InputIterator>
+void Map<Key, T, Compare, Allocator>::Build(InputIterator first, InputIterator last, bool sorted) {
+  try {
+    if constexpr (std::forward_iterator<InputIterator>) {
+      reserve(static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      InsertAt(MapSize, *first);
+    }
+    if (!sorted) {
+      std::stable_sort(Store, Store + MapSize, [this](const value_type &left, const value_type &right) {
+        return Comp(left.first, right.first);
+      });
+    }
+    value_type *unique = std::unique(Store, Store + MapSize, [this](const value_type &left, const value_type &right) {
+      return !Comp(left.first, right.first);
+    });
+    for (value_type *dropped{unique}; dropped != Store + MapSize; dropped++) {
+      AllocatorTraits::destroy(Alloc, dropped);
+    }
+    MapSize = static_cast<size_type>(unique - Store);
+  } catch (...) {
+    clear();
+    throw;
+  }
 }
 
-    template<typename Key, typename T>
-void Map<Key, T>::merge(Map& other) {
-      MapIterator left(other.begin()), right(other.end());
-      while (left <= right) {
-        insert(*left);
-        ++left;
-      }
-      other.clear();
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<std::input_iterator InputIterator>
+Map<Key, T, Compare, Allocator> Map<Key, T, Compare, Allocator>::from_sorted(InputIterator first, InputIterator last,
+                                                                             const Compare &comp,
+                                                                             const Allocator &alloc) {
+  Map result(comp, alloc);
+  result.Build(first, last, true);
+  return result;
 }
 
-    template<typename Key, typename T>
-void Map<Key, T>::swap(Map& other) {
-      Store.swap(other.Store);
-      std::swap(MapSize, other.MapSize);
-      std::swap(MapMaxSize, other.MapMaxSize);
-      BeginIterator.swap(other.BeginIterator);
-      EndIterator.swap(other.EndIterator);
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::reserve(size_type NewSize) {
+  if (NewSize > MapMaxSize) {
+    value_type *NewStore = AllocateStore(NewSize);
+    try {
+      RelocateTo(NewStore, MapSize);
+    } catch (...) {
+      AllocatorTraits::deallocate(Alloc, NewStore, NewSize);
+      throw;
     }
+    ReplaceStore(NewStore, NewSize);
+  }
+}
 
-    template<typename Key, typename T>
-void Map<Key, T>::erase(iterator position) {
-      *position = std::make_pair(0, 0);
-      --EndIterator;
-      for (size_t i{0}, j{0}; i < MapSize; i++, j++) {
-        if (i == position.GetPosition()) {
-          j++;
+//  Both maps are sorted, so they are merged in one pass into a store that
+//  fits both instead of inserting the pairs of other one by one. A key
+//  present in both keeps the value of this map.
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::merge(Map& other) {
+  if (other.MapSize != 0) {
+    size_type NewMaxSize = MapSize + other.MapSize;
+    value_type *NewStore = AllocateStore(NewMaxSize);
+    size_type built{0}, mine{0}, theirs{0};
+    try {
+      while (mine < MapSize || theirs < other.MapSize) {
+        if (theirs == other.MapSize || (mine < MapSize && Comp(Store[mine].first, other.Store[theirs].first))) {
+          AllocatorTraits::construct(Alloc, NewStore + built, std::move_if_noexcept(Store[mine++]));
+        } else if (mine == MapSize || Comp(other.Store[theirs].first, Store[mine].first)) {
+          AllocatorTraits::construct(Alloc, NewStore + built, other.Store[theirs++]);
+        } else {
+          AllocatorTraits::construct(Alloc, NewStore + built, std::move_if_noexcept(Store[mine++]));
+          theirs++;
         }
-        Store[i] = Store[j];
+        built++;
       }
-      MapSize -= 1;
-    }
-
-    template<typename Key, typename T>
-void Map<Key, T>::clear() {
-      while (MapSize != 0) {
-        *EndIterator = std::make_pair(0, 0);;
-        --EndIterator;
-        MapSize--;
+    } catch (...) {
+      for (size_type i{0}; i < built; i++) {
+        AllocatorTraits::destroy(Alloc, NewStore + i);
       }
-      Store.reset(new value_type[0]{});
-      MapMaxSize = 0;
-      EndIterator.SetIterator(Store);
-      BeginIterator.SetIterator(Store);
+      AllocatorTraits::deallocate(Alloc, NewStore, NewMaxSize);
+      throw;
     }
-
-    template<typename Key, typename T>
-void Map<Key, T>::operator=(Map &&other ) {
-      MapSize = other.MapSize;
-      MapMaxSize = other.MapMaxSize;
-      Store.reset(new value_type [MapMaxSize]{});
-      for (int i{0}; i < MapSize; i++) {
-        Store[i] = other.Store[i];
-      }
-      BeginIterator.SetIterator(Store);
-      BeginIterator.copy(other.BeginIterator);
-      EndIterator.SetIterator(Store);
-      EndIterator.copy(other.EndIterator);
+    for (size_type i{0}; i < MapSize; i++) {
+      AllocatorTraits::destroy(Alloc, Store + i);
     }
+    ReplaceStore(NewStore, NewMaxSize);
+    MapSize = built;
+    Index.Invalidate();
+  }
+  other.clear();
+}
 
-template<typename Key, typename T>
-void Map<Key, T>::CheckEmptyToIncreaseIterator() {
-  if (!empty()) {
-    ++EndIterator;
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::swap(Map& other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
   }
+  SwapStore(other);
 }
 
-template<typename Key, typename T>
-typename Map<Key, T>::isInserted Map<Key, T>:: insert(const value_type& value) {
-  iterator positionIterator;
-  bool inserted = InsertToEmptyCase(value);
-  positionIterator.SetIterator(Store);
-  if (!inserted) {
-    inserted = contains(value.first);
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::erase(iterator position) {
+  size_type Position = position - begin();
+  Index.Invalidate();
+  if constexpr (Relocatable) {
+    AllocatorTraits::destroy(Alloc, Store + Position);
+    std::memmove(static_cast<void *>(Store + Position), Store + Position + 1,
+                 (MapSize - Position - 1) * sizeof(value_type));
+    MapSize -= 1;
+  } else {
+    std::move(Store + Position + 1, Store + MapSize, Store + Position);
+    MapSize -= 1;
+    AllocatorTraits::destroy(Alloc, Store + MapSize);
   }
-  if (!inserted) {
-    size_type insertedPosition{};
-    IncreaseSizeForInsert();
-    std::shared_ptr < value_type[] > newStore{new value_type[MapMaxSize]};
-    for (size_type i{0}, j{0}; i < MapSize - 1; i++, j++) {
-      if (!inserted && value.first < Store[i].first) {
-        newStore[j] = value;
-        inserted = true;
-        ++EndIterator;
-        insertedPosition = j;
-        j++;
-      }
-      newStore[j] = Store[i];
-    }
-    if (!inserted) {
-      newStore[MapSize - 1] = value;
-      insertedPosition += 1;
-      ++EndIterator;
-      inserted = true;
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::clear() {
+  for (size_type i{0}; i < MapSize; i++) {
+    AllocatorTraits::destroy(Alloc, Store + i);
+  }
+  MapSize = 0;
+  ReplaceStore(nullptr, 0);
+  Index.Release(Alloc);
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::operator=(Map &&other) {
+  if (this != &other) {
+    clear();
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+      Alloc = std::move(other.Alloc);
+      SwapStore(other);
+    } else if (Alloc == other.Alloc) {
+      SwapStore(other);
+    } else {
+      Comp = other.Comp;
+      IndexEnabled = other.IndexEnabled;
+      merge(other);
     }
-    StoreReset(newStore);
-    positionIterator.SetIterator(Store);
-    positionIterator.Advance(insertedPosition);
   }
-  isInserted result = std::make_pair(positionIterator, inserted);
-  return result;
 }
 
-template<typename Key, typename T>
-typename Map<Key, T>::isInserted Map<Key, T>::insert(const Key& key, const T& obj) {
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename Map<Key, T, Compare, Allocator>::isInserted Map<Key, T, Compare, Allocator>::insert(const value_type& value) {
+  isFound found = SortedPosition(value.first);
+  if (!found.second) {
+    InsertAt(found.first, value);
+  }
+  return std::make_pair(iterator(Store + found.first), !found.second);
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename Map<Key, T, Compare, Allocator>::isInserted Map<Key, T, Compare, Allocator>::insert(const Key& key, const T& obj) {
   isInserted result = insert(std::make_pair(key, obj));
   return result;
 }
 
-template<typename Key, typename T>
-typename Map<Key, T>::isInserted Map<Key, T>::insert_or_assign(const value_type& value) {
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename Map<Key, T, Compare, Allocator>::isInserted Map<Key, T, Compare, Allocator>::insert_or_assign(const value_type& value) {
   isInserted result;
-  isFound found = FindPosition(value.first);
+  isFound found = SortedPosition(value.first);
   if (found.second) {
     Store[found.first].second = value.second;
-    iterator positionIterator;
-    positionIterator.SetIterator(Store);
-    positionIterator.Advance(found.first);
+    iterator positionIterator(Store + found.first);
     result = std::make_pair(positionIterator, true);
   } else {
-    result = insert(value);
+    InsertAt(found.first, value);
+    result = std::make_pair(iterator(Store + found.first), true);
   }
   return result;
 }
 
-template<typename Key, typename T>
-typename Map<Key, T>::isFound Map<Key, T>::FindPosition(const key_type& key) {
-  bool found{false};
-  int left{}, right = EndIterator.GetPosition(), middle{0};
-  while (left <= right && !found) {
-    middle = left + (right - left) / 2;
-    if (Store[middle].first == key) {
-      found = true;
-    } else if (Store[middle].first < key) {
-      left = middle + 1;
+template<typename Key, typename T, typename Compare, typename Allocator>
+void Map<Key, T, Compare, Allocator>::enable_lookup_index(bool enabled) {
+  IndexEnabled = enabled;
+  if (!enabled) {
+    Index.Release(Alloc);
+  }
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename K>
+inline typename Map<Key, T, Compare, Allocator>::isFound Map<Key, T, Compare, Allocator>::Lookup(const K& key) {
+  if (!IndexEnabled) {
+    return SortedPosition(key);
+  }
+  if (Index.Stale()) {
+    Index.Build(MapSize, [this](size_type i) -> const Key& {return Store[i].first;}, Alloc);
+  }
+  return Index.Find(key, Comp);
+}
+
+//  lower bound on the keys, only Compare is used
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename K>
+inline typename Map<Key, T, Compare, Allocator>::isFound Map<Key, T, Compare, Allocator>::SortedPosition(const K& key) {
+  size_type left{0}, count{MapSize};
+  while (count != 0) {
+    size_type half = count / 2;
+    if (Comp(Store[left + half].first, key)) {
+      left += half + 1;
+      count -= half + 1;
     } else {
-      right = middle - 1;
+      count = half;
     }
   }
-  return std::make_pair(middle, found);
+  return std::make_pair(left, left < MapSize && !Comp(key, Store[left].first));
 }
 
-template<typename Key, typename T>
-typename Map<Key, T>::mapped_type& Map<Key, T>::at(const key_type& key) {
-  isFound result = FindPosition(key);
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename Map<Key, T, Compare, Allocator>::mapped_type& Map<Key, T, Compare, Allocator>::AtPosition(isFound result) {
   if (!result.second) {
     throw std::out_of_range("Не туда воююешь");
   }
   return Store[result.first].second;
 }
 
-template<typename Key, typename T>
-typename Map<Key, T>::mapped_type& Map<Key, T>::operator[](const key_type& key) {
-  isFound result = FindPosition(key);
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename Map<Key, T, Compare, Allocator>::mapped_type& Map<Key, T, Compare, Allocator>::operator[](const key_type& key) {
+  isFound result = SortedPosition(key);
+  if (!result.second) {
+    InsertAt(result.first, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+  }
   return Store[result.first].second;
 }
 
-
+namespace pmr {
+template<typename Key, typename T, typename Compare = std::less<>>
+using Map = s21::Map<Key, T, Compare, std::pmr::polymorphic_allocator<std::pair<Key, T>>>;
+}
 }
 
 #endif // MY_MAP_H
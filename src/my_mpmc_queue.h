@@ -0,0 +1,285 @@
+#ifndef MY_MPMC_QUEUE_H
+#define MY_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+//  Bounded queue for any number of producer and consumer threads. Every
+//  slot of the ring carries a sequence number that says whose turn it is:
+//  a slot at position pos is free for the producer of pos while its sequence
+//  equals pos, holds an element for the consumer of pos once it equals
+//  pos + 1 and becomes free for the producer of pos + Capacity when the
+//  consumer stores that. Producers claim positions by advancing Tail and
+//  consumers by advancing Head with a compare-and-swap, the element itself
+//  is handed over through the sequence of its slot with release and acquire,
+//  so threads working on different slots never wait for each other.
+//
+//  The batch calls claim a run of ready slots with a single compare-and-swap
+//  on the shared index, which is where the contention between threads is.
+//  The blocking calls spin a little and then yield the processor until a
+//  slot is ready.
+//
+//  A claimed slot can not be given back, so moving an element in and out of
+//  a slot must not throw. An element whose construction from the arguments
+//  may throw is built before the slot is claimed.
+template<typename Type, size_t Capacity, typename Allocator = std::allocator<Type>>
+class MpmcQueue {
+  static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+  static_assert(std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>,
+                "Type must be moved without exceptions");
+ public:
+  typedef size_t size_type;
+  typedef Type value_type;
+  typedef Type &reference;
+  typedef const Type &const_reference;
+  typedef Allocator allocator_type;
+
+  MpmcQueue() : MpmcQueue(Allocator()) {
+  }
+
+  explicit MpmcQueue(const Allocator &alloc);
+
+  MpmcQueue(const MpmcQueue &other) = delete;
+
+  void operator=(const MpmcQueue &other) = delete;
+
+  //  no thread may use the queue any more
+  ~MpmcQueue();
+
+  //  false when the ring is full, the arguments are left untouched then
+  //  unless the element had to be built in advance
+
+  bool try_push(const Type &value) {return try_emplace(value);}
+
+  bool try_push(Type &&value) {return try_emplace(std::move(value));}
+
+  template<typename... Args>
+  bool try_emplace(Args &&...args);
+
+  //  wait while the ring is full
+
+  void push(const Type &value) {Wait([&]() {return try_push(value);});}
+
+  void push(Type &&value) {Wait([&]() {return try_push(std::move(value));});}
+
+  //  false when the ring is empty
+  bool try_pop(Type &value);
+
+  //  waits while the ring is empty
+  void pop(Type &value) {Wait([&]() {return try_pop(value);});}
+
+  //  pushes up to count elements read from first and returns how many fit,
+  //  constructing an element from the iterator must not throw
+  template<typename InputIterator>
+  size_type try_push_n(InputIterator first, size_type count);
+
+  //  moves up to count elements to out and returns how many were taken
+  template<typename OutputIterator>
+  size_type try_pop_n(OutputIterator out, size_type count);
+
+  //  only a snapshot while other threads run
+  size_type size() const;
+
+  bool empty() const {return size() == 0;}
+
+  static constexpr size_type capacity() {return Capacity;}
+
+  allocator_type get_allocator() const {return Alloc;}
+
+ private:
+  struct Slot {
+    std::atomic<size_type> Sequence;
+    alignas(Type) unsigned char Storage[sizeof(Type)];
+
+    Type *Data() {return reinterpret_cast<Type *>(Storage);}
+  };
+
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<Slot> SlotAllocator;
+  typedef std::allocator_traits<SlotAllocator> SlotTraits;
+
+  //  x86-64 and most ARM cores, as in SpscQueue
+  static constexpr size_type CacheLine{64};
+  static constexpr size_type Mask{Capacity - 1};
+  //  failed attempts before a waiting call starts to yield
+  static constexpr int SpinLimit{64};
+
+  //  claimed by consumers
+  alignas(CacheLine) std::atomic<size_type> Head{0};
+
+  //  claimed by producers
+  alignas(CacheLine) std::atomic<size_type> Tail{0};
+
+  //  read only after construction
+  alignas(CacheLine) Slot *Slots{nullptr};
+  [[no_unique_address]] Allocator Alloc;
+
+  //  distance of the sequence of a slot from the expected one, negative when
+  //  the slot is still a lap behind
+  static std::ptrdiff_t Lag(size_type Sequence, size_type Expected) {
+    return static_cast<std::ptrdiff_t>(Sequence - Expected);
+  }
+
+  //  claims count positions starting at one whose slot is ready, Ready gives
+  //  the sequence a slot has when it is ready for the position
+  template<typename Ready>
+  size_type Claim(std::atomic<size_type> &Index, size_type count, size_type &pos, Ready ready);
+
+  template<typename Attempt>
+  static void Wait(Attempt attempt);
+};
+
+template<typename Type, size_t Capacity, typename Allocator>
+MpmcQueue<Type, Capacity, Allocator>::MpmcQueue(const Allocator &alloc) : Alloc(alloc) {
+  SlotAllocator slotAlloc(Alloc);
+  Slots = SlotTraits::allocate(slotAlloc, Capacity);
+  for (size_type i{0}; i < Capacity; i++) {
+    SlotTraits::construct(slotAlloc, Slots + i);
+    Slots[i].Sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+MpmcQueue<Type, Capacity, Allocator>::~MpmcQueue() {
+  size_type tail{Tail.load(std::memory_order_relaxed)};
+  for (size_type head{Head.load(std::memory_order_relaxed)}; head != tail; head++) {
+    AllocatorTraits::destroy(Alloc, Slots[head & Mask].Data());
+  }
+  SlotAllocator slotAlloc(Alloc);
+  for (size_type i{0}; i < Capacity; i++) {
+    SlotTraits::destroy(slotAlloc, Slots + i);
+  }
+  SlotTraits::deallocate(slotAlloc, Slots, Capacity);
+}
+
+//  returns 0 without claiming when the first slot is not ready, a stale pos
+//  is reloaded from Index and the scan starts again
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename Ready>
+typename MpmcQueue<Type, Capacity, Allocator>::size_type
+MpmcQueue<Type, Capacity, Allocator>::Claim(std::atomic<size_type> &Index, size_type count, size_type &pos,
+                                            Ready ready) {
+  pos = Index.load(std::memory_order_relaxed);
+  while (true) {
+    std::ptrdiff_t lag{Lag(Slots[pos & Mask].Sequence.load(std::memory_order_acquire), ready(pos))};
+    if (lag < 0) {
+      return 0;
+    }
+    if (lag > 0) {
+      pos = Index.load(std::memory_order_relaxed);
+      continue;
+    }
+    size_type claimed{1};
+    while (claimed < count &&
+           Slots[(pos + claimed) & Mask].Sequence.load(std::memory_order_acquire) == ready(pos + claimed)) {
+      claimed++;
+    }
+    if (Index.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) {
+      return claimed;
+    }
+  }
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename... Args>
+bool MpmcQueue<Type, Capacity, Allocator>::try_emplace(Args &&...args) {
+  if constexpr (!std::is_nothrow_constructible_v<Type, Args &&...>) {
+    Type item(std::forward<Args>(args)...);
+    return try_emplace(std::move(item));
+  } else {
+    size_type pos;
+    if (Claim(Tail, 1, pos, [](size_type at) {return at;}) == 0) {
+      return false;
+    }
+    Slot &slot{Slots[pos & Mask]};
+    AllocatorTraits::construct(Alloc, slot.Data(), std::forward<Args>(args)...);
+    slot.Sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+bool MpmcQueue<Type, Capacity, Allocator>::try_pop(Type &value) {
+  size_type pos;
+  if (Claim(Head, 1, pos, [](size_type at) {return at + 1;}) == 0) {
+    return false;
+  }
+  Slot &slot{Slots[pos & Mask]};
+  value = std::move(*slot.Data());
+  AllocatorTraits::destroy(Alloc, slot.Data());
+  slot.Sequence.store(pos + Capacity, std::memory_order_release);
+  return true;
+}
+
+//  each slot is still released on its own, so a consumer can take the first
+//  elements while the rest of the batch is being built
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename InputIterator>
+typename MpmcQueue<Type, Capacity, Allocator>::size_type
+MpmcQueue<Type, Capacity, Allocator>::try_push_n(InputIterator first, size_type count) {
+  static_assert(std::is_nothrow_constructible_v<Type, std::iter_reference_t<InputIterator>>,
+                "elements are built in claimed slots");
+  if (count == 0) {
+    return 0;
+  }
+  size_type pos;
+  size_type pushed{Claim(Tail, count, pos, [](size_type at) {return at;})};
+  for (size_type i{0}; i < pushed; i++, ++first) {
+    Slot &slot{Slots[(pos + i) & Mask]};
+    AllocatorTraits::construct(Alloc, slot.Data(), *first);
+    slot.Sequence.store(pos + i + 1, std::memory_order_release);
+  }
+  return pushed;
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename OutputIterator>
+typename MpmcQueue<Type, Capacity, Allocator>::size_type
+MpmcQueue<Type, Capacity, Allocator>::try_pop_n(OutputIterator out, size_type count) {
+  if (count == 0) {
+    return 0;
+  }
+  size_type pos;
+  size_type popped{Claim(Head, count, pos, [](size_type at) {return at + 1;})};
+  for (size_type i{0}; i < popped; i++, ++out) {
+    Slot &slot{Slots[(pos + i) & Mask]};
+    *out = std::move(*slot.Data());
+    AllocatorTraits::destroy(Alloc, slot.Data());
+    slot.Sequence.store(pos + i + Capacity, std::memory_order_release);
+  }
+  return popped;
+}
+
+//  Head never passes Tail and is loaded first, the difference may only
+//  overshoot when both move between the loads
+template<typename Type, size_t Capacity, typename Allocator>
+typename MpmcQueue<Type, Capacity, Allocator>::size_type MpmcQueue<Type, Capacity, Allocator>::size() const {
+  size_type head{Head.load(std::memory_order_acquire)};
+  size_type tail{Tail.load(std::memory_order_acquire)};
+  return tail - head < Capacity ? tail - head : Capacity;
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename Attempt>
+void MpmcQueue<Type, Capacity, Allocator>::Wait(Attempt attempt) {
+  for (int failed{0}; !attempt(); failed++) {
+    if (failed >= SpinLimit) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+namespace pmr {
+template<typename Type, size_t Capacity>
+using MpmcQueue = s21::MpmcQueue<Type, Capacity, std::pmr::polymorphic_allocator<Type>>;
+}
+}
+
+#endif // MY_MPMC_QUEUE_H
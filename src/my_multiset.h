@@ -5,67 +5,91 @@
 
 namespace s21 {
 
-template <class Key>
-class multiset : protected set<Key> {
+template <class Key, class Compare = std::less<>,
+          class Allocator = std::allocator<Key>>
+class multiset : protected set<Key, Compare, Allocator> {
  private:
   typedef Key key_type;
   typedef key_type value_type;
   typedef value_type& reference;
   typedef const value_type& const_reference;
   typedef size_t size_type;
+  template <class K>
+  static constexpr bool _Transparent =
+      BinarySearchTree<Key, Compare, Allocator>::template _Transparent<K>;
 
  public:
-  class MultisetIterator : protected set<Key>::SetIterator {
+  class MultisetIterator
+      : protected set<Key, Compare, Allocator>::SetIterator {
    private:
+    typedef typename set<Key, Compare, Allocator>::SetIterator SetIterator;
     friend class multiset;
-    BST_Node* _IncreaseIterator(BST_Node* tree, BST_Node* changeNode);
-    BST_Node* _DecreaceIterator(BST_Node* tree, BST_Node* changeNode);
-    bool _fake;
 
    public:
-    MultisetIterator() {
-      this->_node = nullptr;
-      _fake = false;
+    MultisetIterator() { this->_node = nullptr; }
+    ~MultisetIterator() { this->_node = nullptr; }
+    value_type operator*() {
+      return SetIterator::operator*();
     }
-    ~MultisetIterator() {
-      if (_fake && this->_node != nullptr) delete this->_node;
-      this->_node = nullptr;
-      _fake = false;
-    }
-    value_type operator*() { return set<value_type>::iterator::operator*(); }
     void operator=(const MultisetIterator& other) {
       if (*this != other) {
-        if (this->_fake) {
-          delete this->_node;
-        }
         this->_node = other._node;
-        this->_fake = other._fake;
       }
     }
     bool operator==(const MultisetIterator& other) {
-      return set<value_type>::iterator::operator==(other);
+      return SetIterator::operator==(other);
     }
     bool operator!=(const MultisetIterator& other) {
-      return set<value_type>::iterator::operator!=(other);
-    }
-    void operator++() {
-      this->_node = _IncreaseIterator(this->_node, this->_node);
-    }
-    void operator--() {
-      this->_node = _DecreaceIterator(this->_node, this->_node);
+      return SetIterator::operator!=(other);
     }
+    void operator++() { SetIterator::operator++(); }
+    void operator--() { SetIterator::operator--(); }
   };  // MultisetIterator
 
   typedef MultisetIterator iterator;
   typedef const MultisetIterator const_iterator;
 
+  typedef Allocator allocator_type;
+  typedef Compare key_compare;
+
   // Member functions
   multiset() {}
-  explicit multiset(std::initializer_list<value_type> const& items) {
+  explicit multiset(const Allocator& alloc)
+      : set<Key, Compare, Allocator>(alloc) {}
+  explicit multiset(const Compare& compare,
+                    const Allocator& alloc = Allocator())
+      : set<Key, Compare, Allocator>(compare, alloc) {}
+  explicit multiset(std::initializer_list<value_type> const& items,
+                    const Allocator& alloc = Allocator())
+      : set<Key, Compare, Allocator>(alloc) {
     for (auto& item : items) {
       this->insert(item);
     }
   }
+  // sorts the keys once and builds a balanced tree from them, equal keys
+  // keep their order
+  template <std::input_iterator InputIterator>
+  multiset(InputIterator first, InputIterator last,
+           const Allocator& alloc = Allocator())
+      : set<Key, Compare, Allocator>(alloc) {
+    this->_BuildTree(first, last, false, false);
+  }
+  template <std::input_iterator InputIterator>
+  multiset(InputIterator first, InputIterator last, const Compare& compare,
+           const Allocator& alloc = Allocator())
+      : set<Key, Compare, Allocator>(compare, alloc) {
+    this->_BuildTree(first, last, false, false);
+  }
+  // the same for keys that are already sorted by Compare, in O(n)
+  template <std::input_iterator InputIterator>
+  static multiset from_sorted(InputIterator first, InputIterator last,
+                              const Allocator& alloc = Allocator()) {
+    return from_sorted(first, last, Compare(), alloc);
+  }
+  template <std::input_iterator InputIterator>
+  static multiset from_sorted(InputIterator first, InputIterator last,
+                              const Compare& compare,
+                              const Allocator& alloc = Allocator());
   multiset(const multiset& ms);
   multiset(multiset&& ms);
   ~multiset() {}
@@ -79,6 +103,10 @@ class multiset : protected set<Key> {
   bool empty();
   size_type size();
   size_type max_size();
+  allocator_type get_allocator() {
+    return allocator_type(this->_nodePool.get_allocator());
+  }
+  key_compare key_comp() { return this->_compare; }
 
   // Modifiers
   void clear();
@@ -88,59 +116,120 @@ class multiset : protected set<Key> {
   void merge(multiset& other);
 
   // Lookup
-  size_type count(const Key& key);
-  iterator find(const Key& key);
-  bool contains(const Key& key);
-  std::pair<iterator, iterator> equal_range(const Key& key);
-  iterator lower_bound(const Key& key);
-  iterator upper_bound(const Key& key);
+  size_type count(const Key& key) { return _Count(key); }
+  iterator find(const Key& key) { return _Find(key); }
+  bool contains(const Key& key) { return _Find(key) != end(); }
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+  iterator lower_bound(const Key& key) {
+    return _IteratorTo(this->_LowerBoundNode(key));
+  }
+  iterator upper_bound(const Key& key) {
+    return _IteratorTo(this->_UpperBoundNode(key));
+  }
+  // the same for a key of another type that compares with Key, such as a
+  // std::string_view, without a temporary Key
+  template <class K>
+    requires _Transparent<K>
+  size_type count(const K& key) {
+    return _Count(key);
+  }
+  template <class K>
+    requires _Transparent<K>
+  iterator find(const K& key) {
+    return _Find(key);
+  }
+  template <class K>
+    requires _Transparent<K>
+  bool contains(const K& key) {
+    return _Find(key) != end();
+  }
+  template <class K>
+    requires _Transparent<K>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+  template <class K>
+    requires _Transparent<K>
+  iterator lower_bound(const K& key) {
+    return _IteratorTo(this->_LowerBoundNode(key));
+  }
+  template <class K>
+    requires _Transparent<K>
+  iterator upper_bound(const K& key) {
+    return _IteratorTo(this->_UpperBoundNode(key));
+  }
 
   // Emplace
   template <class... Args>
   std::vector<std::pair<iterator, bool>> emplace(Args&&... args);
   std::vector<std::pair<iterator, bool>> emplace();
+
+ private:
+  static iterator _IteratorTo(BST_Node* node) {
+    MultisetIterator iter;
+    iter._node = node;
+    return iter;
+  }
+  template <class K>
+  size_type _Count(const K& key);
+  template <class K>
+  iterator _Find(const K& key);
 };
-}  // namespace s21
 
-template <class value_type>
-typename s21::BST<value_type>::Node*
-s21::multiset<value_type>::iterator::_IncreaseIterator(BST_Node* tree,
-                                                       BST_Node* changeNode) {
-  return set<value_type>::iterator::_IncreaseIterator(tree, changeNode);
-}
+namespace pmr {
+template <class Key, class Compare = std::less<>>
+using multiset =
+    s21::multiset<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
 
-template <class value_type>
-typename s21::BST<value_type>::Node*
-s21::multiset<value_type>::iterator::_DecreaceIterator(BST_Node* tree,
-                                                       BST_Node* changeNode) {
-  return set<value_type>::iterator::_DecreaceIterator(tree, changeNode);
-}
+}  // namespace s21
 
 // Member function
 // -----------------------------------------------------------------------------
 
-template <class value_type>
-s21::multiset<value_type>::multiset(const multiset& ms) {
-  MultisetIterator it;
-  it._node = ms._root;
-  it._node = BST<value_type>::_MinimalNode(it._node);
-  while (it._node != nullptr) {
-    this->insert(*it);
-    ++it;
+template <class value_type, class Compare, class Allocator>
+s21::multiset<value_type, Compare, Allocator>::multiset(const multiset& ms)
+    : set<value_type, Compare, Allocator>(
+          ms._compare,
+          Allocator(BST<value_type, Compare, Allocator>::NodeTraits::
+                        select_on_container_copy_construction(
+                            ms._nodePool.get_allocator()))) {
+  for (BST_Node* node = ms._header._left; node != &ms._header;
+       node = this->_NextNode(node)) {
+    this->_InsertInTree(node->_key);
   }
 }
 
-template <class value_type>
-s21::multiset<value_type>::multiset(multiset&& ms) {
-  if (this->_root != ms._root) {
-    std::swap(this->_root, ms._root);
-  }
+template <class value_type, class Compare, class Allocator>
+template <std::input_iterator InputIterator>
+s21::multiset<value_type, Compare, Allocator>
+s21::multiset<value_type, Compare, Allocator>::from_sorted(
+    InputIterator first, InputIterator last, const Compare& compare,
+    const Allocator& alloc) {
+  multiset result(compare, alloc);
+  result._BuildTree(first, last, true, false);
+  return result;
 }
 
-template <class value_type>
-void s21::multiset<value_type>::operator=(multiset&& ms) {
-  if (this->_root != ms._root) {
-    std::swap(this->_root, ms._root);
+template <class value_type, class Compare, class Allocator>
+s21::multiset<value_type, Compare, Allocator>::multiset(multiset&& ms)
+    : set<value_type, Compare, Allocator>(
+          Allocator(ms._nodePool.get_allocator())) {
+  this->_SwapTree(ms);
+}
+
+template <class value_type, class Compare, class Allocator>
+void s21::multiset<value_type, Compare, Allocator>::operator=(multiset&& ms) {
+  if (this != &ms) {
+    if (this->_nodePool.get_allocator() == ms._nodePool.get_allocator()) {
+      this->_SwapTree(ms);
+    } else {
+      this->clear();
+      this->_compare = ms._compare;
+      this->merge(ms);
+    }
   }
 }
 
@@ -149,22 +238,19 @@ void s21::multiset<value_type>::operator=(multiset&& ms) {
 // Iterator
 // -----------------------------------------------------------------------------
 
-template <class value_type>
-typename s21::multiset<value_type>::iterator
-s21::multiset<value_type>::begin() {
+template <class value_type, class Compare, class Allocator>
+typename s21::multiset<value_type, Compare, Allocator>::iterator
+s21::multiset<value_type, Compare, Allocator>::begin() {
   MultisetIterator returnIterator;
-  returnIterator._node = BST<value_type>::_MinimalNode(this->_root);
+  returnIterator._node = this->_header._left;
   return returnIterator;
 }
 
-template <class value_type>
-typename s21::multiset<value_type>::iterator s21::multiset<value_type>::end() {
+template <class value_type, class Compare, class Allocator>
+typename s21::multiset<value_type, Compare, Allocator>::iterator
+s21::multiset<value_type, Compare, Allocator>::end() {
   MultisetIterator returnIterator;
-  if (this->_root != nullptr) {
-    returnIterator._node = BST<value_type>::_MaximalNode(this->_root)->_right;
-  } else {
-    returnIterator._node = this->_root;
-  }
+  returnIterator._node = this->_Header();
   return returnIterator;
 }
 
@@ -173,25 +259,21 @@ typename s21::multiset<value_type>::iterator s21::multiset<value_type>::end() {
 // Capacity
 // -----------------------------------------------------------------------------
 
-template <class value_type>
-bool s21::multiset<value_type>::empty() {
-  return this->_root == nullptr ? true : false;
+template <class value_type, class Compare, class Allocator>
+bool s21::multiset<value_type, Compare, Allocator>::empty() {
+  return this->_size == 0 ? true : false;
 }
 
-template <class value_type>
-typename s21::multiset<value_type>::size_type
-s21::multiset<value_type>::size() {
-  size_type currentSize = 0;
-  for (iterator it = this->begin(); it != this->end(); ++it) {
-    currentSize++;
-  }
-  return currentSize;
+template <class value_type, class Compare, class Allocator>
+typename s21::multiset<value_type, Compare, Allocator>::size_type
+s21::multiset<value_type, Compare, Allocator>::size() {
+  return this->_size;
 }
 
-template <class value_type>
-typename s21::multiset<value_type>::size_type
-s21::multiset<value_type>::max_size() {
-  return set<value_type>::max_size();
+template <class value_type, class Compare, class Allocator>
+typename s21::multiset<value_type, Compare, Allocator>::size_type
+s21::multiset<value_type, Compare, Allocator>::max_size() {
+  return set<value_type, Compare, Allocator>::max_size();
 }
 
 // -----------------------------------------------------------------------------
@@ -199,42 +281,38 @@ s21::multiset<value_type>::max_size() {
 // Modifiers
 // -----------------------------------------------------------------------------
 
-template <class value_type>
-void s21::multiset<value_type>::clear() {
-  this->_DeleteAllTree(this->_root);
+template <class value_type, class Compare, class Allocator>
+void s21::multiset<value_type, Compare, Allocator>::clear() {
+  this->_Clear();
 }
 
-template <class value_type>
-typename s21::multiset<value_type>::iterator s21::multiset<value_type>::insert(
+template <class value_type, class Compare, class Allocator>
+typename s21::multiset<value_type, Compare, Allocator>::iterator
+s21::multiset<value_type, Compare, Allocator>::insert(
     const value_type& value) {
-  BST_Node* tempNode = BST<value_type>::_FindNode(this->_root, value);
   MultisetIterator returnIterator;
-  BST<value_type>::_InsertInTree(value);
-  if (tempNode != nullptr) {
-    returnIterator._node = BST<value_type>::_FindNode(tempNode, value);
-  } else {
-    returnIterator._node = BST<value_type>::_FindNode(this->_root, value);
-  }
+  returnIterator._node = this->_InsertInTree(value);
   return returnIterator;
 }
 
-template <class value_type>
-void s21::multiset<value_type>::erase(iterator& pos) {
-  if (pos._node != nullptr) {
-    BST<value_type>::_DeleteNode(this->_root, pos._node->_key);
+template <class value_type, class Compare, class Allocator>
+void s21::multiset<value_type, Compare, Allocator>::erase(iterator& pos) {
+  if (pos._node != nullptr && !this->_IsHeader(pos._node)) {
+    this->_EraseNode(pos._node);
   }
 }
 
-template <class value_type>
-void s21::multiset<value_type>::swap(multiset&& other) {
-  if (this->_root != other._root) {
-    std::swap(this->_root, other._root);
+template <class value_type, class Compare, class Allocator>
+void s21::multiset<value_type, Compare, Allocator>::swap(multiset&& other) {
+  if (this != &other) {
+    // the pools swap their allocators when the allocator propagates
+    this->_SwapTree(other);
   }
 }
 
-template <class value_type>
-void s21::multiset<value_type>::merge(multiset& other) {
-  if (this->_root != other._root) {
+template <class value_type, class Compare, class Allocator>
+void s21::multiset<value_type, Compare, Allocator>::merge(multiset& other) {
+  if (this != &other) {
     for (iterator it = other.begin(); it != other.end(); ++it) {
       this->insert(*it);
     }
@@ -246,102 +324,42 @@ void s21::multiset<value_type>::merge(multiset& other) {
 // Lookup
 // -----------------------------------------------------------------------------
 
-template <class value_type>
-typename s21::multiset<value_type>::size_type s21::multiset<value_type>::count(
-    const value_type& key) {
+// counts the nodes between the bounds instead of comparing every key
+template <class value_type, class Compare, class Allocator>
+template <class K>
+typename s21::multiset<value_type, Compare, Allocator>::size_type
+s21::multiset<value_type, Compare, Allocator>::_Count(const K& key) {
   size_type counter = 0;
-  if (this->contains(key)) {
-    MultisetIterator iter = this->find(key);
-    while (*iter == key) {
-      ++counter;
-      ++iter;
-    }
+  BST_Node* last = this->_UpperBoundNode(key);
+  for (BST_Node* node = this->_LowerBoundNode(key); node != last;
+       node = this->_NextNode(node)) {
+    ++counter;
   }
   return counter;
 }
 
-template <class value_type>
-typename s21::multiset<value_type>::iterator s21::multiset<value_type>::find(
-    const value_type& key) {
+template <class value_type, class Compare, class Allocator>
+template <class K>
+typename s21::multiset<value_type, Compare, Allocator>::iterator
+s21::multiset<value_type, Compare, Allocator>::_Find(const K& key) {
   MultisetIterator returnIterator;
-  returnIterator._node = BST<value_type>::_FindNode(this->_root, key);
+  returnIterator._node = this->_FindNode(this->_Root(), key);
   if (returnIterator._node == nullptr) {
     returnIterator = this->end();
   }
   return returnIterator;
 }
 
-template <class value_type>
-bool s21::multiset<value_type>::contains(const value_type& key) {
-  return this->find(key) != this->end() ? true : false;
-}
-
-template <class value_type>
-typename s21::multiset<value_type>::iterator
-s21::multiset<value_type>::lower_bound(const value_type& key) {
-  MultisetIterator iter;
-  iter = this->find(key);
-  if (iter == this->end()) {
-    if (key < *this->begin()) {
-      iter = this->begin();
-    } else {
-      iter._node = new typename BST<value_type>::Node;
-      if (!this->empty()) {
-        iter._node->_key = this->size();
-      } else {
-        iter._node->_key = (value_type)0;
-      }
-      iter._fake = true;
-    }
-  }
-  return iter;
-}
-
-template <class value_type>
-typename s21::multiset<value_type>::iterator
-s21::multiset<value_type>::upper_bound(const value_type& key) {
-  MultisetIterator iter = this->find(key);
-  if (iter != this->end()) {
-    while (*iter == key) {
-      ++iter;
-    }
-    if (iter == this->end()) {
-      iter._node = new typename BST<value_type>::Node;
-      iter._node->_key = this->size();
-      iter._fake = true;
-    }
-  } else {
-    if (key < *this->begin()) {
-      iter = this->begin();
-    } else {
-      iter._node = new typename BST<value_type>::Node;
-      if (!this->empty()) {
-        iter._node->_key = this->size();
-      } else {
-        iter._node->_key = (value_type)0;
-      }
-      iter._fake = true;
-    }
-  }
-  return iter;
-}
-
-template <class value_type>
-std::pair<typename s21::multiset<value_type>::iterator,
-          typename s21::multiset<value_type>::iterator>
-s21::multiset<value_type>::equal_range(const value_type& key) {
-  return std::make_pair(this->lower_bound(key), this->upper_bound(key));
-}
-
 // -----------------------------------------------------------------------------
 
 // Emplace
 // -----------------------------------------------------------------------------
 
-template <class value_type>
+template <class value_type, class Compare, class Allocator>
 template <class... Args>
-std::vector<std::pair<typename s21::multiset<value_type>::iterator, bool>>
-s21::multiset<value_type>::emplace(Args&&... args) {
+std::vector<std::pair<
+    typename s21::multiset<value_type, Compare, Allocator>::iterator, bool>>
+s21::multiset<value_type, Compare, Allocator>::emplace(Args&&... args) {
   std::vector<std::pair<iterator, bool>> resultVector;
   std::vector<value_type> itemVector = {args...};
   for (auto& item : itemVector) {
@@ -351,9 +369,10 @@ s21::multiset<value_type>::emplace(Args&&... args) {
   return resultVector;
 }
 
-template <class value_type>
-std::vector<std::pair<typename s21::multiset<value_type>::iterator, bool>>
-s21::multiset<value_type>::emplace() {
+template <class value_type, class Compare, class Allocator>
+std::vector<std::pair<
+    typename s21::multiset<value_type, Compare, Allocator>::iterator, bool>>
+s21::multiset<value_type, Compare, Allocator>::emplace() {
   std::vector<std::pair<iterator, bool>> resultVector;
   resultVector.push_back(std::make_pair(this->end(), false));
   return resultVector;
@@ -0,0 +1,240 @@
+#ifndef MY_NODE_POOL_H
+#define MY_NODE_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+
+// Slab allocator for the nodes of one container. Nodes are cut from chunks
+// obtained from the container allocator, freed nodes go to a free list and
+// are handed out again before the chunks grow. Chunks double in size up to
+// _maxChunkBytes, so n nodes cost O(log n) upstream allocations, and
+// Release() returns everything in O(chunks) without visiting the nodes.
+//
+// The chunks live in a store that is created on the first Allocate(). When
+// nodes move from one container to another (List::splice), Join() makes
+// both pools use one store, a store that was merged into another forwards
+// to it until the last pool that still points at it moves on.
+template <typename NodeType, typename Allocator>
+class NodePool {
+ public:
+  typedef size_t size_type;
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<
+      NodeType>
+      allocator_type;
+
+  NodePool() {}
+
+  explicit NodePool(const allocator_type& alloc) : _alloc(alloc) {}
+
+  NodePool(const NodePool&) = delete;
+
+  NodePool(NodePool&& other) : _alloc(std::move(other._alloc)) {
+    std::swap(_store, other._store);
+  }
+
+  ~NodePool() { Release(); }
+
+  void operator=(const NodePool&) = delete;
+
+  // returns uninitialized storage for one node
+  NodeType* Allocate() {
+    Store* store = _Resolve();
+    if (store == nullptr) store = _store = _NewStore();
+    Slot* slot = store->_free;
+    if (slot != nullptr) {
+      store->_free = slot->_next;
+    } else {
+      if (store->_bump == store->_bumpEnd) _NewChunk(store);
+      slot = store->_bump++;
+    }
+    return reinterpret_cast<NodeType*>(slot->_storage);
+  }
+
+  // the node must already be destroyed
+  void Deallocate(NodeType* node) {
+    Store* store = _Resolve();
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    if (store->_free == nullptr) store->_freeTail = slot;
+    slot->_next = store->_free;
+    store->_free = slot;
+  }
+
+  // frees every chunk, nodes still alive must not be used afterwards. A
+  // shared store is only left, the other pools keep their nodes in it, so
+  // the nodes of this pool have to be deallocated one by one before
+  void Release() {
+    if (_store != nullptr) _Drop(_store);
+    _store = nullptr;
+  }
+
+  // true when the store is used by other pools as well
+  bool Shared() {
+    Store* store = _Resolve();
+    return store != nullptr && store->_refs > 1;
+  }
+
+  // makes both pools use one store holding the chunks of both, so nodes
+  // can be relinked from one container into the other. The allocators must
+  // compare equal
+  void Join(NodePool& other) {
+    Store* store = _Resolve();
+    Store* from = other._Resolve();
+    if (from == nullptr || store == from) return;
+    if (store == nullptr) {
+      from->_refs++;
+      _store = from;
+      return;
+    }
+    // the chunk list of the smaller store is walked and appended
+    if (store->_chunkCount < from->_chunkCount) std::swap(store, from);
+    _MoveChunks(store, from);
+    // one reference for the pool moving over, one for the forwarding store
+    from->_forward = store;
+    store->_refs += 2;
+    NodePool& moving = _store == from ? *this : other;
+    moving._store = store;
+    _Drop(from);
+  }
+
+  // allocators follow propagate_on_container_swap like the containers do
+  void Swap(NodePool& other) {
+    if constexpr (std::allocator_traits<
+                      allocator_type>::propagate_on_container_swap::value) {
+      std::swap(_alloc, other._alloc);
+    }
+    std::swap(_store, other._store);
+  }
+
+  allocator_type& get_allocator() { return _alloc; }
+
+  const allocator_type& get_allocator() const { return _alloc; }
+
+ private:
+  union Slot;
+
+  struct ChunkHeader {
+    Slot* _next;
+    size_type _count;
+  };
+
+  // the first slot of a chunk holds its header
+  union Slot {
+    Slot* _next;
+    ChunkHeader _chunk;
+    alignas(NodeType) unsigned char _storage[sizeof(NodeType)];
+  };
+
+  // _refs counts the pools using the store and the stores forwarding to it
+  struct Store {
+    Slot* _free = nullptr;
+    Slot* _freeTail = nullptr;
+    Slot* _bump = nullptr;
+    Slot* _bumpEnd = nullptr;
+    Slot* _chunks = nullptr;
+    size_type _nextChunkSlots = _minChunkSlots;
+    size_type _chunkCount = 0;
+    size_type _refs = 1;
+    Store* _forward = nullptr;
+  };
+
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>
+      SlotAllocator;
+  typedef std::allocator_traits<SlotAllocator> SlotTraits;
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<
+      Store>
+      StoreAllocator;
+  typedef std::allocator_traits<StoreAllocator> StoreTraits;
+
+  static constexpr size_type _minChunkSlots = 16;
+  static constexpr size_type _maxChunkBytes = 64 * 1024;
+
+  [[no_unique_address]] allocator_type _alloc;
+  Store* _store = nullptr;
+
+  Store* _NewStore() {
+    StoreAllocator storeAlloc(_alloc);
+    Store* store = StoreTraits::allocate(storeAlloc, 1);
+    StoreTraits::construct(storeAlloc, store);
+    return store;
+  }
+
+  void _NewChunk(Store* store) {
+    SlotAllocator slotAlloc(_alloc);
+    size_type count = store->_nextChunkSlots;
+    Slot* chunk = SlotTraits::allocate(slotAlloc, count);
+    chunk->_chunk._next = store->_chunks;
+    chunk->_chunk._count = count;
+    store->_chunks = chunk;
+    store->_bump = chunk + 1;
+    store->_bumpEnd = chunk + count;
+    store->_chunkCount++;
+    if (count * 2 * sizeof(Slot) <= _maxChunkBytes) {
+      store->_nextChunkSlots *= 2;
+    }
+  }
+
+  // follows the forwarding stores and moves this pool to the live one
+  Store* _Resolve() {
+    while (_store != nullptr && _store->_forward != nullptr) {
+      Store* next = _store->_forward;
+      next->_refs++;
+      _Drop(_store);
+      _store = next;
+    }
+    return _store;
+  }
+
+  // the chunks and free slots of from go to store, the rest of the bump
+  // range of from is kept only if store has none
+  static void _MoveChunks(Store* store, Store* from) {
+    if (from->_chunks != nullptr) {
+      Slot* last = from->_chunks;
+      while (last->_chunk._next != nullptr) last = last->_chunk._next;
+      last->_chunk._next = store->_chunks;
+      store->_chunks = from->_chunks;
+    }
+    if (from->_free != nullptr) {
+      from->_freeTail->_next = store->_free;
+      if (store->_free == nullptr) store->_freeTail = from->_freeTail;
+      store->_free = from->_free;
+    }
+    if (store->_bump == store->_bumpEnd) {
+      store->_bump = from->_bump;
+      store->_bumpEnd = from->_bumpEnd;
+    }
+    if (from->_nextChunkSlots > store->_nextChunkSlots) {
+      store->_nextChunkSlots = from->_nextChunkSlots;
+    }
+    store->_chunkCount += from->_chunkCount;
+    from->_chunkCount = 0;
+    from->_chunks = nullptr;
+    from->_free = nullptr;
+    from->_freeTail = nullptr;
+    from->_bump = nullptr;
+    from->_bumpEnd = nullptr;
+  }
+
+  // drops one reference, the last one frees the chunks and the store
+  void _Drop(Store* store) {
+    SlotAllocator slotAlloc(_alloc);
+    StoreAllocator storeAlloc(_alloc);
+    while (store != nullptr && --store->_refs == 0) {
+      while (store->_chunks != nullptr) {
+        Slot* chunk = store->_chunks;
+        store->_chunks = chunk->_chunk._next;
+        SlotTraits::deallocate(slotAlloc, chunk, chunk->_chunk._count);
+      }
+      Store* forward = store->_forward;
+      StoreTraits::destroy(storeAlloc, store);
+      StoreTraits::deallocate(storeAlloc, store, 1);
+      store = forward;
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // MY_NODE_POOL_H
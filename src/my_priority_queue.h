@@ -0,0 +1,456 @@
+#ifndef MY_PRIORITY_QUEUE_H
+#define MY_PRIORITY_QUEUE_H
+
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "my_containerAdaptor.h"
+#include "my_vector.h"
+
+namespace s21 {
+//  Sift operations of an implicit d-ary heap kept in Store[0, Size): the
+//  children of i are i * Arity + 1 ... i * Arity + Arity and the element that
+//  Compare orders last is at the root, as in std::priority_queue. A wider node
+//  makes the heap shallower and its children share a cache line, at the price
+//  of more comparisons per level on the way down. Elements are moved through a
+//  hole instead of being swapped, Moved(pos) is called for every element that
+//  lands at pos so that a caller can keep track of positions.
+template<size_t Arity>
+struct DaryHeap {
+  static_assert(Arity >= 2, "a heap node needs at least two children");
+
+  //  positions are not tracked
+  struct IgnoreMoves {
+    void operator()(size_t) const {}
+  };
+
+  template<typename Store, typename Compare, typename Moved = IgnoreMoves>
+  static void SiftUp(Store &store, size_t Pos, Compare &comp, Moved moved = Moved());
+
+  template<typename Store, typename Compare, typename Moved = IgnoreMoves>
+  static void SiftDown(Store &store, size_t Size, size_t Pos, Compare &comp, Moved moved = Moved());
+
+  //  SiftDown for an element that most likely belongs near the bottom, like
+  //  the last element moved to the root by pop: the hole goes down to a leaf
+  //  comparing only the children, then the element is sifted up from there
+  template<typename Store, typename Compare, typename Moved = IgnoreMoves>
+  static void SiftToLeaf(Store &store, size_t Size, size_t Pos, Compare &comp, Moved moved = Moved());
+
+  //  Floyd's bottom-up construction, O(Size)
+  template<typename Store, typename Compare, typename Moved = IgnoreMoves>
+  static void Heapify(Store &store, size_t Size, Compare &comp, Moved moved = Moved());
+
+ private:
+  //  the child of first's parent ordered last, a full node is scanned with a
+  //  loop of constant length
+  template<typename Store, typename Compare>
+  static size_t BestChild(Store &store, size_t Size, size_t First, Compare &comp);
+};
+
+//  Priority queue over a random access container, top() is the greatest
+//  element for the default std::less. Arity 4 is the default because a node's
+//  children then fit in one cache line for small elements, Arity 2 gives the
+//  classic binary heap.
+template<typename Type, typename Container = Vector<Type>, typename Compare = std::less<Type>, size_t Arity = 4>
+class PriorityQueue : public ContainerAdaptor<Container> {
+  static_assert(std::is_same_v<Type, typename Container::value_type>);
+ public:
+  typedef typename ContainerAdaptor<Container>::size_type size_type;
+  typedef typename ContainerAdaptor<Container>::value_type value_type;
+  typedef typename ContainerAdaptor<Container>::const_reference const_reference;
+  typedef typename ContainerAdaptor<Container>::allocator_type allocator_type;
+  typedef Compare value_compare;
+
+  PriorityQueue() {
+  }
+
+  explicit PriorityQueue(const Compare &comp, const allocator_type &alloc = allocator_type())
+      : ContainerAdaptor<Container>(alloc), Comp(comp) {
+  }
+
+  explicit PriorityQueue(const allocator_type &alloc) : ContainerAdaptor<Container>(alloc) {
+  }
+
+  //  the elements of store are heapified in O(n)
+  PriorityQueue(const Compare &comp, Container &&store)
+      : ContainerAdaptor<Container>(std::move(store)), Comp(comp) {
+    Heap::Heapify(this->Store, this->size(), Comp);
+  }
+
+  PriorityQueue(std::initializer_list<value_type> const &items, const Compare &comp = Compare(),
+                const allocator_type &alloc = allocator_type())
+      : ContainerAdaptor<Container>(alloc), Comp(comp) {
+    push_range(items);
+  }
+
+  const_reference top() {return this->Store.front();}
+
+  void push(const value_type &value);
+
+  void push(value_type &&value);
+
+  template<typename... Args>
+  void emplace(Args &&...args);
+
+  //  a range at least as long as the queue is appended and heapified in
+  //  O(n), a shorter one is sifted up element by element
+  template<typename Range>
+  void push_range(Range &&range);
+
+  void pop();
+
+  void swap(PriorityQueue &other);
+
+ private:
+  typedef DaryHeap<Arity> Heap;
+
+  [[no_unique_address]] Compare Comp;
+};
+
+//  Priority queue whose elements can be found again through the handle
+//  returned by push: update changes an element and restores the heap in
+//  O(log n), which gives the decrease-key of Dijkstra and of schedulers. A
+//  handle stays valid until its element is popped or erased, after that it
+//  may be given to a new element.
+template<typename Type, typename Compare = std::less<Type>, size_t Arity = 4, typename Allocator = std::allocator<Type>>
+class AddressablePriorityQueue {
+ public:
+  typedef size_t size_type;
+  typedef size_t handle_type;
+  typedef Type value_type;
+  typedef const Type &const_reference;
+  typedef Allocator allocator_type;
+  typedef Compare value_compare;
+
+  AddressablePriorityQueue() {
+  }
+
+  explicit AddressablePriorityQueue(const Compare &comp, const Allocator &alloc = Allocator())
+      : Entries(EntryAllocator(alloc)), Positions(IndexAllocator(alloc)), FreeHandles(IndexAllocator(alloc)),
+        Comp{comp} {
+  }
+
+  explicit AddressablePriorityQueue(const Allocator &alloc)
+      : AddressablePriorityQueue(Compare(), alloc) {
+  }
+
+  const_reference top() {return Entries.front().Value;}
+
+  handle_type top_handle() {return Entries.front().Handle;}
+
+  handle_type push(const value_type &value) {return emplace(value);}
+
+  handle_type push(value_type &&value) {return emplace(std::move(value));}
+
+  template<typename... Args>
+  handle_type emplace(Args &&...args);
+
+  void pop() {erase(top_handle());}
+
+  //  replaces the element of handle and moves it up or down the heap
+  void update(handle_type handle, const value_type &value) {Replace(handle, value);}
+
+  void update(handle_type handle, value_type &&value) {Replace(handle, std::move(value));}
+
+  void erase(handle_type handle);
+
+  //  the element of a live handle
+  const_reference at(handle_type handle) {return Entries[Position(handle)].Value;}
+
+  bool contains(handle_type handle) {
+    return handle < Positions.size() && Positions[handle] != NoPosition;
+  }
+
+  bool empty() {return Entries.empty();}
+
+  size_type size() {return Entries.size();}
+
+  void swap(AddressablePriorityQueue &other);
+
+  allocator_type get_allocator() {return allocator_type(Entries.get_allocator());}
+
+ private:
+  struct Entry {
+    Type Value;
+    handle_type Handle;
+
+    template<typename... Args>
+    Entry(handle_type handle, Args &&...args) : Value(std::forward<Args>(args)...), Handle(handle) {}
+  };
+
+  //  orders the entries by their values
+  struct EntryCompare {
+    [[no_unique_address]] Compare Comp;
+
+    bool operator()(const Entry &left, const Entry &right) {return Comp(left.Value, right.Value);}
+  };
+
+  //  writes the new position of a moved entry into Positions
+  struct TrackPosition {
+    AddressablePriorityQueue *Queue;
+
+    void operator()(size_type pos) const {Queue->Positions[Queue->Entries[pos].Handle] = pos;}
+  };
+
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<Entry> EntryAllocator;
+  typedef typename AllocatorTraits::template rebind_alloc<size_type> IndexAllocator;
+  typedef DaryHeap<Arity> Heap;
+
+  static constexpr size_type NoPosition{static_cast<size_type>(-1)};
+
+  //  the heap, Positions maps a handle to the index of its entry in Entries
+  //  and FreeHandles keeps the handles of removed entries for reuse
+  Vector<Entry, EntryAllocator> Entries;
+  Vector<size_type, IndexAllocator> Positions;
+  Vector<size_type, IndexAllocator> FreeHandles;
+  [[no_unique_address]] EntryCompare Comp;
+
+  size_type Position(handle_type handle);
+
+  template<typename Value>
+  void Replace(handle_type handle, Value &&value);
+
+  //  restores the heap after the entry at pos changed
+  void Restore(size_type pos);
+};
+
+template<size_t Arity>
+template<typename Store, typename Compare, typename Moved>
+void DaryHeap<Arity>::SiftUp(Store &store, size_t Pos, Compare &comp, Moved moved) {
+  auto value{std::move(store[Pos])};
+  while (Pos > 0) {
+    size_t parent{(Pos - 1) / Arity};
+    if (!comp(store[parent], value)) {
+      break;
+    }
+    store[Pos] = std::move(store[parent]);
+    moved(Pos);
+    Pos = parent;
+  }
+  store[Pos] = std::move(value);
+  moved(Pos);
+}
+
+template<size_t Arity>
+template<typename Store, typename Compare, typename Moved>
+void DaryHeap<Arity>::SiftDown(Store &store, size_t Size, size_t Pos, Compare &comp, Moved moved) {
+  auto value{std::move(store[Pos])};
+  while (true) {
+    size_t first{Pos * Arity + 1};
+    if (first >= Size) {
+      break;
+    }
+    size_t best{BestChild(store, Size, first, comp)};
+    if (!comp(value, store[best])) {
+      break;
+    }
+    store[Pos] = std::move(store[best]);
+    moved(Pos);
+    Pos = best;
+  }
+  store[Pos] = std::move(value);
+  moved(Pos);
+}
+
+template<size_t Arity>
+template<typename Store, typename Compare, typename Moved>
+void DaryHeap<Arity>::SiftToLeaf(Store &store, size_t Size, size_t Pos, Compare &comp, Moved moved) {
+  auto value{std::move(store[Pos])};
+  size_t top{Pos};
+  for (size_t first{Pos * Arity + 1}; first < Size; first = Pos * Arity + 1) {
+    size_t best{BestChild(store, Size, first, comp)};
+    store[Pos] = std::move(store[best]);
+    moved(Pos);
+    Pos = best;
+  }
+  while (Pos > top) {
+    size_t parent{(Pos - 1) / Arity};
+    if (!comp(store[parent], value)) {
+      break;
+    }
+    store[Pos] = std::move(store[parent]);
+    moved(Pos);
+    Pos = parent;
+  }
+  store[Pos] = std::move(value);
+  moved(Pos);
+}
+
+template<size_t Arity>
+template<typename Store, typename Compare>
+size_t DaryHeap<Arity>::BestChild(Store &store, size_t Size, size_t First, Compare &comp) {
+  size_t best{First};
+  if (First + Arity <= Size) {
+    for (size_t i{1}; i < Arity; i++) {
+      if (comp(store[best], store[First + i])) {
+        best = First + i;
+      }
+    }
+  } else {
+    for (size_t child{First + 1}; child < Size; child++) {
+      if (comp(store[best], store[child])) {
+        best = child;
+      }
+    }
+  }
+  return best;
+}
+
+template<size_t Arity>
+template<typename Store, typename Compare, typename Moved>
+void DaryHeap<Arity>::Heapify(Store &store, size_t Size, Compare &comp, Moved moved) {
+  if (Size < 2) {
+    return;
+  }
+  for (size_t pos{(Size - 2) / Arity + 1}; pos > 0; pos--) {
+    SiftDown(store, Size, pos - 1, comp, moved);
+  }
+}
+
+template<typename Type, typename Container, typename Compare, size_t Arity>
+void PriorityQueue<Type, Container, Compare, Arity>::push(const value_type &value) {
+  ContainerAdaptor<Container>::push(value);
+  Heap::SiftUp(this->Store, this->size() - 1, Comp);
+}
+
+template<typename Type, typename Container, typename Compare, size_t Arity>
+void PriorityQueue<Type, Container, Compare, Arity>::push(value_type &&value) {
+  ContainerAdaptor<Container>::push(std::move(value));
+  Heap::SiftUp(this->Store, this->size() - 1, Comp);
+}
+
+template<typename Type, typename Container, typename Compare, size_t Arity>
+template<typename... Args>
+void PriorityQueue<Type, Container, Compare, Arity>::emplace(Args &&...args) {
+  ContainerAdaptor<Container>::emplace(std::forward<Args>(args)...);
+  Heap::SiftUp(this->Store, this->size() - 1, Comp);
+}
+
+template<typename Type, typename Container, typename Compare, size_t Arity>
+template<typename Range>
+void PriorityQueue<Type, Container, Compare, Arity>::push_range(Range &&range) {
+  size_type old{this->size()};
+  ContainerAdaptor<Container>::push_range(std::forward<Range>(range));
+  size_type size{this->size()};
+  if (size - old >= old) {
+    Heap::Heapify(this->Store, size, Comp);
+  } else {
+    for (size_type pos{old}; pos < size; pos++) {
+      Heap::SiftUp(this->Store, pos, Comp);
+    }
+  }
+}
+
+template<typename Type, typename Container, typename Compare, size_t Arity>
+void PriorityQueue<Type, Container, Compare, Arity>::pop() {
+  if (this->empty()) {
+    throw std::out_of_range("No such element");
+  }
+  size_type size{this->size() - 1};
+  if (size > 0) {
+    this->Store[0] = std::move(this->Store[size]);
+  }
+  this->Store.pop_back();
+  if (size > 1) {
+    Heap::SiftToLeaf(this->Store, size, 0, Comp);
+  }
+}
+
+template<typename Type, typename Container, typename Compare, size_t Arity>
+void PriorityQueue<Type, Container, Compare, Arity>::swap(PriorityQueue &other) {
+  ContainerAdaptor<Container>::swap(other);
+  std::swap(Comp, other.Comp);
+}
+
+template<typename Type, typename Compare, size_t Arity, typename Allocator>
+template<typename... Args>
+typename AddressablePriorityQueue<Type, Compare, Arity, Allocator>::handle_type
+AddressablePriorityQueue<Type, Compare, Arity, Allocator>::emplace(Args &&...args) {
+  bool reused{!FreeHandles.empty()};
+  handle_type handle{reused ? FreeHandles.back() : Positions.size()};
+  if (!reused) {
+    Positions.push_back(NoPosition);
+  }
+  try {
+    Entries.EmplaceBack(handle, std::forward<Args>(args)...);
+  } catch (...) {
+    if (!reused) {
+      Positions.pop_back();
+    }
+    throw;
+  }
+  if (reused) {
+    FreeHandles.pop_back();
+  }
+  Heap::SiftUp(Entries, Entries.size() - 1, Comp, TrackPosition{this});
+  return handle;
+}
+
+template<typename Type, typename Compare, size_t Arity, typename Allocator>
+void AddressablePriorityQueue<Type, Compare, Arity, Allocator>::erase(handle_type handle) {
+  size_type pos{Position(handle)};
+  size_type last{Entries.size() - 1};
+  Positions[handle] = NoPosition;
+  FreeHandles.push_back(handle);
+  if (pos != last) {
+    Entries[pos] = std::move(Entries[last]);
+    Entries.pop_back();
+    if (pos == 0) {
+      Heap::SiftToLeaf(Entries, Entries.size(), 0, Comp, TrackPosition{this});
+    } else {
+      Restore(pos);
+    }
+  } else {
+    Entries.pop_back();
+  }
+}
+
+template<typename Type, typename Compare, size_t Arity, typename Allocator>
+void AddressablePriorityQueue<Type, Compare, Arity, Allocator>::swap(AddressablePriorityQueue &other) {
+  Entries.swap(other.Entries);
+  Positions.swap(other.Positions);
+  FreeHandles.swap(other.FreeHandles);
+  std::swap(Comp, other.Comp);
+}
+
+template<typename Type, typename Compare, size_t Arity, typename Allocator>
+typename AddressablePriorityQueue<Type, Compare, Arity, Allocator>::size_type
+AddressablePriorityQueue<Type, Compare, Arity, Allocator>::Position(handle_type handle) {
+  if (!contains(handle)) {
+    throw std::out_of_range("No such element");
+  }
+  return Positions[handle];
+}
+
+template<typename Type, typename Compare, size_t Arity, typename Allocator>
+template<typename Value>
+void AddressablePriorityQueue<Type, Compare, Arity, Allocator>::Replace(handle_type handle, Value &&value) {
+  size_type pos{Position(handle)};
+  Entries[pos].Value = std::forward<Value>(value);
+  Restore(pos);
+}
+
+template<typename Type, typename Compare, size_t Arity, typename Allocator>
+void AddressablePriorityQueue<Type, Compare, Arity, Allocator>::Restore(size_type pos) {
+  if (pos > 0 && Comp(Entries[(pos - 1) / Arity], Entries[pos])) {
+    Heap::SiftUp(Entries, pos, Comp, TrackPosition{this});
+  } else {
+    Heap::SiftDown(Entries, Entries.size(), pos, Comp, TrackPosition{this});
+  }
+}
+
+namespace pmr {
+template<typename Type, typename Compare = std::less<Type>, size_t Arity = 4>
+using PriorityQueue = s21::PriorityQueue<Type, s21::pmr::Vector<Type>, Compare, Arity>;
+
+template<typename Type, typename Compare = std::less<Type>, size_t Arity = 4>
+using AddressablePriorityQueue =
+    s21::AddressablePriorityQueue<Type, Compare, Arity, std::pmr::polymorphic_allocator<Type>>;
+}
+}
+
+#endif // MY_PRIORITY_QUEUE_H
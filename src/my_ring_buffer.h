@@ -0,0 +1,342 @@
+#ifndef MY_RING_BUFFER_H
+#define MY_RING_BUFFER_H
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+//  Elements are kept in a circular buffer: the first element is at Head and
+//  the rest follow it modulo the capacity. The capacity is always a power of
+//  two, so wrapping an index is a mask instead of a division, and both ends
+//  of the buffer are pushed and popped in O(1).
+template<typename Type, typename Allocator = std::allocator<Type>>
+class RingBuffer {
+ public:
+  typedef size_t size_type;
+  typedef Type value_type;
+  typedef Type &reference;
+  typedef const Type &const_reference;
+  typedef Allocator allocator_type;
+
+  RingBuffer() {
+  }
+
+  explicit RingBuffer(const Allocator &alloc) : Alloc(alloc) {
+  }
+
+  RingBuffer(std::initializer_list<value_type> const &items, const Allocator &alloc = Allocator())
+      : Alloc(alloc) {
+    append_range(items);
+  }
+
+  RingBuffer(const RingBuffer &old)
+      : Alloc(AllocatorTraits::select_on_container_copy_construction(old.Alloc)) {
+    CopyFrom(old);
+  }
+
+  RingBuffer(RingBuffer &&old) : Alloc(std::move(old.Alloc)) {
+    SwapStore(old);
+  }
+
+  ~RingBuffer() {
+    ReleaseStore();
+  }
+
+  void push_back(const Type &value);
+
+  void push_back(Type &&value);
+
+  //  constructs one element in place at the back from args
+  template<typename... Args>
+  reference EmplaceBack(Args &&...args);
+
+  //  the store is grown once when the size of the range is known
+  template<typename Range>
+  void append_range(Range &&range);
+
+  void pop_front();
+
+  void pop_back();
+
+  reference front();
+
+  reference back();
+
+  bool empty() const {return Count == 0;}
+
+  size_type size() const {return Count;}
+
+  void reserve(size_type NewCapacity);
+
+  void clear() {DestroyElements();}
+
+  void swap(RingBuffer &other);
+
+  void operator=(RingBuffer &&old);
+
+  //  pos is counted from the first element, not from the start of the store
+  reference operator[](size_type pos) {return Store[(Head + pos) & (Capacity - 1)];}
+
+  allocator_type get_allocator() const {return Alloc;}
+
+ private:
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+
+  //  the smallest store allocated by the first push
+  static constexpr size_type MinCapacity{8};
+
+  Type *Store{nullptr};
+  size_type Head{};
+  size_type Count{};
+  size_type Capacity{};
+  [[no_unique_address]] Allocator Alloc;
+
+  static size_type RoundCapacity(size_type Required);
+
+  //  slow path of EmplaceBack, kept apart so the common case stays small
+  //  enough to be inlined
+  template<typename... Args>
+  reference EmplaceWithGrowth(Args &&...args);
+
+  void Reallocate(size_type NewCapacity);
+
+  void RelocateTo(Type *NewStore, size_type NewCapacity);
+
+  void CopyFrom(const RingBuffer &old);
+
+  void DestroyElements();
+
+  void ReleaseStore();
+
+  void SwapStore(RingBuffer &other);
+};
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::operator=(RingBuffer &&old) {
+  if (this == &old) {
+    return;
+  }
+  ReleaseStore();
+  if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+    Alloc = std::move(old.Alloc);
+    SwapStore(old);
+  } else if (Alloc == old.Alloc) {
+    SwapStore(old);
+  } else {
+    CopyFrom(old);
+  }
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::swap(RingBuffer &other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
+  }
+  SwapStore(other);
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::push_back(const Type &value) {
+  EmplaceBack(value);
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::push_back(Type &&value) {
+  EmplaceBack(std::move(value));
+}
+
+template<typename Type, typename Allocator>
+template<typename... Args>
+inline typename RingBuffer<Type, Allocator>::reference RingBuffer<Type, Allocator>::EmplaceBack(Args &&...args) {
+  if (Count == Capacity) {
+    return EmplaceWithGrowth(std::forward<Args>(args)...);
+  }
+  Type *slot = Store + ((Head + Count) & (Capacity - 1));
+  AllocatorTraits::construct(Alloc, slot, std::forward<Args>(args)...);
+  Count += 1;
+  return *slot;
+}
+
+//  the arguments may refer to an element of the store, so the new element is
+//  constructed in the new store before the old one is released
+template<typename Type, typename Allocator>
+template<typename... Args>
+typename RingBuffer<Type, Allocator>::reference RingBuffer<Type, Allocator>::EmplaceWithGrowth(Args &&...args) {
+  size_type newCapacity{RoundCapacity(Capacity * 2)};
+  Type *newStore = AllocatorTraits::allocate(Alloc, newCapacity);
+  try {
+    AllocatorTraits::construct(Alloc, newStore + Count, std::forward<Args>(args)...);
+  } catch (...) {
+    AllocatorTraits::deallocate(Alloc, newStore, newCapacity);
+    throw;
+  }
+  try {
+    RelocateTo(newStore, newCapacity);
+  } catch (...) {
+    AllocatorTraits::destroy(Alloc, newStore + Count);
+    AllocatorTraits::deallocate(Alloc, newStore, newCapacity);
+    throw;
+  }
+  Count += 1;
+  return Store[Count - 1];
+}
+
+template<typename Type, typename Allocator>
+template<typename Range>
+void RingBuffer<Type, Allocator>::append_range(Range &&range) {
+  if constexpr (std::ranges::sized_range<Range>) {
+    reserve(Count + std::ranges::size(range));
+  }
+  for (auto &&item : range) {
+    EmplaceBack(std::forward<decltype(item)>(item));
+  }
+}
+
+template<typename Type, typename Allocator>
+inline void RingBuffer<Type, Allocator>::pop_front() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  AllocatorTraits::destroy(Alloc, Store + Head);
+  Head = (Head + 1) & (Capacity - 1);
+  Count -= 1;
+}
+
+template<typename Type, typename Allocator>
+inline void RingBuffer<Type, Allocator>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  Count -= 1;
+  AllocatorTraits::destroy(Alloc, Store + ((Head + Count) & (Capacity - 1)));
+}
+
+template<typename Type, typename Allocator>
+typename RingBuffer<Type, Allocator>::reference RingBuffer<Type, Allocator>::front() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  return Store[Head];
+}
+
+template<typename Type, typename Allocator>
+typename RingBuffer<Type, Allocator>::reference RingBuffer<Type, Allocator>::back() {
+  if (empty()) {
+    throw std::out_of_range("No such element");
+  }
+  return (*this)[Count - 1];
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::reserve(size_type NewCapacity) {
+  if (NewCapacity > Capacity) {
+    Reallocate(RoundCapacity(NewCapacity));
+  }
+}
+
+template<typename Type, typename Allocator>
+typename RingBuffer<Type, Allocator>::size_type
+RingBuffer<Type, Allocator>::RoundCapacity(size_type Required) {
+  size_type capacity{MinCapacity};
+  while (capacity < Required) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::Reallocate(size_type NewCapacity) {
+  Type *newStore = AllocatorTraits::allocate(Alloc, NewCapacity);
+  try {
+    RelocateTo(newStore, NewCapacity);
+  } catch (...) {
+    AllocatorTraits::deallocate(Alloc, newStore, NewCapacity);
+    throw;
+  }
+}
+
+//  moves the elements in FIFO order to the start of NewStore and adopts it,
+//  the wrapped buffer is at most two contiguous runs
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::RelocateTo(Type *NewStore, size_type NewCapacity) {
+  size_type count{Count};
+  if constexpr (std::is_trivially_copyable_v<Type>) {
+    if (count != 0) {
+      size_type firstRun{std::min(count, Capacity - Head)};
+      std::memcpy(NewStore, Store + Head, firstRun * sizeof(Type));
+      std::memcpy(NewStore + firstRun, Store, (count - firstRun) * sizeof(Type));
+    }
+  } else {
+    size_type moved{0};
+    try {
+      for (; moved < count; moved++) {
+        AllocatorTraits::construct(Alloc, NewStore + moved,
+                                   std::move_if_noexcept((*this)[moved]));
+      }
+    } catch (...) {
+      while (moved > 0) {
+        AllocatorTraits::destroy(Alloc, NewStore + --moved);
+      }
+      throw;
+    }
+  }
+  ReleaseStore();
+  Store = NewStore;
+  Capacity = NewCapacity;
+  Count = count;
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::CopyFrom(const RingBuffer &old) {
+  if (old.Count == 0) {
+    return;
+  }
+  Reallocate(old.Capacity);
+  for (size_type i{0}; i < old.Count; i++) {
+    push_back(old.Store[(old.Head + i) & (old.Capacity - 1)]);
+  }
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::DestroyElements() {
+  if constexpr (std::is_trivially_destructible_v<Type>) {
+    Count = 0;
+  }
+  while (Count > 0) {
+    pop_front();
+  }
+  Head = 0;
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::ReleaseStore() {
+  DestroyElements();
+  if (Store != nullptr) {
+    AllocatorTraits::deallocate(Alloc, Store, Capacity);
+  }
+  Store = nullptr;
+  Capacity = 0;
+}
+
+template<typename Type, typename Allocator>
+void RingBuffer<Type, Allocator>::SwapStore(RingBuffer &other) {
+  std::swap(Store, other.Store);
+  std::swap(Head, other.Head);
+  std::swap(Count, other.Count);
+  std::swap(Capacity, other.Capacity);
+}
+
+namespace pmr {
+template<typename Type>
+using RingBuffer = s21::RingBuffer<Type, std::pmr::polymorphic_allocator<Type>>;
+}
+}
+
+#endif // MY_RING_BUFFER_H
@@ -1,32 +1,38 @@
 #ifndef S21_SET_H
 #define S21_SET_H
 
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include "my_binary_search_tree.h"
 
-#define BST_Node typename BST<value_type>::Node
+#define BST_Node typename BST<value_type, Compare, Allocator>::Node
 
 namespace s21 {
 
-template <class Key>
-class set : protected BinarySearchTree<Key> {
+template <class Key, class Compare = std::less<>,
+          class Allocator = std::allocator<Key>>
+class set : protected BinarySearchTree<Key, Compare, Allocator> {
  private:
   typedef Key key_type;
   typedef key_type value_type;
   typedef value_type& reference;
   typedef const value_type& const_reference;
   typedef size_t size_type;
+  template <class K>
+  static constexpr bool _Transparent =
+      BinarySearchTree<Key, Compare, Allocator>::template _Transparent<K>;
 
  public:
-  class SetIterator : public BinarySearchTree<Key> {
+  class SetIterator {
    protected:
     BST_Node* _node;
     friend class set;
 
-    BST_Node* _IncreaseIterator(BST_Node* tree, BST_Node* changeNode);
-    BST_Node* _DecreaceIterator(BST_Node*& tree, BST_Node*& changeNode);
-
    public:
     SetIterator() { this->_node = nullptr; }
     ~SetIterator() { this->_node = nullptr; }
@@ -36,14 +42,12 @@ class set : protected BinarySearchTree<Key> {
       }
     }
     value_type operator*() {
-      return this->_node == nullptr ? (value_type)0 : this->_node->_key;
-    }
-    void operator++() {
-      this->_node = _IncreaseIterator(this->_node, this->_node);
-    }
-    void operator--() {
-      this->_node = _DecreaceIterator(this->_node, this->_node);
+      return this->_node == nullptr || set::_IsHeader(this->_node)
+                 ? (value_type)0
+                 : this->_node->_key;
     }
+    void operator++() { this->_node = set::_NextNode(this->_node); }
+    void operator--() { this->_node = set::_PrevNode(this->_node); }
     bool operator==(const SetIterator& other) {
       return this->_node == other._node;
     }
@@ -59,13 +63,46 @@ class set : protected BinarySearchTree<Key> {
   iterator begin();
   iterator end();
 
+  typedef Allocator allocator_type;
+  typedef Compare key_compare;
+
   // Member functions
   set(){};
-  explicit set(std::initializer_list<value_type> const& items) {
+  explicit set(const Allocator& alloc)
+      : BinarySearchTree<Key, Compare, Allocator>(alloc) {}
+  explicit set(const Compare& compare, const Allocator& alloc = Allocator())
+      : BinarySearchTree<Key, Compare, Allocator>(compare, alloc) {}
+  explicit set(std::initializer_list<value_type> const& items,
+               const Allocator& alloc = Allocator())
+      : BinarySearchTree<Key, Compare, Allocator>(alloc) {
     for (auto& item : items) {
       this->insert(item);
     }
   }
+  // sorts the keys once and builds a balanced tree from them, the first of
+  // equal keys is kept
+  template <std::input_iterator InputIterator>
+  set(InputIterator first, InputIterator last,
+      const Allocator& alloc = Allocator())
+      : BinarySearchTree<Key, Compare, Allocator>(alloc) {
+    this->_BuildTree(first, last, false, true);
+  }
+  template <std::input_iterator InputIterator>
+  set(InputIterator first, InputIterator last, const Compare& compare,
+      const Allocator& alloc = Allocator())
+      : BinarySearchTree<Key, Compare, Allocator>(compare, alloc) {
+    this->_BuildTree(first, last, false, true);
+  }
+  // the same for keys that are already sorted by Compare, in O(n)
+  template <std::input_iterator InputIterator>
+  static set from_sorted(InputIterator first, InputIterator last,
+                         const Allocator& alloc = Allocator()) {
+    return from_sorted(first, last, Compare(), alloc);
+  }
+  template <std::input_iterator InputIterator>
+  static set from_sorted(InputIterator first, InputIterator last,
+                         const Compare& compare,
+                         const Allocator& alloc = Allocator());
   set(const set& s);
   set(set&& s);
   ~set(){};
@@ -82,138 +119,142 @@ class set : protected BinarySearchTree<Key> {
   bool empty();
   size_type size();
   size_type max_size();
+  allocator_type get_allocator() {
+    return allocator_type(this->_nodePool.get_allocator());
+  }
+  key_compare key_comp() { return this->_compare; }
 
   // Lookup
-  iterator find(const Key& key);
-  bool contains(const Key& key);
+  iterator find(const Key& key) { return _Find(key); }
+  bool contains(const Key& key) { return _Find(key) != end(); }
+  size_type count(const Key& key) { return contains(key) ? 1 : 0; }
+  iterator lower_bound(const Key& key) { return _LowerBound(key); }
+  // the same for a key of another type that compares with Key, without
+  // building a Key from it
+  template <class K>
+    requires _Transparent<K>
+  iterator find(const K& key) {
+    return _Find(key);
+  }
+  template <class K>
+    requires _Transparent<K>
+  bool contains(const K& key) {
+    return _Find(key) != end();
+  }
+  template <class K>
+    requires _Transparent<K>
+  size_type count(const K& key) {
+    return contains(key) ? 1 : 0;
+  }
+  template <class K>
+    requires _Transparent<K>
+  iterator lower_bound(const K& key) {
+    return _LowerBound(key);
+  }
 
   // Emplace
   template <class... Args>
   std::vector<std::pair<iterator, bool>> emplace(Args&&... args);
   std::vector<std::pair<iterator, bool>> emplace();
 
+ private:
+  template <class K>
+  iterator _Find(const K& key);
+  template <class K>
+  iterator _LowerBound(const K& key);
 };  // set
 
+namespace pmr {
+template <class Key, class Compare = std::less<>>
+using set = s21::set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 // Member functions
 // -----------------------------------------------------------------------------
-template <class value_type>
-s21::set<value_type>::set(const set& s) {
-  SetIterator it;
-  it._node = s._root;
-  it._node = BST<value_type>::_MinimalNode(it._node);
-  while (it._node != nullptr) {
-    this->insert(*it);
-    ++it;
+template <class value_type, class Compare, class Allocator>
+s21::set<value_type, Compare, Allocator>::set(const set& s)
+    : BST<value_type, Compare, Allocator>(
+          s._compare,
+          Allocator(BST<value_type, Compare, Allocator>::NodeTraits::
+                        select_on_container_copy_construction(
+                            s._nodePool.get_allocator()))) {
+  for (BST_Node* node = s._header._left; node != &s._header;
+       node = this->_NextNode(node)) {
+    this->_InsertInTree(node->_key);
   }
 }
 
-template <class value_type>
-s21::set<value_type>::set(set&& s) {
-  if (this->_root != s._root) {
-    std::swap(this->_root, s._root);
-  }
+template <class value_type, class Compare, class Allocator>
+template <std::input_iterator InputIterator>
+s21::set<value_type, Compare, Allocator>
+s21::set<value_type, Compare, Allocator>::from_sorted(InputIterator first,
+                                                      InputIterator last,
+                                                      const Compare& compare,
+                                                      const Allocator& alloc) {
+  set result(compare, alloc);
+  result._BuildTree(first, last, true, true);
+  return result;
 }
 
-template <class value_type>
-void s21::set<value_type>::operator=(set&& s) {
-  if (this->_root != s._root) {
-    std::swap(this->_root, s._root);
+template <class value_type, class Compare, class Allocator>
+s21::set<value_type, Compare, Allocator>::set(set&& s)
+    : BST<value_type, Compare, Allocator>(
+          Allocator(s._nodePool.get_allocator())) {
+  this->_SwapTree(s);
+}
+
+template <class value_type, class Compare, class Allocator>
+void s21::set<value_type, Compare, Allocator>::operator=(set&& s) {
+  if (this != &s) {
+    if (this->_nodePool.get_allocator() == s._nodePool.get_allocator()) {
+      this->_SwapTree(s);
+    } else {
+      this->clear();
+      this->_compare = s._compare;
+      this->merge(s);
+    }
   }
 }
 // -----------------------------------------------------------------------------
 
 // Iterator
 // -----------------------------------------------------------------------------
-template <class value_type>
-typename s21::set<value_type>::iterator s21::set<value_type>::begin() {
+template <class value_type, class Compare, class Allocator>
+typename s21::set<value_type, Compare, Allocator>::iterator
+s21::set<value_type, Compare, Allocator>::begin() {
   SetIterator returnIterator;
-  if (!this->empty()) {
-    BST_Node* tempNode = BST<value_type>::_MinimalNode(this->_root);
-    returnIterator._node = tempNode;
-  } else {
-    returnIterator._node = this->_root;
-  }
+  returnIterator._node = this->_header._left;
   return returnIterator;
 }
 
-template <class value_type>
-typename s21::set<value_type>::iterator s21::set<value_type>::end() {
+template <class value_type, class Compare, class Allocator>
+typename s21::set<value_type, Compare, Allocator>::iterator
+s21::set<value_type, Compare, Allocator>::end() {
   SetIterator returnIterator;
-  if (!this->empty()) {
-    BST_Node* tempNode = BST<value_type>::_MaximalNode(this->_root)->_right;
-    returnIterator._node = tempNode;
-  } else {
-    returnIterator._node = this->_root;
-  }
+  returnIterator._node = this->_Header();
   return returnIterator;
 }
 // -----------------------------------------------------------------------------
 
-template <class value_type>
-typename s21::BST<value_type>::Node*
-s21::set<value_type>::iterator::_IncreaseIterator(BST_Node* tree,
-                                                  BST_Node* changeNode) {
-  if (tree->_right != nullptr && tree->_right != changeNode) {
-    return BinarySearchTree<value_type>::_MinNodeWithOut(tree->_right,
-                                                         changeNode);
-  }
-  if (changeNode->_parent == tree) {
-    return changeNode;
-  }
-  BST_Node* tempNode = tree->_parent;
-  while (tempNode != changeNode && tempNode && tree == tempNode->_right) {
-    tree = tempNode;
-    tempNode = tempNode->_parent;
-  }
-  return tempNode;
-}
-
-template <class value_type>
-typename s21::BST<value_type>::Node*
-s21::set<value_type>::iterator::_DecreaceIterator(BST_Node*& tree,
-                                                  BST_Node*& changeNode) {
-  if (tree->_left != nullptr && tree->_left != changeNode) {
-    return BST<value_type>::_MaxNodeWithOut(tree->_left, changeNode);
-  }
-  BST_Node* tempNode = tree->_parent;
-  while (tempNode != changeNode && tree == tempNode->_left) {
-    tree = tempNode;
-    tempNode = tempNode->_parent;
-    if (tempNode == nullptr) {
-      return changeNode;
-    }
-  }
-  return tempNode;
-}
-
 // Modifiers
 // -----------------------------------------------------------------------------
-template <class value_type>
-void s21::set<value_type>::clear() {
-  if (this->_root != nullptr) {
-    BST<value_type>::_DeleteAllTree(this->_root);
-  }
+template <class value_type, class Compare, class Allocator>
+void s21::set<value_type, Compare, Allocator>::clear() {
+  this->_Clear();
 }
 
-template <class value_type>
-std::pair<typename s21::set<value_type>::iterator, bool>
-s21::set<value_type>::insert(const value_type& value) {
+template <class value_type, class Compare, class Allocator>
+std::pair<typename s21::set<value_type, Compare, Allocator>::iterator, bool>
+s21::set<value_type, Compare, Allocator>::insert(const value_type& value) {
   std::pair<iterator, bool> returnPair;
-  BST_Node* tempNode = BST<value_type>::_FindNode(this->_root, value);
-  if (tempNode == nullptr) {
-    BST<value_type>::_InsertInTree(value);
-    tempNode = BST<value_type>::_FindNode(this->_root, value);
-    if (tempNode != nullptr) {
-      returnPair.second = true;
-      SetIterator tempIterator;
-      tempIterator._node = tempNode;
-      returnPair.first = tempIterator;
-    } else {
-      returnPair.second = false;
-      returnPair.first = this->end();
-    }
+  std::pair<BST_Node*, bool> inserted = this->_InsertUniqueInTree(value);
+  if (inserted.second) {
+    SetIterator tempIterator;
+    tempIterator._node = inserted.first;
+    returnPair.first = tempIterator;
+    returnPair.second = true;
   } else {
     returnPair.first = this->end();
     returnPair.second = false;
@@ -221,23 +262,24 @@ s21::set<value_type>::insert(const value_type& value) {
   return returnPair;
 }
 
-template <class value_type>
-void s21::set<value_type>::erase(iterator& pos) {
-  if (pos._node != nullptr) {
-    BST<value_type>::_DeleteNode(this->_root, pos._node->_key);
+template <class value_type, class Compare, class Allocator>
+void s21::set<value_type, Compare, Allocator>::erase(iterator& pos) {
+  if (pos._node != nullptr && !this->_IsHeader(pos._node)) {
+    this->_EraseNode(pos._node);
   }
 }
 
-template <class value_type>
-void s21::set<value_type>::swap(set& other) {
-  if (this->_root != other._root) {
-    std::swap(this->_root, other._root);
+template <class value_type, class Compare, class Allocator>
+void s21::set<value_type, Compare, Allocator>::swap(set& other) {
+  if (this != &other) {
+    // the pools swap their allocators when the allocator propagates
+    this->_SwapTree(other);
   }
 }
 
-template <class value_type>
-void s21::set<value_type>::merge(set& other) {
-  if (this->_root != other._root) {
+template <class value_type, class Compare, class Allocator>
+void s21::set<value_type, Compare, Allocator>::merge(set& other) {
+  if (this != &other) {
     for (iterator it = other.begin(); it != other.end(); ++it) {
       this->insert(*it);
     }
@@ -248,50 +290,54 @@ void s21::set<value_type>::merge(set& other) {
 
 // Lookup
 // -----------------------------------------------------------------------------
-template <class value_type>
-typename s21::set<value_type>::iterator s21::set<value_type>::find(
-    const value_type& key) {
+template <class value_type, class Compare, class Allocator>
+template <class K>
+typename s21::set<value_type, Compare, Allocator>::iterator
+s21::set<value_type, Compare, Allocator>::_Find(const K& key) {
   SetIterator returnIterator;
-  returnIterator._node = BST<value_type>::_FindNode(this->_root, key);
+  returnIterator._node = this->_FindNode(this->_Root(), key);
   if (returnIterator._node == nullptr) {
     returnIterator = this->end();
   }
   return returnIterator;
 }
 
-template <class value_type>
-bool s21::set<value_type>::contains(const value_type& key) {
-  return this->find(key) != this->end() ? true : false;
+template <class value_type, class Compare, class Allocator>
+template <class K>
+typename s21::set<value_type, Compare, Allocator>::iterator
+s21::set<value_type, Compare, Allocator>::_LowerBound(const K& key) {
+  SetIterator iter;
+  iter._node = this->_LowerBoundNode(key);
+  return iter;
 }
 // -----------------------------------------------------------------------------
 
 // Capacity
 // -----------------------------------------------------------------------------
-template <class value_type>
-bool s21::set<value_type>::empty() {
-  return this->_root == nullptr ? true : false;
+template <class value_type, class Compare, class Allocator>
+bool s21::set<value_type, Compare, Allocator>::empty() {
+  return this->_size == 0 ? true : false;
 }
 
-template <class value_type>
-typename s21::set<value_type>::size_type s21::set<value_type>::size() {
-  size_type currentSize = 0;
-  for (iterator it = this->begin(); it != this->end(); ++it) {
-    currentSize++;
-  }
-  return currentSize;
+template <class value_type, class Compare, class Allocator>
+typename s21::set<value_type, Compare, Allocator>::size_type
+s21::set<value_type, Compare, Allocator>::size() {
+  return this->_size;
 }
 
-template <class value_type>
-typename s21::set<value_type>::size_type s21::set<value_type>::max_size() {
-  return size_type(-1) / sizeof(*this);
+template <class value_type, class Compare, class Allocator>
+typename s21::set<value_type, Compare, Allocator>::size_type
+s21::set<value_type, Compare, Allocator>::max_size() {
+  return size_type(-1) / sizeof(BST_Node*);
 }
 // -----------------------------------------------------------------------------
 
 // Emplace
-template <class value_type>
+template <class value_type, class Compare, class Allocator>
 template <class... Args>
-std::vector<std::pair<typename s21::set<value_type>::iterator, bool>>
-s21::set<value_type>::emplace(Args&&... args) {
+std::vector<std::pair<
+    typename s21::set<value_type, Compare, Allocator>::iterator, bool>>
+s21::set<value_type, Compare, Allocator>::emplace(Args&&... args) {
   std::vector<std::pair<iterator, bool>> resultVector;
   std::vector<value_type> itemVector = {args...};
   for (auto& items : itemVector) {
@@ -301,9 +347,10 @@ s21::set<value_type>::emplace(Args&&... args) {
   return resultVector;
 }
 
-template <class value_type>
-std::vector<std::pair<typename s21::set<value_type>::iterator, bool>>
-s21::set<value_type>::emplace() {
+template <class value_type, class Compare, class Allocator>
+std::vector<std::pair<
+    typename s21::set<value_type, Compare, Allocator>::iterator, bool>>
+s21::set<value_type, Compare, Allocator>::emplace() {
   std::vector<std::pair<iterator, bool>> resultVector;
   resultVector.push_back(std::make_pair(this->end(), false));
   return resultVector;
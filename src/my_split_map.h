@@ -0,0 +1,668 @@
+#ifndef MY_SPLIT_MAP_H
+#define MY_SPLIT_MAP_H
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+//  Iterator over a SplitMap, a pair of pointers walked in step. There is no
+//  pair in memory to point to, so dereferencing yields a pair of references
+//  to the key and the value, and operator-> wraps that pair.
+template<typename Key, typename T>
+class SplitMapIterator {
+ public:
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef std::pair<Key, T> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef std::pair<const Key &, T &> reference;
+
+  struct pointer {
+    reference Pair;
+
+    const reference *operator->() const {return &Pair;}
+  };
+
+  SplitMapIterator() {}
+
+  SplitMapIterator(Key *InitKey, T *InitValue) : KeyPointer(InitKey), ValuePointer(InitValue) {}
+
+  reference operator*() const {return reference(*KeyPointer, *ValuePointer);}
+
+  pointer operator->() const {return pointer{**this};}
+
+  reference operator[](difference_type offset) const {return *(*this + offset);}
+
+  SplitMapIterator &operator++() {
+    ++KeyPointer;
+    ++ValuePointer;
+    return *this;
+  }
+
+  SplitMapIterator operator++(int) {
+    SplitMapIterator previous{*this};
+    ++*this;
+    return previous;
+  }
+
+  SplitMapIterator &operator--() {
+    --KeyPointer;
+    --ValuePointer;
+    return *this;
+  }
+
+  SplitMapIterator operator--(int) {
+    SplitMapIterator previous{*this};
+    --*this;
+    return previous;
+  }
+
+  SplitMapIterator &operator+=(difference_type offset) {
+    KeyPointer += offset;
+    ValuePointer += offset;
+    return *this;
+  }
+
+  SplitMapIterator &operator-=(difference_type offset) {
+    return *this += -offset;
+  }
+
+  SplitMapIterator operator+(difference_type offset) const {
+    return SplitMapIterator(KeyPointer + offset, ValuePointer + offset);
+  }
+
+  friend SplitMapIterator operator+(difference_type offset, const SplitMapIterator &iter) {
+    return iter + offset;
+  }
+
+  SplitMapIterator operator-(difference_type offset) const {
+    return *this + -offset;
+  }
+
+  difference_type operator-(const SplitMapIterator &other) const {
+    return KeyPointer - other.KeyPointer;
+  }
+
+  bool operator==(const SplitMapIterator &other) const {return KeyPointer == other.KeyPointer;}
+
+  std::strong_ordering operator<=>(const SplitMapIterator &other) const {
+    return KeyPointer <=> other.KeyPointer;
+  }
+
+ private:
+  Key *KeyPointer{nullptr};
+  T *ValuePointer{nullptr};
+};
+
+//  Sorted map with the layout of Map split in two: the keys in one array and
+//  the values in another at the same positions. A binary search then reads
+//  only the dense key array, so with small keys and large values each probe
+//  costs a fraction of a cache line instead of a whole pair, and the value
+//  is only touched when the key is found. The interface is the one of Map,
+//  except that iterators yield a pair of references instead of a reference
+//  to a pair.
+//
+//  Each array is shifted with memmove when its own type is trivially
+//  copyable, so a large trivially copyable value does not make the keys pay
+//  for element-wise moves or the other way round.
+template<typename Key, typename T, typename Compare = std::less<>,
+         typename Allocator = std::allocator<std::pair<Key, T>>>
+class SplitMap {
+  //  as in Map, a K that a transparent Compare orders against Key is
+  //  compared with the keys as it is instead of being converted
+  template<typename K>
+  static constexpr bool Transparent{!std::is_same_v<K, Key> &&
+                                    requires(const Compare &comp, const Key &key, const K &other) {
+    typename Compare::is_transparent;
+    {comp(key, other)} -> std::convertible_to<bool>;
+    {comp(other, key)} -> std::convertible_to<bool>;
+  }};
+
+ public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<key_type, mapped_type> value_type;
+  typedef std::pair<const key_type &, mapped_type &> reference;
+  typedef size_t size_type;
+  typedef SplitMapIterator<Key, T> iterator;
+  typedef std::pair<iterator, bool> isInserted;
+  typedef std::pair<size_type, bool> isFound;
+  typedef Allocator allocator_type;
+  typedef Compare key_compare;
+
+  SplitMap() {}
+
+  explicit SplitMap(const Allocator &alloc) : Alloc(alloc) {}
+
+  explicit SplitMap(const Compare &comp, const Allocator &alloc = Allocator()) : Comp(comp), Alloc(alloc) {}
+
+  SplitMap(std::initializer_list<value_type> const &items, const Allocator &alloc = Allocator())
+      : Alloc(alloc) {
+    reserve(items.size());
+    for (auto iter{items.begin()}; iter != items.end(); iter++) {
+      insert(*iter);
+    }
+  }
+
+  //  sorts the pairs by key once, the first of equal keys is kept
+  template<std::input_iterator InputIterator>
+  SplitMap(InputIterator first, InputIterator last, const Allocator &alloc = Allocator()) : Alloc(alloc) {
+    Build(first, last, false);
+  }
+
+  template<std::input_iterator InputIterator>
+  SplitMap(InputIterator first, InputIterator last, const Compare &comp, const Allocator &alloc = Allocator())
+      : Comp(comp), Alloc(alloc) {
+    Build(first, last, false);
+  }
+
+  //  the same for pairs already sorted by key, in O(n)
+  template<std::input_iterator InputIterator>
+  static SplitMap from_sorted(InputIterator first, InputIterator last, const Allocator &alloc = Allocator()) {
+    return from_sorted(first, last, Compare(), alloc);
+  }
+
+  template<std::input_iterator InputIterator>
+  static SplitMap from_sorted(InputIterator first, InputIterator last, const Compare &comp,
+                              const Allocator &alloc = Allocator());
+
+  SplitMap(const SplitMap &other)
+      : SplitMap(other, AllocatorTraits::select_on_container_copy_construction(other.Alloc)) {}
+
+  SplitMap(const SplitMap &other, const Allocator &alloc) : Comp(other.Comp), Alloc(alloc) {
+    try {
+      reserve(other.MapMaxSize);
+      for (size_type i{0}; i < other.MapSize; i++) {
+        Append(other.Keys[i], other.Values[i]);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  SplitMap(SplitMap &&other) : Comp(other.Comp), Alloc(std::move(other.Alloc)) {SwapStore(other);}
+
+  ~SplitMap() {clear();}
+
+  void operator=(SplitMap &&other);
+
+  isInserted insert(const value_type& value) {return insert(value.first, value.second);}
+
+  isInserted insert(const Key& key, const T& obj);
+
+  isInserted insert_or_assign(const value_type& value);
+
+  void clear();
+
+  void erase(iterator position);
+
+  void swap(SplitMap& other);
+
+  void merge(SplitMap& other);
+
+  void reserve(size_type NewSize);
+
+  bool empty() {return MapSize == 0;}
+
+  size_type size() {return MapSize;}
+
+  size_type max_size() {return MapMaxSize;}
+
+  iterator begin() {return iterator(Keys, Values);}
+
+  iterator end() {return iterator(Keys + MapSize, Values + MapSize);}
+
+  allocator_type get_allocator() {return Alloc;}
+
+  key_compare key_comp() {return Comp;}
+
+  bool contains(const key_type& key) {return FindPosition(key).second;}
+
+  template<typename K>
+  requires Transparent<K>
+  bool contains(const K& key) {return FindPosition(key).second;}
+
+  size_type count(const key_type& key) {return contains(key) ? 1 : 0;}
+
+  template<typename K>
+  requires Transparent<K>
+  size_type count(const K& key) {return contains(key) ? 1 : 0;}
+
+  iterator find(const key_type& key) {return IteratorAt(FindPosition(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator find(const K& key) {return IteratorAt(FindPosition(key));}
+
+  //  the first element whose key is not less than key
+  iterator lower_bound(const key_type& key) {return begin() + FindPosition(key).first;}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator lower_bound(const K& key) {return begin() + FindPosition(key).first;}
+
+  //  the position of key, or where it would be inserted when it is absent
+  isFound FindPosition(const key_type& key) {return SortedPosition(key);}
+
+  template<typename K>
+  requires Transparent<K>
+  isFound FindPosition(const K& key) {return SortedPosition(key);}
+
+  mapped_type& at(const key_type& key) {return AtPosition(FindPosition(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  mapped_type& at(const K& key) {return AtPosition(FindPosition(key));}
+
+  //  inserts a value-initialized element when key is absent
+  mapped_type& operator[](const key_type& key);
+
+ private:
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<Key> KeyAllocator;
+  typedef std::allocator_traits<KeyAllocator> KeyTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<T> ValueAllocator;
+  typedef std::allocator_traits<ValueAllocator> ValueTraits;
+
+  //  a reallocation moves both arrays only when neither move can throw,
+  //  otherwise it copies them, so a failure half way leaves the old arrays
+  //  as they were
+  static constexpr bool NothrowRelocate{std::is_nothrow_move_constructible_v<Key> &&
+                                        std::is_nothrow_move_constructible_v<T>};
+
+  size_type MapSize{};
+  size_type MapMaxSize{};
+  //  both arrays have MapMaxSize slots, only the first MapSize are live
+  Key *Keys{nullptr};
+  T *Values{nullptr};
+  [[no_unique_address]] Compare Comp;
+  [[no_unique_address]] Allocator Alloc;
+
+  void SwapStore(SplitMap &other);
+
+  void ReplaceStore(Key *NewKeys, T *NewValues, size_type NewMaxSize);
+
+  template<typename K>
+  isFound SortedPosition(const K& key);
+
+  iterator IteratorAt(isFound found) {return found.second ? begin() + found.first : end();}
+
+  mapped_type& AtPosition(isFound found);
+
+  size_type NextCapacity(size_type MinimalSize) {
+    return MapMaxSize * 2 < MinimalSize ? MinimalSize : MapMaxSize * 2;
+  }
+
+  //  key and value are built before anything moves, so they may refer to an
+  //  element of the map
+  template<typename... Args>
+  void InsertAt(size_type Position, const Key &key, Args &&...args);
+
+  //  puts the pair after the last element, growing the arrays when full
+  template<typename KeyArg, typename ValueArg>
+  void Append(KeyArg &&key, ValueArg &&value);
+
+  template<typename InputIterator>
+  void Build(InputIterator first, InputIterator last, bool sorted);
+
+  //  Helpers on one of the two arrays, alloc is rebound to its type.
+
+  template<typename Type, typename TypeAllocator>
+  static void RelocateInto(TypeAllocator &alloc, Type *from, size_type count, Type *to);
+
+  template<typename Type, typename TypeAllocator>
+  static void DestroyRange(TypeAllocator &alloc, Type *first, size_type count);
+
+  //  the count elements from Position move up by one slot and inserted is
+  //  moved into the gap
+  template<typename Type, typename TypeAllocator>
+  static void ShiftUp(TypeAllocator &alloc, Type *array, size_type count, size_type Position, Type &inserted);
+
+  //  the element at Position is dropped and the ones after it move down
+  template<typename Type, typename TypeAllocator>
+  static void ShiftDown(TypeAllocator &alloc, Type *array, size_type count, size_type Position);
+};
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename Type, typename TypeAllocator>
+void SplitMap<Key, T, Compare, Allocator>::RelocateInto(TypeAllocator &alloc, Type *from, size_type count, Type *to) {
+  typedef std::allocator_traits<TypeAllocator> TypeTraits;
+  if constexpr (std::is_trivially_copyable_v<Type>) {
+    if (count != 0) {
+      std::memcpy(static_cast<void *>(to), from, count * sizeof(Type));
+    }
+  } else {
+    size_type i{0};
+    try {
+      for (; i < count; i++) {
+        if constexpr (NothrowRelocate || !std::is_copy_constructible_v<Type>) {
+          TypeTraits::construct(alloc, to + i, std::move(from[i]));
+        } else {
+          TypeTraits::construct(alloc, to + i, std::as_const(from[i]));
+        }
+      }
+    } catch (...) {
+      DestroyRange(alloc, to, i);
+      throw;
+    }
+  }
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename Type, typename TypeAllocator>
+void SplitMap<Key, T, Compare, Allocator>::DestroyRange(TypeAllocator &alloc, Type *first, size_type count) {
+  if constexpr (!std::is_trivially_destructible_v<Type>) {
+    for (size_type i{0}; i < count; i++) {
+      std::allocator_traits<TypeAllocator>::destroy(alloc, first + i);
+    }
+  }
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename Type, typename TypeAllocator>
+inline void SplitMap<Key, T, Compare, Allocator>::ShiftUp(TypeAllocator &alloc, Type *array, size_type count,
+                                                 size_type Position, Type &inserted) {
+  typedef std::allocator_traits<TypeAllocator> TypeTraits;
+  if (Position == count) {
+    TypeTraits::construct(alloc, array + count, std::move(inserted));
+  } else if constexpr (std::is_trivially_copyable_v<Type>) {
+    std::memmove(static_cast<void *>(array + Position + 1), array + Position, (count - Position) * sizeof(Type));
+    TypeTraits::construct(alloc, array + Position, inserted);
+  } else {
+    TypeTraits::construct(alloc, array + count, std::move(array[count - 1]));
+    std::move_backward(array + Position, array + count - 1, array + count);
+    array[Position] = std::move(inserted);
+  }
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename Type, typename TypeAllocator>
+inline void SplitMap<Key, T, Compare, Allocator>::ShiftDown(TypeAllocator &alloc, Type *array, size_type count,
+                                                   size_type Position) {
+  typedef std::allocator_traits<TypeAllocator> TypeTraits;
+  if constexpr (std::is_trivially_copyable_v<Type>) {
+    TypeTraits::destroy(alloc, array + Position);
+    std::memmove(static_cast<void *>(array + Position), array + Position + 1,
+                 (count - Position - 1) * sizeof(Type));
+  } else {
+    std::move(array + Position + 1, array + count, array + Position);
+    TypeTraits::destroy(alloc, array + count - 1);
+  }
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::SwapStore(SplitMap &other) {
+  std::swap(Keys, other.Keys);
+  std::swap(Values, other.Values);
+  std::swap(MapSize, other.MapSize);
+  std::swap(MapMaxSize, other.MapMaxSize);
+  std::swap(Comp, other.Comp);
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::ReplaceStore(Key *NewKeys, T *NewValues, size_type NewMaxSize) {
+  if (MapMaxSize != 0) {
+    KeyAllocator keyAlloc(Alloc);
+    ValueAllocator valueAlloc(Alloc);
+    KeyTraits::deallocate(keyAlloc, Keys, MapMaxSize);
+    ValueTraits::deallocate(valueAlloc, Values, MapMaxSize);
+  }
+  Keys = NewKeys;
+  Values = NewValues;
+  MapMaxSize = NewMaxSize;
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::reserve(size_type NewSize) {
+  if (NewSize > MapMaxSize) {
+    KeyAllocator keyAlloc(Alloc);
+    ValueAllocator valueAlloc(Alloc);
+    Key *NewKeys = KeyTraits::allocate(keyAlloc, NewSize);
+    T *NewValues{nullptr};
+    try {
+      NewValues = ValueTraits::allocate(valueAlloc, NewSize);
+      RelocateInto(keyAlloc, Keys, MapSize, NewKeys);
+      try {
+        RelocateInto(valueAlloc, Values, MapSize, NewValues);
+      } catch (...) {
+        DestroyRange(keyAlloc, NewKeys, MapSize);
+        throw;
+      }
+    } catch (...) {
+      if (NewValues != nullptr) {
+        ValueTraits::deallocate(valueAlloc, NewValues, NewSize);
+      }
+      KeyTraits::deallocate(keyAlloc, NewKeys, NewSize);
+      throw;
+    }
+    DestroyRange(keyAlloc, Keys, MapSize);
+    DestroyRange(valueAlloc, Values, MapSize);
+    ReplaceStore(NewKeys, NewValues, NewSize);
+  }
+}
+
+//  The values are shifted first. When shifting the keys throws the new value
+//  is taken out again, so the two arrays never disagree.
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename... Args>
+inline void SplitMap<Key, T, Compare, Allocator>::InsertAt(size_type Position, const Key &key, Args &&...args) {
+  Key InsertedKey(key);
+  T InsertedValue(std::forward<Args>(args)...);
+  if (MapSize == MapMaxSize) {
+    reserve(NextCapacity(MapSize + 1));
+  }
+  KeyAllocator keyAlloc(Alloc);
+  ValueAllocator valueAlloc(Alloc);
+  ShiftUp(valueAlloc, Values, MapSize, Position, InsertedValue);
+  try {
+    ShiftUp(keyAlloc, Keys, MapSize, Position, InsertedKey);
+  } catch (...) {
+    ShiftDown(valueAlloc, Values, MapSize + 1, Position);
+    throw;
+  }
+  MapSize += 1;
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename KeyArg, typename ValueArg>
+void SplitMap<Key, T, Compare, Allocator>::Append(KeyArg &&key, ValueArg &&value) {
+  if (MapSize == MapMaxSize) {
+    reserve(NextCapacity(MapSize + 1));
+  }
+  KeyAllocator keyAlloc(Alloc);
+  ValueAllocator valueAlloc(Alloc);
+  KeyTraits::construct(keyAlloc, Keys + MapSize, std::forward<KeyArg>(key));
+  try {
+    ValueTraits::construct(valueAlloc, Values + MapSize, std::forward<ValueArg>(value));
+  } catch (...) {
+    KeyTraits::destroy(keyAlloc, Keys + MapSize);
+    throw;
+  }
+  MapSize += 1;
+}
+
+//  Two parallel arrays cannot be sorted together, so unsorted input is first
+//  collected and sorted as pairs. The sorted pairs are then appended, each
+//  one only when its key is greater than the last, which keeps the first of
+//  equal keys.
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename InputIterator>
+void SplitMap<Key, T, Compare, Allocator>::Build(InputIterator first, InputIterator last, bool sorted) {
+  if (!sorted) {
+    std::vector<value_type, Allocator> pairs(first, last, Alloc);
+    std::stable_sort(pairs.begin(), pairs.end(), [this](const value_type &left, const value_type &right) {
+      return Comp(left.first, right.first);
+    });
+    Build(std::make_move_iterator(pairs.begin()), std::make_move_iterator(pairs.end()), true);
+    return;
+  }
+  try {
+    if constexpr (std::forward_iterator<InputIterator>) {
+      reserve(static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      auto &&pair = *first;
+      if (MapSize == 0 || Comp(Keys[MapSize - 1], pair.first)) {
+        Append(std::forward<decltype(pair)>(pair).first, std::forward<decltype(pair)>(pair).second);
+      }
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<std::input_iterator InputIterator>
+SplitMap<Key, T, Compare, Allocator>
+SplitMap<Key, T, Compare, Allocator>::from_sorted(InputIterator first, InputIterator last, const Compare &comp,
+                                                  const Allocator &alloc) {
+  SplitMap result(comp, alloc);
+  result.Build(first, last, true);
+  return result;
+}
+
+//  both maps are sorted and are merged in one pass, a key present in both
+//  keeps the value of this map
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::merge(SplitMap& other) {
+  if (other.MapSize != 0) {
+    SplitMap merged(Comp, Alloc);
+    merged.reserve(MapSize + other.MapSize);
+    size_type mine{0}, theirs{0};
+    while (mine < MapSize || theirs < other.MapSize) {
+      if (theirs == other.MapSize || (mine < MapSize && Comp(Keys[mine], other.Keys[theirs]))) {
+        merged.Append(std::move_if_noexcept(Keys[mine]), std::move_if_noexcept(Values[mine]));
+        mine++;
+      } else if (mine == MapSize || Comp(other.Keys[theirs], Keys[mine])) {
+        merged.Append(std::as_const(other.Keys[theirs]), std::as_const(other.Values[theirs]));
+        theirs++;
+      } else {
+        merged.Append(std::move_if_noexcept(Keys[mine]), std::move_if_noexcept(Values[mine]));
+        mine++;
+        theirs++;
+      }
+    }
+    SwapStore(merged);
+  }
+  other.clear();
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::swap(SplitMap& other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
+  }
+  SwapStore(other);
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::erase(iterator position) {
+  size_type Position = position - begin();
+  KeyAllocator keyAlloc(Alloc);
+  ValueAllocator valueAlloc(Alloc);
+  ShiftDown(keyAlloc, Keys, MapSize, Position);
+  ShiftDown(valueAlloc, Values, MapSize, Position);
+  MapSize -= 1;
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::clear() {
+  KeyAllocator keyAlloc(Alloc);
+  ValueAllocator valueAlloc(Alloc);
+  DestroyRange(keyAlloc, Keys, MapSize);
+  DestroyRange(valueAlloc, Values, MapSize);
+  MapSize = 0;
+  ReplaceStore(nullptr, nullptr, 0);
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+void SplitMap<Key, T, Compare, Allocator>::operator=(SplitMap &&other) {
+  if (this != &other) {
+    clear();
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+      Alloc = std::move(other.Alloc);
+      SwapStore(other);
+    } else if (Alloc == other.Alloc) {
+      SwapStore(other);
+    } else {
+      Comp = other.Comp;
+      merge(other);
+    }
+  }
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename SplitMap<Key, T, Compare, Allocator>::isInserted SplitMap<Key, T, Compare, Allocator>::insert(const Key& key, const T& obj) {
+  isFound found = FindPosition(key);
+  if (!found.second) {
+    InsertAt(found.first, key, obj);
+  }
+  return std::make_pair(begin() + found.first, !found.second);
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename SplitMap<Key, T, Compare, Allocator>::isInserted
+SplitMap<Key, T, Compare, Allocator>::insert_or_assign(const value_type& value) {
+  isFound found = FindPosition(value.first);
+  if (found.second) {
+    Values[found.first] = value.second;
+  } else {
+    InsertAt(found.first, value.first, value.second);
+  }
+  return std::make_pair(begin() + found.first, true);
+}
+
+//  lower bound on the keys, the values are not touched
+template<typename Key, typename T, typename Compare, typename Allocator>
+template<typename K>
+inline typename SplitMap<Key, T, Compare, Allocator>::isFound SplitMap<Key, T, Compare, Allocator>::SortedPosition(const K& key) {
+  size_type left{0}, count{MapSize};
+  while (count != 0) {
+    size_type half = count / 2;
+    if (Comp(Keys[left + half], key)) {
+      left += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  return std::make_pair(left, left < MapSize && !Comp(key, Keys[left]));
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename SplitMap<Key, T, Compare, Allocator>::mapped_type& SplitMap<Key, T, Compare, Allocator>::AtPosition(isFound result) {
+  if (!result.second) {
+    throw std::out_of_range("No such element");
+  }
+  return Values[result.first];
+}
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+typename SplitMap<Key, T, Compare, Allocator>::mapped_type& SplitMap<Key, T, Compare, Allocator>::operator[](const key_type& key) {
+  isFound result = FindPosition(key);
+  if (!result.second) {
+    InsertAt(result.first, key);
+  }
+  return Values[result.first];
+}
+
+namespace pmr {
+template<typename Key, typename T, typename Compare = std::less<>>
+using SplitMap = s21::SplitMap<Key, T, Compare, std::pmr::polymorphic_allocator<std::pair<Key, T>>>;
+}
+}
+
+#endif // MY_SPLIT_MAP_H
@@ -0,0 +1,228 @@
+#ifndef MY_SPSC_QUEUE_H
+#define MY_SPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+namespace s21 {
+//  Bounded lock-free queue for exactly one producer thread and one consumer
+//  thread. The slots form a ring of Capacity elements, Tail is advanced only
+//  by the producer and Head only by the consumer, each with a release store
+//  that the other side reads with acquire, so an element is fully built
+//  before the consumer sees it and fully taken before its slot is reused.
+//  Both indices count up without wrapping and are masked on access.
+//
+//  Head and Tail sit on separate cache lines together with the copy of the
+//  other index that their owner last read. The owner only reloads the other
+//  index when its copy says the ring is full (producer) or empty (consumer),
+//  so in the steady state each side touches the shared line of the other
+//  once per lap instead of once per element. The batch calls publish many
+//  elements with one store.
+template<typename Type, size_t Capacity, typename Allocator = std::allocator<Type>>
+class SpscQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+ public:
+  typedef size_t size_type;
+  typedef Type value_type;
+  typedef Type &reference;
+  typedef const Type &const_reference;
+  typedef Allocator allocator_type;
+
+  SpscQueue() : SpscQueue(Allocator()) {
+  }
+
+  explicit SpscQueue(const Allocator &alloc) : Alloc(alloc) {
+    Slots = AllocatorTraits::allocate(Alloc, Capacity);
+  }
+
+  SpscQueue(const SpscQueue &other) = delete;
+
+  void operator=(const SpscQueue &other) = delete;
+
+  //  no thread may use the queue any more
+  ~SpscQueue();
+
+  //  producer side, false when the ring is full
+
+  bool try_push(const Type &value) {return try_emplace(value);}
+
+  bool try_push(Type &&value) {return try_emplace(std::move(value));}
+
+  template<typename... Args>
+  bool try_emplace(Args &&...args);
+
+  //  pushes up to count elements read from first and returns how many fit
+  template<typename InputIterator>
+  size_type try_push_n(InputIterator first, size_type count);
+
+  //  consumer side
+
+  //  moves the first element to value, false when the ring is empty
+  bool try_pop(Type &value);
+
+  //  moves up to count elements to out and returns how many were taken
+  template<typename OutputIterator>
+  size_type try_pop_n(OutputIterator out, size_type count);
+
+  //  the first element read in place, nullptr when the ring is empty
+  Type *front();
+
+  //  removes the first element, throws std::out_of_range when there is none
+  void pop();
+
+  //  either side, only a snapshot while the other thread runs
+
+  size_type size() const;
+
+  bool empty() const {return size() == 0;}
+
+  static constexpr size_type capacity() {return Capacity;}
+
+  allocator_type get_allocator() const {return Alloc;}
+
+ private:
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+
+  //  x86-64 and most ARM cores, hardware_destructive_interference_size is
+  //  not used because its value may differ between translation units
+  static constexpr size_type CacheLine{64};
+  static constexpr size_type Mask{Capacity - 1};
+
+  //  written by the consumer
+  alignas(CacheLine) std::atomic<size_type> Head{0};
+  size_type CachedTail{0};
+
+  //  written by the producer
+  alignas(CacheLine) std::atomic<size_type> Tail{0};
+  size_type CachedHead{0};
+
+  //  read only after construction
+  alignas(CacheLine) Type *Slots{nullptr};
+  [[no_unique_address]] Allocator Alloc;
+};
+
+template<typename Type, size_t Capacity, typename Allocator>
+SpscQueue<Type, Capacity, Allocator>::~SpscQueue() {
+  size_type tail{Tail.load(std::memory_order_relaxed)};
+  for (size_type head{Head.load(std::memory_order_relaxed)}; head != tail; head++) {
+    AllocatorTraits::destroy(Alloc, Slots + (head & Mask));
+  }
+  AllocatorTraits::deallocate(Alloc, Slots, Capacity);
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename... Args>
+bool SpscQueue<Type, Capacity, Allocator>::try_emplace(Args &&...args) {
+  size_type tail{Tail.load(std::memory_order_relaxed)};
+  if (tail - CachedHead == Capacity) {
+    CachedHead = Head.load(std::memory_order_acquire);
+    if (tail - CachedHead == Capacity) {
+      return false;
+    }
+  }
+  AllocatorTraits::construct(Alloc, Slots + (tail & Mask), std::forward<Args>(args)...);
+  Tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+//  the elements built before an exception are published, in try_pop_n the
+//  ones taken before an exception are released
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename InputIterator>
+typename SpscQueue<Type, Capacity, Allocator>::size_type
+SpscQueue<Type, Capacity, Allocator>::try_push_n(InputIterator first, size_type count) {
+  size_type tail{Tail.load(std::memory_order_relaxed)};
+  if (Capacity - (tail - CachedHead) < count) {
+    CachedHead = Head.load(std::memory_order_acquire);
+  }
+  size_type pushed{std::min(count, Capacity - (tail - CachedHead))};
+  size_type built{0};
+  try {
+    for (; built < pushed; built++, ++first) {
+      AllocatorTraits::construct(Alloc, Slots + ((tail + built) & Mask), *first);
+    }
+  } catch (...) {
+    Tail.store(tail + built, std::memory_order_release);
+    throw;
+  }
+  Tail.store(tail + pushed, std::memory_order_release);
+  return pushed;
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+bool SpscQueue<Type, Capacity, Allocator>::try_pop(Type &value) {
+  Type *first{front()};
+  if (first == nullptr) {
+    return false;
+  }
+  value = std::move(*first);
+  pop();
+  return true;
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+template<typename OutputIterator>
+typename SpscQueue<Type, Capacity, Allocator>::size_type
+SpscQueue<Type, Capacity, Allocator>::try_pop_n(OutputIterator out, size_type count) {
+  size_type head{Head.load(std::memory_order_relaxed)};
+  if (CachedTail - head < count) {
+    CachedTail = Tail.load(std::memory_order_acquire);
+  }
+  size_type popped{std::min(count, CachedTail - head)};
+  size_type taken{0};
+  try {
+    for (; taken < popped; taken++, ++out) {
+      Type *slot{Slots + ((head + taken) & Mask)};
+      *out = std::move(*slot);
+      AllocatorTraits::destroy(Alloc, slot);
+    }
+  } catch (...) {
+    Head.store(head + taken, std::memory_order_release);
+    throw;
+  }
+  Head.store(head + popped, std::memory_order_release);
+  return popped;
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+Type *SpscQueue<Type, Capacity, Allocator>::front() {
+  size_type head{Head.load(std::memory_order_relaxed)};
+  if (head == CachedTail) {
+    CachedTail = Tail.load(std::memory_order_acquire);
+    if (head == CachedTail) {
+      return nullptr;
+    }
+  }
+  return Slots + (head & Mask);
+}
+
+template<typename Type, size_t Capacity, typename Allocator>
+void SpscQueue<Type, Capacity, Allocator>::pop() {
+  if (front() == nullptr) {
+    throw std::out_of_range("No such element");
+  }
+  size_type head{Head.load(std::memory_order_relaxed)};
+  AllocatorTraits::destroy(Alloc, Slots + (head & Mask));
+  Head.store(head + 1, std::memory_order_release);
+}
+
+//  Head is loaded first, Tail can only have grown since, so the difference
+//  never underflows
+template<typename Type, size_t Capacity, typename Allocator>
+typename SpscQueue<Type, Capacity, Allocator>::size_type SpscQueue<Type, Capacity, Allocator>::size() const {
+  size_type head{Head.load(std::memory_order_acquire)};
+  size_type tail{Tail.load(std::memory_order_acquire)};
+  return tail - head;
+}
+
+namespace pmr {
+template<typename Type, size_t Capacity>
+using SpscQueue = s21::SpscQueue<Type, Capacity, std::pmr::polymorphic_allocator<Type>>;
+}
+}
+
+#endif // MY_SPSC_QUEUE_H
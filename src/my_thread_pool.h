@@ -0,0 +1,282 @@
+#ifndef MY_THREAD_POOL_H
+#define MY_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "my_containerAdaptor.h"
+#include "my_vector.h"
+#include "my_work_stealing_deque.h"
+
+namespace s21 {
+class TaskGroup;
+
+//  Fixed set of worker threads with one WorkStealingDeque each. A task
+//  submitted from a worker goes to the bottom of that worker's deque and is
+//  usually run by it next, so a fork-join computation stays depth first on
+//  its own thread and the other workers steal the oldest, largest pieces
+//  from the top. Tasks submitted from other threads go through a shared
+//  queue under a mutex.
+//
+//  Idle workers sleep on a condition variable. Queued counts the tasks not
+//  yet taken and Sleeping the workers that are about to sleep, each side
+//  changes its own counter before reading the other one, so a submitter
+//  only takes the mutex to wake somebody when a worker may be asleep.
+class ThreadPool {
+ public:
+  typedef size_t size_type;
+
+  explicit ThreadPool(size_type threads = std::thread::hardware_concurrency());
+
+  ThreadPool(const ThreadPool &other) = delete;
+
+  void operator=(const ThreadPool &other) = delete;
+
+  //  runs the tasks still queued and joins the workers
+  ~ThreadPool();
+
+  //  runs function on some worker, nobody waits for it and an exception it
+  //  throws is lost, TaskGroup runs tasks that are waited for
+  template<typename Function>
+  void submit(Function &&function) {
+    Push(MakeTask(std::forward<Function>(function), nullptr));
+  }
+
+  size_type size() {return Workers.size();}
+
+ private:
+  friend class TaskGroup;
+
+  //  Run is the function bound to the task, it runs and deletes it
+  struct Task {
+    void (*Run)(Task *task);
+    TaskGroup *Group;
+  };
+
+  template<typename Function>
+  struct BoundTask : Task {
+    Function Body;
+  };
+
+  struct Worker {
+    WorkStealingDeque<Task *> Tasks;
+    std::thread Thread;
+  };
+
+  //  the pool and the index of the worker running on this thread
+  static inline thread_local ThreadPool *CurrentPool{nullptr};
+  static inline thread_local size_type CurrentIndex{0};
+
+  Vector<std::unique_ptr<Worker>> Workers;
+  //  Injected is guarded by Lock, InjectedCount lets a worker skip the lock
+  //  when it is empty
+  Queue<Task *> Injected;
+  std::atomic<size_type> InjectedCount{0};
+  std::mutex Lock;
+  std::condition_variable Wakeup;
+  std::atomic<size_type> Queued{0};
+  std::atomic<size_type> Sleeping{0};
+  std::atomic<bool> Stopping{false};
+
+  template<typename Function>
+  static Task *MakeTask(Function &&function, TaskGroup *group);
+
+  void Push(Task *task);
+
+  //  own deque first, then the shared queue, then the other workers starting
+  //  after the own index, nullptr when no task was found
+  Task *Find();
+
+  //  runs one queued task on the calling thread, false when none was found
+  bool RunOne();
+
+  void Execute(Task *task);
+
+  void Loop(size_type index);
+};
+
+//  Tasks that are waited for together. wait runs queued tasks on the calling
+//  thread while the tasks of the group are unfinished, so a task may start a
+//  group of its own and wait for it without tying up its worker, and the
+//  first exception thrown by a task of the group is rethrown there.
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool &pool) : Pool(pool) {
+  }
+
+  TaskGroup(const TaskGroup &other) = delete;
+
+  void operator=(const TaskGroup &other) = delete;
+
+  ~TaskGroup() {
+    Finish();
+  }
+
+  template<typename Function>
+  void run(Function &&function) {
+    //  counted only once the task exists, a throwing allocation or move of
+    //  the function leaves the group as it was
+    ThreadPool::Task *task = ThreadPool::MakeTask(std::forward<Function>(function), this);
+    Pending.fetch_add(1, std::memory_order_relaxed);
+    Pool.Push(task);
+  }
+
+  void wait();
+
+ private:
+  friend class ThreadPool;
+
+  typedef ThreadPool::size_type size_type;
+
+  ThreadPool &Pool;
+  std::atomic<size_type> Pending{0};
+  std::mutex ErrorLock;
+  std::exception_ptr Error;
+
+  void Finish() {
+    while (Pending.load(std::memory_order_acquire) != 0) {
+      if (!Pool.RunOne()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+inline ThreadPool::ThreadPool(size_type threads) {
+  threads = std::max<size_type>(threads, 1);
+  Workers.reserve(threads);
+  for (size_type i{0}; i < threads; i++) {
+    Workers.push_back(std::make_unique<Worker>());
+  }
+  for (size_type i{0}; i < threads; i++) {
+    Workers[i]->Thread = std::thread([this, i]() {Loop(i);});
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(Lock);
+    Stopping.store(true);
+  }
+  Wakeup.notify_all();
+  for (size_type i{0}; i < Workers.size(); i++) {
+    Workers[i]->Thread.join();
+  }
+}
+
+template<typename Function>
+ThreadPool::Task *ThreadPool::MakeTask(Function &&function, TaskGroup *group) {
+  typedef BoundTask<std::decay_t<Function>> Bound;
+  Bound *task = new Bound{{nullptr, group}, std::forward<Function>(function)};
+  task->Run = [](Task *base) {
+    std::unique_ptr<Bound> owned(static_cast<Bound *>(base));
+    owned->Body();
+  };
+  return task;
+}
+
+inline void ThreadPool::Push(Task *task) {
+  Queued.fetch_add(1);
+  if (CurrentPool == this) {
+    Workers[CurrentIndex]->Tasks.push(task);
+  } else {
+    std::lock_guard<std::mutex> guard(Lock);
+    Injected.push(task);
+    InjectedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (Sleeping.load() != 0) {
+    std::lock_guard<std::mutex> guard(Lock);
+    Wakeup.notify_one();
+  }
+}
+
+inline ThreadPool::Task *ThreadPool::Find() {
+  Task *task{nullptr};
+  bool worker{CurrentPool == this};
+  if (worker && Workers[CurrentIndex]->Tasks.pop(task)) {
+    return task;
+  }
+  if (InjectedCount.load(std::memory_order_relaxed) != 0) {
+    std::lock_guard<std::mutex> guard(Lock);
+    if (!Injected.empty()) {
+      task = Injected.front();
+      Injected.pop();
+      InjectedCount.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+  size_type start{worker ? CurrentIndex + 1 : 0};
+  for (size_type i{0}; i < Workers.size(); i++) {
+    if (Workers[(start + i) % Workers.size()]->Tasks.steal(task)) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+inline bool ThreadPool::RunOne() {
+  Task *task{Find()};
+  if (task == nullptr) {
+    return false;
+  }
+  Queued.fetch_sub(1, std::memory_order_relaxed);
+  Execute(task);
+  return true;
+}
+
+//  Pending of the group is lowered last, the group and the task may be gone
+//  as soon as the waiting thread sees it reach zero
+inline void ThreadPool::Execute(Task *task) {
+  TaskGroup *group{task->Group};
+  try {
+    task->Run(task);
+  } catch (...) {
+    if (group != nullptr) {
+      std::lock_guard<std::mutex> guard(group->ErrorLock);
+      if (!group->Error) {
+        group->Error = std::current_exception();
+      }
+    }
+  }
+  if (group != nullptr) {
+    group->Pending.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+inline void ThreadPool::Loop(size_type index) {
+  CurrentPool = this;
+  CurrentIndex = index;
+  while (true) {
+    if (RunOne()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(Lock);
+    Sleeping.fetch_add(1);
+    Wakeup.wait(guard, [this]() {return Queued.load() != 0 || Stopping.load();});
+    Sleeping.fetch_sub(1);
+    if (Stopping.load() && Queued.load() == 0) {
+      return;
+    }
+  }
+}
+
+inline void TaskGroup::wait() {
+  Finish();
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> guard(ErrorLock);
+    std::swap(error, Error);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+}
+
+#endif // MY_THREAD_POOL_H
@@ -0,0 +1,644 @@
+#ifndef MY_UNORDERED_MAP_H
+#define MY_UNORDERED_MAP_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+//  Control bytes of the hash table. A full slot holds the low 7 bits of the
+//  hash of its key (H2), the other states are negative so that one signed
+//  comparison tells them apart.
+namespace hash_table {
+typedef signed char ctrl_t;
+
+static constexpr ctrl_t Empty{-128};
+static constexpr ctrl_t Deleted{-2};
+//  stored after the last slot, stops iteration
+static constexpr ctrl_t Sentinel{-1};
+static constexpr size_t GroupWidth{16};
+
+//  Sixteen control bytes looked at together. Each Match returns a bit mask
+//  with bit i set when byte i matches, with SSE2 that is one compare and one
+//  movemask, without it a plain loop over the bytes.
+class Group {
+ public:
+  explicit Group(const ctrl_t *Pos) {
+#if defined(__SSE2__)
+    Ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Pos));
+#else
+    std::memcpy(Ctrl, Pos, GroupWidth);
+#endif
+  }
+
+  uint32_t Match(ctrl_t H2) const {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl)));
+#else
+    uint32_t mask{0};
+    for (size_t i{0}; i < GroupWidth; i++) {
+      mask |= static_cast<uint32_t>(Ctrl[i] == H2) << i;
+    }
+    return mask;
+#endif
+  }
+
+  uint32_t MatchEmpty() const {return Match(Empty);}
+
+  uint32_t MatchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(Sentinel), Ctrl)));
+#else
+    uint32_t mask{0};
+    for (size_t i{0}; i < GroupWidth; i++) {
+      mask |= static_cast<uint32_t>(Ctrl[i] < Sentinel) << i;
+    }
+    return mask;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i Ctrl;
+#else
+  ctrl_t Ctrl[GroupWidth];
+#endif
+};
+
+//  the control bytes of a table without slots, every lookup stops here
+alignas(GroupWidth) inline constexpr ctrl_t EmptyGroup[GroupWidth]{
+    Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty,
+    Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty};
+}
+
+//  Iterator over the full slots of an UnorderedMap, the control bytes are
+//  walked in step with the slots and skip the empty and deleted ones.
+template<typename Type>
+class HashTableIterator {
+ public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef std::remove_cv_t<Type> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Type *pointer;
+  typedef Type &reference;
+
+  HashTableIterator() {}
+
+  HashTableIterator(const hash_table::ctrl_t *InitCtrl, pointer InitSlot) : Ctrl(InitCtrl), Slot(InitSlot) {}
+
+  reference operator*() const {return *Slot;}
+
+  pointer operator->() const {return Slot;}
+
+  HashTableIterator &operator++() {
+    ++Ctrl;
+    ++Slot;
+    SkipFree();
+    return *this;
+  }
+
+  HashTableIterator operator++(int) {
+    HashTableIterator previous{*this};
+    ++*this;
+    return previous;
+  }
+
+  bool operator==(const HashTableIterator &other) const {return Ctrl == other.Ctrl;}
+
+ private:
+  template<typename, typename, typename, typename, typename>
+  friend class UnorderedMap;
+
+  const hash_table::ctrl_t *Ctrl{nullptr};
+  pointer Slot{nullptr};
+
+  void SkipFree() {
+    while (*Ctrl < hash_table::Sentinel) {
+      ++Ctrl;
+      ++Slot;
+    }
+  }
+};
+
+//  Open addressing hash map after Abseil's SwissTable. Next to the slots
+//  lies one control byte per slot, and a lookup compares 7 bits of the hash
+//  against sixteen control bytes at once, so it touches a slot only when
+//  those bits match, which is almost always the key it is looking for. The
+//  slots are probed a group of sixteen at a time, the groups in quadratic
+//  order, and the probe stops at the first group with an empty slot.
+//
+//  An erased slot only needs a tombstone when its group has no empty slot:
+//  a group never gets an empty slot back once it is full, so while it has
+//  one no probe ever went past it and the slot is simply marked empty. The
+//  table grows to keep at most 7/8 of the slots used, and is rehashed at the
+//  same size instead when tombstones take most of that.
+//
+//  Lookups are heterogeneous when both Hash and KeyEqual declare
+//  is_transparent, as in std::unordered_map. Any insertion may move all
+//  elements and invalidates iterators and references.
+template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+         typename Allocator = std::allocator<std::pair<Key, T>>>
+class UnorderedMap {
+  //  a K other than Key is looked up as it is, without building a Key
+  template<typename K>
+  static constexpr bool Transparent{requires {
+    typename Hash::is_transparent;
+    typename KeyEqual::is_transparent;
+  }};
+
+ public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<key_type, mapped_type> value_type;
+  typedef value_type &reference;
+  typedef size_t size_type;
+  typedef Hash hasher;
+  typedef KeyEqual key_equal;
+  typedef Allocator allocator_type;
+  typedef HashTableIterator<value_type> iterator;
+  typedef std::pair<iterator, bool> isInserted;
+
+  UnorderedMap() {}
+
+  explicit UnorderedMap(const Allocator &alloc) : Alloc(alloc) {}
+
+  explicit UnorderedMap(size_type count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+                        const Allocator &alloc = Allocator())
+      : Hasher(hash), Equal(equal), Alloc(alloc) {
+    reserve(count);
+  }
+
+  UnorderedMap(std::initializer_list<value_type> const &items, const Allocator &alloc = Allocator())
+      : Alloc(alloc) {
+    reserve(items.size());
+    for (auto iter{items.begin()}; iter != items.end(); iter++) {
+      insert(*iter);
+    }
+  }
+
+  UnorderedMap(const UnorderedMap &other)
+      : UnorderedMap(other, AllocatorTraits::select_on_container_copy_construction(other.Alloc)) {}
+
+  UnorderedMap(const UnorderedMap &other, const Allocator &alloc);
+
+  UnorderedMap(UnorderedMap &&other)
+      : Hasher(std::move(other.Hasher)), Equal(std::move(other.Equal)), Alloc(std::move(other.Alloc)) {
+    SwapTable(other);
+  }
+
+  ~UnorderedMap() {clear();}
+
+  void operator=(UnorderedMap &&other);
+
+  isInserted insert(const value_type &value) {return try_emplace(value.first, value.second);}
+
+  isInserted insert(const Key &key, const T &obj) {return try_emplace(key, obj);}
+
+  isInserted insert_or_assign(const value_type &value);
+
+  //  builds the value from args only when key is absent
+  template<typename... Args>
+  isInserted try_emplace(const key_type &key, Args &&...args);
+
+  template<typename... Args>
+  isInserted try_emplace(key_type &&key, Args &&...args);
+
+  mapped_type &operator[](const key_type &key) {return try_emplace(key).first->second;}
+
+  mapped_type &at(const key_type &key) {return AtPosition(FindPosition(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  mapped_type &at(const K &key) {return AtPosition(FindPosition(key));}
+
+  iterator find(const key_type &key) {return IteratorAt(FindPosition(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  iterator find(const K &key) {return IteratorAt(FindPosition(key));}
+
+  bool contains(const key_type &key) {return FindPosition(key) != Capacity;}
+
+  template<typename K>
+  requires Transparent<K>
+  bool contains(const K &key) {return FindPosition(key) != Capacity;}
+
+  size_type count(const key_type &key) {return contains(key) ? 1 : 0;}
+
+  void erase(iterator position) {EraseAt(static_cast<size_type>(position.Ctrl - Ctrl));}
+
+  //  returns the number of elements removed, 0 or 1
+  size_type erase(const key_type &key) {return ErasePosition(FindPosition(key));}
+
+  template<typename K>
+  requires Transparent<K>
+  size_type erase(const K &key) {return ErasePosition(FindPosition(key));}
+
+  void clear();
+
+  void swap(UnorderedMap &other);
+
+  //  makes room for count elements without growing on the way
+  void reserve(size_type count);
+
+  iterator begin();
+
+  iterator end() {return iterator(Ctrl + Capacity, Slots + Capacity);}
+
+  bool empty() {return MapSize == 0;}
+
+  size_type size() {return MapSize;}
+
+  size_type bucket_count() {return Capacity;}
+
+  double load_factor() {return Capacity == 0 ? 0.0 : static_cast<double>(MapSize) / static_cast<double>(Capacity);}
+
+  hasher hash_function() {return Hasher;}
+
+  key_equal key_eq() {return Equal;}
+
+  allocator_type get_allocator() {return Alloc;}
+
+ private:
+  typedef hash_table::ctrl_t ctrl_t;
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<ctrl_t> CtrlAllocator;
+  typedef std::allocator_traits<CtrlAllocator> CtrlTraits;
+
+  //  Capacity is zero or a power of two of at least one group, Ctrl holds
+  //  Capacity control bytes and the sentinel
+  ctrl_t *Ctrl{const_cast<ctrl_t *>(hash_table::EmptyGroup)};
+  value_type *Slots{nullptr};
+  size_type Capacity{0};
+  size_type MapSize{0};
+  //  inserts into empty slots left before the table has to grow
+  size_type GrowthLeft{0};
+  [[no_unique_address]] Hash Hasher;
+  [[no_unique_address]] KeyEqual Equal;
+  [[no_unique_address]] Allocator Alloc;
+
+  //  7/8 of the slots
+  static size_type MaxLoad(size_type capacity) {return capacity - capacity / 8;}
+
+  //  std::hash of an integer is the integer itself, the bits are mixed so
+  //  that both the group index and H2 depend on all of them
+  template<typename K>
+  size_t HashOf(const K &key) const {
+    size_t hash{Hasher(key)};
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  static ctrl_t H2(size_t hash) {return static_cast<ctrl_t>(hash & 0x7F);}
+
+  //  the group of the probe sequence is Offset, its slots are Offset to
+  //  Offset + GroupWidth
+  struct Probe {
+    size_type Mask;
+    size_type Offset;
+    size_type Step{0};
+
+    Probe(size_t hash, size_type capacity)
+        : Mask(capacity == 0 ? 0 : capacity - 1), Offset((hash >> 7) * hash_table::GroupWidth & Mask) {}
+
+    void Next() {
+      Step += hash_table::GroupWidth;
+      Offset = (Offset + Step) & Mask;
+    }
+  };
+
+  void SwapTable(UnorderedMap &other);
+
+  void SetCtrl(size_type pos, ctrl_t value) {Ctrl[pos] = value;}
+
+  //  the position of key, Capacity when it is absent
+  template<typename K>
+  size_type FindPosition(const K &key, size_t hash) const;
+
+  template<typename K>
+  size_type FindPosition(const K &key) const {return FindPosition(key, HashOf(key));}
+
+  //  the first empty or deleted slot on the probe sequence of hash
+  size_type FindFreePosition(size_t hash) const;
+
+  template<typename KeyArg, typename... Args>
+  isInserted Emplace(KeyArg &&key, Args &&...args);
+
+  iterator IteratorAt(size_type pos) {return pos == Capacity ? end() : iterator(Ctrl + pos, Slots + pos);}
+
+  mapped_type &AtPosition(size_type pos);
+
+  size_type ErasePosition(size_type pos) {
+    if (pos == Capacity) {
+      return 0;
+    }
+    EraseAt(pos);
+    return 1;
+  }
+
+  void EraseAt(size_type pos);
+
+  //  moves every element into a table of newCapacity slots, tombstones are
+  //  dropped on the way
+  void Resize(size_type newCapacity);
+
+  //  called when GrowthLeft is zero
+  void MakeRoom();
+
+  void ReleaseTable();
+};
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::UnorderedMap(const UnorderedMap &other, const Allocator &alloc)
+    : Hasher(other.Hasher), Equal(other.Equal), Alloc(alloc) {
+  if (other.MapSize == 0) {
+    return;
+  }
+  //  same capacity and same control bytes, every slot stays where it was
+  Resize(other.Capacity);
+  size_type pos{0};
+  try {
+    for (; pos < Capacity; pos++) {
+      if (other.Ctrl[pos] >= 0) {
+        AllocatorTraits::construct(Alloc, Slots + pos, other.Slots[pos]);
+        SetCtrl(pos, other.Ctrl[pos]);
+        MapSize += 1;
+      }
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+  std::memcpy(Ctrl, other.Ctrl, Capacity);
+  GrowthLeft = other.GrowthLeft;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::SwapTable(UnorderedMap &other) {
+  std::swap(Ctrl, other.Ctrl);
+  std::swap(Slots, other.Slots);
+  std::swap(Capacity, other.Capacity);
+  std::swap(MapSize, other.MapSize);
+  std::swap(GrowthLeft, other.GrowthLeft);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::operator=(UnorderedMap &&other) {
+  if (this != &other) {
+    clear();
+    std::swap(Hasher, other.Hasher);
+    std::swap(Equal, other.Equal);
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+      Alloc = std::move(other.Alloc);
+      SwapTable(other);
+    } else if (Alloc == other.Alloc) {
+      SwapTable(other);
+    } else {
+      reserve(other.MapSize);
+      for (iterator iter{other.begin()}; iter != other.end(); ++iter) {
+        Emplace(std::move(iter->first), std::move(iter->second));
+      }
+      other.clear();
+    }
+  }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::swap(UnorderedMap &other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
+  }
+  std::swap(Hasher, other.Hasher);
+  std::swap(Equal, other.Equal);
+  SwapTable(other);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::iterator
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::begin() {
+  if (MapSize == 0) {
+    return end();
+  }
+  iterator first(Ctrl, Slots);
+  first.SkipFree();
+  return first;
+}
+
+//  only slots whose control byte equals H2 are compared, a group with an
+//  empty slot ends the probe
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template<typename K>
+inline typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::FindPosition(const K &key, size_t hash) const {
+  for (Probe probe(hash, Capacity);; probe.Next()) {
+    hash_table::Group group(Ctrl + probe.Offset);
+    for (uint32_t match{group.Match(H2(hash))}; match != 0; match &= match - 1) {
+      size_type pos{probe.Offset + static_cast<size_type>(std::countr_zero(match))};
+      if (Equal(Slots[pos].first, key)) [[likely]] {
+        return pos;
+      }
+    }
+    if (group.MatchEmpty() != 0) [[likely]] {
+      return Capacity;
+    }
+  }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::FindFreePosition(size_t hash) const {
+  for (Probe probe(hash, Capacity);; probe.Next()) {
+    uint32_t free{hash_table::Group(Ctrl + probe.Offset).MatchEmptyOrDeleted()};
+    if (free != 0) {
+      return probe.Offset + static_cast<size_type>(std::countr_zero(free));
+    }
+  }
+}
+
+//  A missing key takes the first free slot of its probe sequence. The table
+//  grows first only when that slot is empty and no empty slot may be used
+//  up any more, a tombstone is reused for free. The control byte is set
+//  once the element is built, so an exception leaves the slot free.
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template<typename KeyArg, typename... Args>
+typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::isInserted
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::Emplace(KeyArg &&key, Args &&...args) {
+  size_t hash{HashOf(key)};
+  size_type pos{FindPosition(key, hash)};
+  if (pos != Capacity) {
+    return std::make_pair(iterator(Ctrl + pos, Slots + pos), false);
+  }
+  pos = FindFreePosition(hash);
+  if (GrowthLeft == 0 && Ctrl[pos] == hash_table::Empty) {
+    MakeRoom();
+    pos = FindFreePosition(hash);
+  }
+  AllocatorTraits::construct(Alloc, Slots + pos, std::piecewise_construct,
+                             std::forward_as_tuple(std::forward<KeyArg>(key)),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+  GrowthLeft -= Ctrl[pos] == hash_table::Empty ? 1 : 0;
+  SetCtrl(pos, H2(hash));
+  MapSize += 1;
+  return std::make_pair(iterator(Ctrl + pos, Slots + pos), true);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template<typename... Args>
+typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::isInserted
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::try_emplace(const key_type &key, Args &&...args) {
+  return Emplace(key, std::forward<Args>(args)...);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template<typename... Args>
+typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::isInserted
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::try_emplace(key_type &&key, Args &&...args) {
+  return Emplace(std::move(key), std::forward<Args>(args)...);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::isInserted
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::insert_or_assign(const value_type &value) {
+  isInserted result{try_emplace(value.first, value.second)};
+  if (!result.second) {
+    result.first->second = value.second;
+  }
+  return result;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::mapped_type &
+UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::AtPosition(size_type pos) {
+  if (pos == Capacity) {
+    throw std::out_of_range("No such element");
+  }
+  return Slots[pos].second;
+}
+
+//  the group of pos decides: with an empty slot no probe went past it
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::EraseAt(size_type pos) {
+  AllocatorTraits::destroy(Alloc, Slots + pos);
+  MapSize -= 1;
+  size_type groupStart{pos & ~(hash_table::GroupWidth - 1)};
+  if (hash_table::Group(Ctrl + groupStart).MatchEmpty() != 0) {
+    SetCtrl(pos, hash_table::Empty);
+    GrowthLeft += 1;
+  } else {
+    SetCtrl(pos, hash_table::Deleted);
+  }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::ReleaseTable() {
+  if (Capacity != 0) {
+    CtrlAllocator ctrlAlloc(Alloc);
+    CtrlTraits::deallocate(ctrlAlloc, Ctrl, Capacity + 1);
+    AllocatorTraits::deallocate(Alloc, Slots, Capacity);
+  }
+  Ctrl = const_cast<ctrl_t *>(hash_table::EmptyGroup);
+  Slots = nullptr;
+  Capacity = 0;
+  GrowthLeft = 0;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::clear() {
+  for (size_type pos{0}; pos < Capacity && MapSize != 0; pos++) {
+    if (Ctrl[pos] >= 0) {
+      AllocatorTraits::destroy(Alloc, Slots + pos);
+      MapSize -= 1;
+    }
+  }
+  MapSize = 0;
+  ReleaseTable();
+}
+
+//  Elements are moved only when that cannot throw, otherwise they are
+//  copied, so on exception the old table is left untouched.
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::Resize(size_type newCapacity) {
+  CtrlAllocator ctrlAlloc(Alloc);
+  ctrl_t *newCtrl{CtrlTraits::allocate(ctrlAlloc, newCapacity + 1)};
+  value_type *newSlots;
+  try {
+    newSlots = AllocatorTraits::allocate(Alloc, newCapacity);
+  } catch (...) {
+    CtrlTraits::deallocate(ctrlAlloc, newCtrl, newCapacity + 1);
+    throw;
+  }
+  std::memset(newCtrl, hash_table::Empty, newCapacity);
+  newCtrl[newCapacity] = hash_table::Sentinel;
+
+  //  owns the new table until it is complete, its destructor cleans up
+  //  after an exception
+  UnorderedMap resized(0, Hasher, Equal, Alloc);
+  resized.Ctrl = newCtrl;
+  resized.Slots = newSlots;
+  resized.Capacity = newCapacity;
+  resized.GrowthLeft = MaxLoad(newCapacity);
+  for (size_type pos{0}; pos < Capacity; pos++) {
+    if (Ctrl[pos] >= 0) {
+      size_type target{resized.FindFreePosition(HashOf(Slots[pos].first))};
+      AllocatorTraits::construct(Alloc, newSlots + target, std::move_if_noexcept(Slots[pos]));
+      resized.SetCtrl(target, Ctrl[pos]);
+      resized.MapSize += 1;
+      resized.GrowthLeft -= 1;
+    }
+  }
+  for (size_type pos{0}; pos < Capacity; pos++) {
+    if (Ctrl[pos] >= 0) {
+      AllocatorTraits::destroy(Alloc, Slots + pos);
+    }
+  }
+  MapSize = 0;
+  ReleaseTable();
+  SwapTable(resized);
+}
+
+//  a table mostly filled with tombstones is rehashed in place of growing
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::MakeRoom() {
+  if (Capacity == 0) {
+    Resize(hash_table::GroupWidth);
+  } else if (MapSize * 2 < MaxLoad(Capacity)) {
+    Resize(Capacity);
+  } else {
+    Resize(Capacity * 2);
+  }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedMap<Key, T, Hash, KeyEqual, Allocator>::reserve(size_type count) {
+  size_type newCapacity{hash_table::GroupWidth};
+  while (MaxLoad(newCapacity) < count) {
+    newCapacity *= 2;
+  }
+  if (count != 0 && newCapacity > Capacity) {
+    Resize(newCapacity);
+  }
+}
+
+namespace pmr {
+template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using UnorderedMap = s21::UnorderedMap<Key, T, Hash, KeyEqual, std::pmr::polymorphic_allocator<std::pair<Key, T>>>;
+}
+}
+
+#endif // MY_UNORDERED_MAP_H
@@ -1,119 +1,90 @@
 #ifndef MY_VECTOR_H
 #define MY_VECTOR_H
 
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "my_contiguous_iterator.h"
 
 namespace s21 {
-template<typename Type>
+template<typename Type, typename Allocator = std::allocator<Type>>
 class Vector {
  public:
 
-  class VectorIterator {
-   public:
-
-    VectorIterator() {}
-
-    VectorIterator(const VectorIterator &other) {
-      Pointer = other.Pointer;
-      Position = other.Position;
-    }
-
-    ~VectorIterator() {}
-
-    void SetIterator(std::shared_ptr<Type[]> InitPointer) {Pointer = InitPointer;}
-
-    Type &operator*() {return Pointer[Position];}
-
-    void operator++() {Position += 1;}
-
-    void operator--() {Position -= 1;}
-
-    void operator=(const VectorIterator other) {
-      copy(other);
-      Pointer = other.Pointer;
-    }
-
-    bool operator==(const VectorIterator other) {return Position == other.Position;}
-
-    bool operator!=(const VectorIterator other) {return Position != other.Position;}
-
-    bool operator>=(const VectorIterator other) {return Position >= other.Position;}
-
-    bool operator<=(const VectorIterator other) {return Position <= other.Position;}
-
-    void Advance(size_t repeat) {Position += repeat;}
-
-    void Decrease(size_t repeat) {Position -= repeat;}
-
-    const size_t GetPosition() {return Position;}
-
-    void swap(VectorIterator &other) {
-      Pointer.swap(other.Pointer);
-      std::swap(Position, other.Position);
-    }
-
-    void copy(const VectorIterator other) {Position = other.Position;}
-
-   private:
-    std::shared_ptr<Type[]> Pointer;
-    size_t Position{0};
-  };
+  typedef ContiguousIterator<Type> VectorIterator;
 
   typedef size_t size_type;
   typedef Type value_type;
   typedef Type &reference;
-  typedef Type &const_reference;
+  typedef const Type &const_reference;
   typedef VectorIterator iterator;
   typedef const VectorIterator const_iterator;
+  typedef Allocator allocator_type;
   //  Vector constructors
 
-  Vector() {
-    BeginIterator.SetIterator(Store);
-    EndIterator.SetIterator(Store);
-  }
+  Vector() {}
+
+  explicit Vector(const Allocator &alloc) : Alloc(alloc) {}
 
-  Vector(const size_type NewSize) {
-    Store.reset(new Type[NewSize]{});
-    VectorMaxSize = NewSize;
-    BeginIterator.SetIterator(Store);
-    EndIterator.SetIterator(Store);
+  Vector(const size_type NewSize, const Allocator &alloc = Allocator()) : Alloc(alloc) {
+    reserve(NewSize);
   }
 
-  Vector(const Vector &other) {
-    VectorSize = other.VectorSize;
+  Vector(const Vector &other)
+      : Vector(other, AllocatorTraits::select_on_container_copy_construction(other.Alloc)) {}
+
+  Vector(const Vector &other, const Allocator &alloc) : Alloc(alloc) {
+    Store = AllocateStore(other.VectorMaxSize);
     VectorMaxSize = other.VectorMaxSize;
-    Store.reset(new Type[VectorMaxSize]{});
-    for (int i{0}; i < VectorSize; i++) {
-      Store[i] = other.Store[i];
-    }
-    BeginIterator.SetIterator(Store);
-    BeginIterator.copy(other.BeginIterator);
-    EndIterator.SetIterator(Store);
-    EndIterator.copy(other.EndIterator);
+    GrowthFactor = other.GrowthFactor;
+    ConstructCopies(other.Store, other.Store + other.VectorSize);
+  }
+
+  Vector(std::initializer_list<value_type> const &items, const Allocator &alloc = Allocator())
+      : Alloc(alloc) {
+    Store = AllocateStore(items.size());
+    VectorMaxSize = items.size();
+    ConstructCopies(items.begin(), items.end());
   }
 
-  Vector(std::initializer_list<value_type> const &items) {
-    VectorSize = items.size();
-    VectorMaxSize = VectorSize;
-    Store.reset(new Type[VectorSize]{});
-    BeginIterator.SetIterator(Store);
-    EndIterator.SetIterator(Store);
-    auto iter{items.begin()};
-    Store[0] = *iter;
-    iter++;
-    for (int i{1}; iter != items.end(); i++, iter++) {
-      Store[i] = *iter;
-      ++EndIterator;
+  Vector(Vector &&other) : Alloc(std::move(other.Alloc)) {SwapStore(other);}
+
+  Vector(Vector &&other, const Allocator &alloc) : Alloc(alloc) {
+    if (Alloc == other.Alloc) {
+      SwapStore(other);
+    } else {
+      reserve(other.VectorSize);
+      for (size_type i{0}; i < other.VectorSize; i++) {
+        PushValue(std::move(other.Store[i]));
+      }
     }
   }
 
-  Vector(Vector &&other) {swap(other);}
+  ~Vector() {
+    DestroyElements(Store, VectorSize);
+    ReleaseStore();
+  }
 
   //  Vector methods
 
-  void push_back(value_type value);
+  void push_back(const_reference value);
+
+  void push_back(value_type &&value);
+
+  //  constructs one element in place at the back from args, unlike
+  //  emplace_back which pushes each of its arguments
+  template<typename... Args>
+  reference EmplaceBack(Args &&...args);
+
+  //  the store is grown once when the size of the range is known
+  template<typename Range>
+  void append_range(Range &&range);
 
   void pop_back();
 
@@ -123,20 +94,22 @@ class Vector {
 
   void swap(Vector& other);
 
-  const_reference front();
+  reference front();
 
-  const_reference back();
+  reference back();
 
   reference at(size_type pos);
 
-  iterator begin() {return BeginIterator;}
+  iterator begin() {return iterator(Store);}
 
-  iterator end() {return EndIterator;}
+  iterator end() {return iterator(Store + VectorSize);}
 
   reference operator[](size_type pos) {return Store[pos];}
 
   iterator insert(iterator pos, const_reference value);
 
+  iterator insert(iterator pos, value_type &&value);
+
   void operator=(Vector &&other );
 
   //  capacity methods
@@ -155,17 +128,19 @@ class Vector {
 
   size_type capacity() {return VectorMaxSize - VectorSize;}
 
-  void SizeIncrement() {VectorSize++;}
+  //  growth policy: capacity is multiplied by the factor when the store is full
 
-  void MaxSizeIncrement() {VectorMaxSize++;}
+  double GetGrowthFactor() {return GrowthFactor;}
 
-  void clear();
+  void SetGrowthFactor(double Factor);
 
-  void ResetPointer(std::shared_ptr<Type[]> newPointer);
+  void clear();
 
   void erase(iterator position);
 
-  std::shared_ptr<Type[]> data() {return Store;}
+  Type *data() {return Store;}
+
+  allocator_type get_allocator() {return Alloc;}
 
   iterator emplace(const_iterator pos) {return pos;}
 
@@ -184,184 +159,332 @@ class Vector {
   }
 
  private:
-  std::shared_ptr<Type[]> Store{new Type[0]{}};
-  iterator BeginIterator;
-  iterator EndIterator;
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+
+  //  capacity is raw memory, only the first VectorSize slots hold live objects
+  Type *Store{nullptr};
   size_type VectorSize{0};
   size_type VectorMaxSize{0};
+  double GrowthFactor{2.0};
+  [[no_unique_address]] Allocator Alloc;
+
+  size_type NextCapacity(size_type MinimalSize);
+
+  Type *AllocateStore(size_type Count) {
+    return Count == 0 ? nullptr : AllocatorTraits::allocate(Alloc, Count);
+  }
 
-  void IncreaseStoreAllocation(const Vector &old) {
-    std::shared_ptr<Type[]> store{new Type[VectorMaxSize]{}};
-    for (size_t i{0}; i < VectorSize; i++) {
-      store[i] = old.Store[i];
+  void ReleaseStore() {
+    if (Store != nullptr) {
+      AllocatorTraits::deallocate(Alloc, Store, VectorMaxSize);
     }
-    Store = std::move(store);
-    BeginIterator.SetIterator(Store);
-    EndIterator.SetIterator(Store);
+    Store = nullptr;
   }
 
-  void DecreaseStoreAllocation(const Vector &old) {
-    std::shared_ptr<Type[]> store{new Type[VectorMaxSize]{}};
-    for (size_t i{0}; i < VectorSize; i++) {
-      store[i] = old.Store[i];
+  void DestroyElements(Type *First, size_type Count) {
+    for (size_type i{0}; i < Count; i++) {
+      AllocatorTraits::destroy(Alloc, First + i);
     }
-    Store = std::move(store);
   }
-};
 
+  //  copies [First, Last) into the freshly allocated store
+  template<typename InputIterator>
+  void ConstructCopies(InputIterator First, InputIterator Last) {
+    try {
+      for (; First != Last; ++First, VectorSize++) {
+        AllocatorTraits::construct(Alloc, Store + VectorSize, *First);
+      }
+    } catch (...) {
+      DestroyElements(Store, VectorSize);
+      ReleaseStore();
+      throw;
+    }
+  }
 
-template<typename Type>
-void Vector<Type>::push_back(value_type value) {
-  if (!empty()) {
-    ++EndIterator;
+  void SwapStore(Vector &other) {
+    std::swap(Store, other.Store);
+    std::swap(VectorSize, other.VectorSize);
+    std::swap(VectorMaxSize, other.VectorMaxSize);
+    std::swap(GrowthFactor, other.GrowthFactor);
   }
-  if (VectorSize >= VectorMaxSize) {
-    VectorMaxSize += 1;
-    IncreaseStoreAllocation(*this);
+
+  void RelocateTo(Type *NewStore, size_type Gap);
+
+  void ReplaceStore(Type *NewStore, size_type NewMaxSize) {
+    ReleaseStore();
+    Store = NewStore;
+    VectorMaxSize = NewMaxSize;
+  }
+
+  template<typename... Args>
+  void PushValue(Args &&...args);
+
+  //  slow path of PushValue, kept apart so the common case stays small
+  //  enough to be inlined
+  template<typename... Args>
+  void PushWithGrowth(Args &&...args);
+
+  template<typename Value>
+  iterator InsertValue(iterator pos, Value &&value);
+};
+
+//  Moves the elements into NewStore leaving the slot at Gap uninitialized.
+//  Elements are moved only when that cannot throw, otherwise they are copied,
+//  so on exception the vector is left untouched.
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::RelocateTo(Type *NewStore, size_type Gap) {
+  if constexpr (std::is_trivially_copyable_v<Type>) {
+    if (VectorSize != 0) {
+      std::memcpy(NewStore, Store, Gap * sizeof(Type));
+      std::memcpy(NewStore + Gap + 1, Store + Gap, (VectorSize - Gap) * sizeof(Type));
+    }
+  } else {
+    size_type i{0};
+    try {
+      for (; i < VectorSize; i++) {
+        AllocatorTraits::construct(Alloc, NewStore + (i < Gap ? i : i + 1), std::move_if_noexcept(Store[i]));
+      }
+    } catch (...) {
+      for (size_type j{0}; j < i; j++) {
+        AllocatorTraits::destroy(Alloc, NewStore + (j < Gap ? j : j + 1));
+      }
+      throw;
+    }
+    DestroyElements(Store, VectorSize);
   }
-  VectorSize += 1;
-  *EndIterator = value;
 }
 
-template<typename Type>
-void Vector<Type>::shrink_to_fit() {
+template<typename Type, typename Allocator>
+template<typename... Args>
+inline void Vector<Type, Allocator>::PushValue(Args &&...args) {
   if (VectorSize < VectorMaxSize) {
-    DecreaseStoreAllocation(*this);
-    VectorMaxSize = VectorSize;
+    AllocatorTraits::construct(Alloc, Store + VectorSize, std::forward<Args>(args)...);
+    VectorSize += 1;
+  } else {
+    PushWithGrowth(std::forward<Args>(args)...);
   }
 }
 
-template<typename Type>
-void Vector<Type>::reserve(size_type NewSize) {
-      VectorMaxSize += NewSize;
-      IncreaseStoreAllocation(*this);
+template<typename Type, typename Allocator>
+template<typename... Args>
+void Vector<Type, Allocator>::PushWithGrowth(Args &&...args) {
+  size_type NewMaxSize = NextCapacity(VectorSize + 1);
+  Type *NewStore = AllocateStore(NewMaxSize);
+  try {
+    AllocatorTraits::construct(Alloc, NewStore + VectorSize, std::forward<Args>(args)...);
+    try {
+      RelocateTo(NewStore, VectorSize);
+    } catch (...) {
+      AllocatorTraits::destroy(Alloc, NewStore + VectorSize);
+      throw;
     }
+  } catch (...) {
+    AllocatorTraits::deallocate(Alloc, NewStore, NewMaxSize);
+    throw;
+  }
+  ReplaceStore(NewStore, NewMaxSize);
+  VectorSize += 1;
+}
 
-template<typename Type>
-void Vector<Type>::swap(Vector& other) {
-  Store.swap(other.Store);
-  std::swap(VectorSize, other.VectorSize);
-  std::swap(VectorMaxSize, other.VectorMaxSize);
-  BeginIterator.swap(other.BeginIterator);
-  EndIterator.swap(other.EndIterator);
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::push_back(const_reference value) {
+  PushValue(value);
 }
 
-template<typename Type>
-void Vector<Type>::clear() {
-  while (EndIterator != BeginIterator) {
-    *EndIterator = 0;
-    --EndIterator;
-  }
-  VectorSize = 0;
-  VectorMaxSize = 0;
-  Store.reset(new Type[0]{});
-  EndIterator.SetIterator(Store);
-  BeginIterator.SetIterator(Store);
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::push_back(value_type &&value) {
+  PushValue(std::move(value));
 }
 
-template<typename Type>
-void Vector<Type>::ResetPointer(std::shared_ptr<Type[]> newPointer) {
-  Store = newPointer;
-  BeginIterator.SetIterator(Store);
-  EndIterator.SetIterator(Store);
+template<typename Type, typename Allocator>
+template<typename... Args>
+typename Vector<Type, Allocator>::reference Vector<Type, Allocator>::EmplaceBack(Args &&...args) {
+  PushValue(std::forward<Args>(args)...);
+  return Store[VectorSize - 1];
 }
 
-template<typename Type>
-void Vector<Type>::erase(iterator position) {
-  *position = 0;
-  --EndIterator;
-  for (size_t i{0}, j{0}; i < VectorSize; i++, j++) {
-    if (i == position.GetPosition()) {
-      j++;
+template<typename Type, typename Allocator>
+template<typename Range>
+void Vector<Type, Allocator>::append_range(Range &&range) {
+  if constexpr (std::ranges::sized_range<Range>) {
+    size_type Required = VectorSize + std::ranges::size(range);
+    if (Required > VectorMaxSize) {
+      reserve(NextCapacity(Required));
     }
-    Store[i] = Store[j];
   }
-  VectorSize -= 1;
+  for (auto &&item : range) {
+    PushValue(std::forward<decltype(item)>(item));
+  }
 }
 
-template<typename Type>
-void Vector<Type>::operator=(Vector &&other ) {
-  VectorSize = other.VectorSize;
-  VectorMaxSize = other.VectorMaxSize;
-  Store.reset(new Type[VectorMaxSize]{});
-  for (int i{0}; i < VectorSize; i++) {
-    Store[i] = other.Store[i];
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::SetGrowthFactor(double Factor) {
+  if (!(Factor > 1.0)) {
+    throw std::invalid_argument("Growth factor must be greater than 1");
   }
-  BeginIterator.SetIterator(Store);
-  BeginIterator.copy(other.BeginIterator);
-  EndIterator.SetIterator(Store);
-  EndIterator.copy(other.EndIterator);
+  GrowthFactor = Factor;
 }
 
+template<typename Type, typename Allocator>
+typename Vector<Type, Allocator>::size_type Vector<Type, Allocator>::NextCapacity(size_type MinimalSize) {
+  size_type NewCapacity = static_cast<size_type>(VectorMaxSize * GrowthFactor);
+  if (NewCapacity < MinimalSize) {
+    NewCapacity = MinimalSize;
+  }
+  return NewCapacity;
+}
 
-template<typename Type>
-typename Vector<Type>::iterator Vector<Type>::insert(iterator pos, const_reference value) {
-size_type InsertPosition = pos.GetPosition();
-  VectorSize += 1;
-  if (VectorSize >= VectorMaxSize) {
-    VectorMaxSize += 1;
-    IncreaseStoreAllocation(*this);
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::shrink_to_fit() {
+  if (VectorSize < VectorMaxSize) {
+    Type *NewStore = AllocateStore(VectorSize);
+    try {
+      RelocateTo(NewStore, VectorSize);
+    } catch (...) {
+      AllocatorTraits::deallocate(Alloc, NewStore, VectorSize);
+      throw;
+    }
+    ReplaceStore(NewStore, VectorSize);
+  }
+}
+
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::reserve(size_type NewSize) {
+  if (NewSize > VectorMaxSize) {
+    Type *NewStore = AllocateStore(NewSize);
+    try {
+      RelocateTo(NewStore, VectorSize);
+    } catch (...) {
+      AllocatorTraits::deallocate(Alloc, NewStore, NewSize);
+      throw;
+    }
+    ReplaceStore(NewStore, NewSize);
   }
-  std::shared_ptr<value_type[]> store{new value_type[VectorMaxSize]};
-  if (InsertPosition < VectorSize - 1) {
-    VectorIterator access(begin());
-    for (size_t i{0}, j{0}; i < VectorSize - 1; i++, j++) {
-    if (j == InsertPosition) {
-      store[j] = value;
-      j++;
+}
+
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::swap(Vector& other) {
+  if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+    std::swap(Alloc, other.Alloc);
+  }
+  SwapStore(other);
+}
+
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::clear() {
+  DestroyElements(Store, VectorSize);
+  VectorSize = 0;
+  ReleaseStore();
+  VectorMaxSize = 0;
+}
+
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::erase(iterator position) {
+  std::move(position + 1, end(), position);
+  VectorSize -= 1;
+  AllocatorTraits::destroy(Alloc, Store + VectorSize);
+}
+
+template<typename Type, typename Allocator>
+void Vector<Type, Allocator>::operator=(Vector &&other) {
+  if (this != &other) {
+    clear();
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+      Alloc = std::move(other.Alloc);
+      SwapStore(other);
+    } else if (Alloc == other.Alloc) {
+      SwapStore(other);
+    } else {
+      reserve(other.VectorSize);
+      for (size_type i{0}; i < other.VectorSize; i++) {
+        PushValue(std::move(other.Store[i]));
+      }
+      other.clear();
     }
-      store[j] = *access;
-      ++access;
+  }
+}
+
+template<typename Type, typename Allocator>
+template<typename Value>
+typename Vector<Type, Allocator>::iterator Vector<Type, Allocator>::InsertValue(iterator pos, Value &&value) {
+  size_type InsertPosition = pos - begin();
+  if (InsertPosition == VectorSize) {
+    PushValue(std::forward<Value>(value));
+  } else if (VectorSize >= VectorMaxSize) {
+    size_type NewMaxSize = NextCapacity(VectorSize + 1);
+    Type *NewStore = AllocateStore(NewMaxSize);
+    try {
+      AllocatorTraits::construct(Alloc, NewStore + InsertPosition, std::forward<Value>(value));
+      try {
+        RelocateTo(NewStore, InsertPosition);
+      } catch (...) {
+        AllocatorTraits::destroy(Alloc, NewStore + InsertPosition);
+        throw;
+      }
+    } catch (...) {
+      AllocatorTraits::deallocate(Alloc, NewStore, NewMaxSize);
+      throw;
     }
-    Store = std::move(store);
-    BeginIterator.SetIterator(Store);
-    EndIterator.SetIterator(Store);
+    ReplaceStore(NewStore, NewMaxSize);
+    VectorSize += 1;
   } else {
-    *EndIterator = value;
+    value_type InsertedValue(std::forward<Value>(value));
+    AllocatorTraits::construct(Alloc, Store + VectorSize, std::move(Store[VectorSize - 1]));
+    std::move_backward(Store + InsertPosition, Store + VectorSize - 1, Store + VectorSize);
+    Store[InsertPosition] = std::move(InsertedValue);
+    VectorSize += 1;
   }
-  ++EndIterator;
-  VectorIterator InsertedPositionIterator;
-  InsertedPositionIterator.SetIterator(Store);
-  InsertedPositionIterator.Advance(InsertPosition);
-  return InsertedPositionIterator;
+  return iterator(Store + InsertPosition);
 }
 
-template<typename Type>
-void Vector<Type>::pop_back() {
+template<typename Type, typename Allocator>
+typename Vector<Type, Allocator>::iterator Vector<Type, Allocator>::insert(iterator pos, const_reference value) {
+  return InsertValue(pos, value);
+}
+
+template<typename Type, typename Allocator>
+typename Vector<Type, Allocator>::iterator Vector<Type, Allocator>::insert(iterator pos, value_type &&value) {
+  return InsertValue(pos, std::move(value));
+}
+
+template<typename Type, typename Allocator>
+inline void Vector<Type, Allocator>::pop_back() {
   if (empty()) {
     throw std::out_of_range("Не туда воюешь!");
   }
-  *EndIterator = 0;
   VectorSize -= 1;
-  *EndIterator = 0;
-  --EndIterator;
+  AllocatorTraits::destroy(Alloc, Store + VectorSize);
 }
 
-template<typename Type>
-typename Vector<Type>::const_reference Vector<Type>::front() {
+template<typename Type, typename Allocator>
+typename Vector<Type, Allocator>::reference Vector<Type, Allocator>::front() {
   if (empty())  {
     throw std::out_of_range("Не туда воюешь!");
   }
-  return *BeginIterator;
+  return Store[0];
 }
 
-template<typename Type>
-typename Vector<Type>::const_reference Vector<Type>::back() {
+template<typename Type, typename Allocator>
+typename Vector<Type, Allocator>::reference Vector<Type, Allocator>::back() {
   if (empty())  {
     throw std::out_of_range("Не туда воюешь!");
   }
-  return *EndIterator;
+  return Store[VectorSize - 1];
 }
 
-template<typename Type>
-typename Vector<Type>::reference Vector<Type>::at(size_type pos) {
-  if (pos < 0 && pos > VectorSize) {
+template<typename Type, typename Allocator>
+typename Vector<Type, Allocator>::reference Vector<Type, Allocator>::at(size_type pos) {
+  if (pos >= VectorSize) {
     throw std::out_of_range("Не туда воюешь!");
   }
   return Store[pos];
 }
 
 
+namespace pmr {
+template<typename Type>
+using Vector = s21::Vector<Type, std::pmr::polymorphic_allocator<Type>>;
+}
 }
 
 #endif // MY_VECTOR_H
@@ -0,0 +1,216 @@
+#ifndef MY_WORK_STEALING_DEQUE_H
+#define MY_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+namespace s21 {
+//  Chase-Lev deque: one owner thread pushes and pops at the bottom, any
+//  number of thieves steal from the top. The owner only synchronizes with
+//  the thieves when the deque is down to its last element, so a worker that
+//  runs its own tasks pays no compare-and-swap.
+//
+//  Thieves read a slot before they claim it, so the slots are atomics and
+//  Type has to be trivially copyable, a pointer to a task in practice. When
+//  the ring is full the owner copies it into one twice as large and
+//  publishes that, thieves that still read the old ring see the same values
+//  there, so growing never blocks them. Old rings are kept until the deque
+//  is destroyed.
+template<typename Type, typename Allocator = std::allocator<Type>>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<Type>, "Type is read by thieves before it is claimed");
+ public:
+  typedef size_t size_type;
+  typedef Type value_type;
+  typedef Allocator allocator_type;
+
+  WorkStealingDeque() : WorkStealingDeque(Allocator()) {
+  }
+
+  explicit WorkStealingDeque(const Allocator &alloc, size_type capacity = MinCapacity);
+
+  WorkStealingDeque(const WorkStealingDeque &other) = delete;
+
+  void operator=(const WorkStealingDeque &other) = delete;
+
+  //  no thread may use the deque any more
+  ~WorkStealingDeque();
+
+  //  owner side
+
+  void push(Type value);
+
+  //  takes the last element pushed, false when the deque is empty
+  bool pop(Type &value);
+
+  //  any thread, takes the first element, false when the deque is empty or
+  //  another thread took that element first
+  bool steal(Type &value);
+
+  //  only a snapshot while other threads run
+  size_type size() const;
+
+  bool empty() const {return size() == 0;}
+
+  allocator_type get_allocator() const {return Alloc;}
+
+ private:
+  struct Ring {
+    size_type Capacity;
+    std::atomic<Type> *Slots;
+    Ring *Previous;
+
+    Type Get(std::ptrdiff_t pos) const {
+      return Slots[pos & (Capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    void Put(std::ptrdiff_t pos, Type value) {
+      Slots[pos & (Capacity - 1)].store(value, std::memory_order_relaxed);
+    }
+  };
+
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<Ring> RingAllocator;
+  typedef std::allocator_traits<RingAllocator> RingTraits;
+  typedef typename AllocatorTraits::template rebind_alloc<std::atomic<Type>> SlotAllocator;
+  typedef std::allocator_traits<SlotAllocator> SlotTraits;
+
+  static constexpr size_type MinCapacity{64};
+  static constexpr size_type CacheLine{64};
+
+  //  Top is advanced by thieves and by the owner taking the last element,
+  //  Bottom is written by the owner only
+  alignas(CacheLine) std::atomic<std::ptrdiff_t> Top{0};
+  alignas(CacheLine) std::atomic<std::ptrdiff_t> Bottom{0};
+  alignas(CacheLine) std::atomic<Ring *> Current{nullptr};
+  [[no_unique_address]] Allocator Alloc;
+
+  Ring *NewRing(size_type capacity, Ring *previous);
+
+  //  copies the elements between top and bottom into a ring twice as large
+  Ring *Grow(Ring *ring, std::ptrdiff_t top, std::ptrdiff_t bottom);
+};
+
+template<typename Type, typename Allocator>
+WorkStealingDeque<Type, Allocator>::WorkStealingDeque(const Allocator &alloc, size_type capacity) : Alloc(alloc) {
+  size_type rounded{MinCapacity};
+  while (rounded < capacity) {
+    rounded *= 2;
+  }
+  Current.store(NewRing(rounded, nullptr), std::memory_order_relaxed);
+}
+
+template<typename Type, typename Allocator>
+WorkStealingDeque<Type, Allocator>::~WorkStealingDeque() {
+  RingAllocator ringAlloc(Alloc);
+  SlotAllocator slotAlloc(Alloc);
+  Ring *ring{Current.load(std::memory_order_relaxed)};
+  while (ring != nullptr) {
+    Ring *previous{ring->Previous};
+    SlotTraits::deallocate(slotAlloc, ring->Slots, ring->Capacity);
+    RingTraits::deallocate(ringAlloc, ring, 1);
+    ring = previous;
+  }
+}
+
+template<typename Type, typename Allocator>
+typename WorkStealingDeque<Type, Allocator>::Ring *
+WorkStealingDeque<Type, Allocator>::NewRing(size_type capacity, Ring *previous) {
+  RingAllocator ringAlloc(Alloc);
+  SlotAllocator slotAlloc(Alloc);
+  Ring *ring = RingTraits::allocate(ringAlloc, 1);
+  try {
+    ring->Slots = SlotTraits::allocate(slotAlloc, capacity);
+  } catch (...) {
+    RingTraits::deallocate(ringAlloc, ring, 1);
+    throw;
+  }
+  for (size_type i{0}; i < capacity; i++) {
+    SlotTraits::construct(slotAlloc, ring->Slots + i);
+  }
+  ring->Capacity = capacity;
+  ring->Previous = previous;
+  return ring;
+}
+
+template<typename Type, typename Allocator>
+typename WorkStealingDeque<Type, Allocator>::Ring *
+WorkStealingDeque<Type, Allocator>::Grow(Ring *ring, std::ptrdiff_t top, std::ptrdiff_t bottom) {
+  Ring *grown{NewRing(ring->Capacity * 2, ring)};
+  for (std::ptrdiff_t pos{top}; pos < bottom; pos++) {
+    grown->Put(pos, ring->Get(pos));
+  }
+  Current.store(grown, std::memory_order_release);
+  return grown;
+}
+
+//  Bottom is published with release, so a thief that sees the new Bottom
+//  also sees the element and whatever it points to
+template<typename Type, typename Allocator>
+void WorkStealingDeque<Type, Allocator>::push(Type value) {
+  std::ptrdiff_t bottom{Bottom.load(std::memory_order_relaxed)};
+  std::ptrdiff_t top{Top.load(std::memory_order_acquire)};
+  Ring *ring{Current.load(std::memory_order_relaxed)};
+  if (bottom - top >= static_cast<std::ptrdiff_t>(ring->Capacity)) {
+    ring = Grow(ring, top, bottom);
+  }
+  ring->Put(bottom, value);
+  Bottom.store(bottom + 1, std::memory_order_release);
+}
+
+//  Bottom is lowered before Top is read, the fence keeps the two in order
+//  against a thief doing the opposite, and the last element goes to whoever
+//  wins the compare-and-swap on Top
+template<typename Type, typename Allocator>
+bool WorkStealingDeque<Type, Allocator>::pop(Type &value) {
+  std::ptrdiff_t bottom{Bottom.load(std::memory_order_relaxed) - 1};
+  Ring *ring{Current.load(std::memory_order_relaxed)};
+  Bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::ptrdiff_t top{Top.load(std::memory_order_relaxed)};
+  if (top > bottom) {
+    Bottom.store(bottom + 1, std::memory_order_relaxed);
+    return false;
+  }
+  value = ring->Get(bottom);
+  if (top < bottom) {
+    return true;
+  }
+  bool won{Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)};
+  Bottom.store(bottom + 1, std::memory_order_relaxed);
+  return won;
+}
+
+template<typename Type, typename Allocator>
+bool WorkStealingDeque<Type, Allocator>::steal(Type &value) {
+  std::ptrdiff_t top{Top.load(std::memory_order_acquire)};
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::ptrdiff_t bottom{Bottom.load(std::memory_order_acquire)};
+  if (top >= bottom) {
+    return false;
+  }
+  Type taken{Current.load(std::memory_order_acquire)->Get(top)};
+  if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return false;
+  }
+  value = taken;
+  return true;
+}
+
+template<typename Type, typename Allocator>
+typename WorkStealingDeque<Type, Allocator>::size_type WorkStealingDeque<Type, Allocator>::size() const {
+  std::ptrdiff_t bottom{Bottom.load(std::memory_order_acquire)};
+  std::ptrdiff_t top{Top.load(std::memory_order_acquire)};
+  return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+}
+
+namespace pmr {
+template<typename Type>
+using WorkStealingDeque = s21::WorkStealingDeque<Type, std::pmr::polymorphic_allocator<Type>>;
+}
+}
+
+#endif // MY_WORK_STEALING_DEQUE_H
@@ -1,5 +1,23 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <queue>
+#include <ranges>
 #include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "my_containers.h"
 #include "my_containersplus.h"
@@ -84,7 +102,8 @@ TEST(Array, fill) {
 
 TEST(Array, swap) {
   Array<int, 5> arr1 = {1, 2, 3, 4, 5};
-  Array<int, 5> arr10 = {10, 20, 30, 40, 50, 60};
+  Array<int, 5> arr10 = {10, 20, 30, 40, 50};
+  EXPECT_THROW((Array<int, 5>{10, 20, 30, 40, 50, 60}), std::out_of_range);
   arr1.swap(arr10);
   Array<int, 5>::ArrayIterator iter1 = arr10.begin(), iter10 = arr1.begin();
   ASSERT_EQ(1, *iter1);
@@ -248,6 +267,71 @@ TEST(List, merge) {
   ASSERT_EQ(36, sum);
 }
 
+TEST(List, merge_sorted) {
+  List<int> elems1 = {1, 3, 5, 7, 9};
+  List<int> elems2 = {0, 2, 3, 4, 10};
+  elems1.merge(elems2);
+  List<int> check = {0, 1, 2, 3, 3, 4, 5, 7, 9, 10};
+  List<int>::ListIterator iter = elems1.begin(), iterCheck = check.begin();
+  for (; iterCheck != check.end(); ++iterCheck, ++iter) {
+    ASSERT_EQ(*iter, *iterCheck);
+  }
+  ASSERT_EQ(elems1.size(), 10);
+  ASSERT_TRUE(elems2.empty());
+  ASSERT_EQ(elems2.size(), 0);
+  elems2.push_back(42);
+  ASSERT_EQ(elems2.front(), 42);
+
+  List<int> desc1 = {9, 5, 1};
+  List<int> desc2 = {8, 4};
+  desc1.merge(desc2, std::greater<int>());
+  ASSERT_EQ(desc1.front(), 9);
+  ASSERT_EQ(desc1.back(), 1);
+  ASSERT_EQ(*(desc1.begin() + 1), 8);
+}
+
+TEST(List, sort) {
+  List<int> empty;
+  empty.sort();
+  ASSERT_TRUE(empty.empty());
+
+  List<int> numbers;
+  std::list<int> check;
+  unsigned seed = 12345;
+  for (int i{0}; i < 1000; i++) {
+    seed = seed * 1103515245 + 12345;
+    numbers.push_back(static_cast<int>(seed % 100));
+    check.push_back(static_cast<int>(seed % 100));
+  }
+  numbers.sort();
+  check.sort();
+  ASSERT_EQ(numbers.size(), 1000);
+  ASSERT_TRUE(std::equal(check.begin(), check.end(), numbers.begin()));
+  List<int>::ListIterator last = numbers.end();
+  for (auto checkIter = check.rbegin(); checkIter != check.rend();
+       ++checkIter) {
+    ASSERT_EQ(*(--last), *checkIter);
+  }
+  ASSERT_TRUE(last == numbers.begin());
+
+  //  equal keys keep their order
+  List<std::pair<int, int>> pairs;
+  for (int i{0}; i < 100; i++) {
+    pairs.push_back({i % 7, i});
+  }
+  pairs.sort([](const std::pair<int, int> &left,
+                const std::pair<int, int> &right) {
+    return left.first < right.first;
+  });
+  std::pair<int, int> previous = pairs.front();
+  for (auto iter = pairs.begin() + 1; iter != pairs.end(); ++iter) {
+    ASSERT_TRUE(previous.first < (*iter).first ||
+                (previous.first == (*iter).first &&
+                 previous.second < (*iter).second));
+    previous = *iter;
+  }
+}
+
 TEST(List, reverse) {
   List<int> normal = {1, 2, 3, 4, 5};
   List<int> reverse = {5, 4, 3, 2, 1};
@@ -293,6 +377,50 @@ TEST(List, splice) {
   ASSERT_EQ(myList.size(), 6);
 }
 
+TEST(List, splice_element) {
+  List<int> myList = {1, 2, 3};
+  List<int> otherList = {4, 5, 6};
+  List<int>::ListIterator moved = otherList.begin() + 1;
+  myList.splice(myList.end(), otherList, moved);
+  ASSERT_EQ(myList.size(), 4);
+  ASSERT_EQ(otherList.size(), 2);
+  ASSERT_EQ(myList.back(), 5);
+  ASSERT_EQ(*moved, 5);
+  ASSERT_EQ(*(otherList.begin() + 1), 6);
+
+  //  inside one list the element only changes its place
+  myList.splice(myList.begin(), myList, moved);
+  ASSERT_EQ(myList.front(), 5);
+  ASSERT_EQ(myList.back(), 3);
+  ASSERT_EQ(myList.size(), 4);
+
+  List<int> empty;
+  empty.splice(empty.begin(), myList, myList.begin());
+  ASSERT_EQ(empty.front(), 5);
+  ASSERT_EQ(empty.size(), 1);
+  ASSERT_EQ(myList.front(), 1);
+}
+
+TEST(List, splice_range) {
+  List<int> myList = {1, 2, 3};
+  List<int> otherList = {4, 5, 6, 7};
+  myList.splice(myList.begin() + 1, otherList, otherList.begin() + 1,
+                otherList.end());
+  List<int> check = {1, 5, 6, 7, 2, 3};
+  List<int>::ListIterator iter = myList.begin(), iterCheck = check.begin();
+  for (; iterCheck != check.end(); ++iterCheck, ++iter) {
+    ASSERT_EQ(*iter, *iterCheck);
+  }
+  ASSERT_EQ(myList.size(), 6);
+  ASSERT_EQ(otherList.size(), 1);
+  ASSERT_EQ(otherList.back(), 4);
+
+  myList.splice(myList.end(), myList, myList.begin(), myList.begin() + 2);
+  ASSERT_EQ(myList.front(), 6);
+  ASSERT_EQ(myList.back(), 5);
+  ASSERT_EQ(myList.size(), 6);
+}
+
 TEST(List, emplace) {
   List<int> myList = {1, 2, 3};
   List<int> checkList = {1, 4, 5, 6, 2, 3};
@@ -361,6 +489,7 @@ auto insert_iter_pair = Kala.insert(pair_1);
 
 Map<int, int>::iterator iter;
 iter = Kala.end();
+--iter;
 auto check_pair = *iter;
 ASSERT_EQ(check_pair.first, 15);
 ASSERT_EQ(check_pair.second, 6);
@@ -369,6 +498,7 @@ ASSERT_EQ(pair_1, *insert_iter_pair.first);
 Kala.insert(pair_2);
 
 iter = Kala.end();
+--iter;
 check_pair = *iter;
 ASSERT_EQ(check_pair.first, 15);
 ASSERT_EQ(check_pair.second, 6);
@@ -434,7 +564,7 @@ bool sorted{true};
 auto tmp_pair = *sortIterB;
 
 
-while (sortIterB <= sortIterE && sorted) {
+while (sortIterB != sortIterE && sorted) {
   check_pair = *sortIterB;
   if (check_pair.first < tmp_pair.first) {
     sorted = false;
@@ -462,7 +592,7 @@ Map<int, int>::iterator sortItersE(KalaInit.end());
 sorted = true;
 tmp_pair = *sortItersB;
 
-while (sortItersB <= sortItersE && sorted) {
+while (sortItersB != sortItersE && sorted) {
   check_pair = *sortItersB;
   if (check_pair.first < tmp_pair.first) {
     sorted = false;
@@ -501,7 +631,7 @@ auto iterVector = Kod.begin();
 auto iter_iter = *iterVector;
 
 ASSERT_EQ(pair_2, *iterMap);
-ASSERT_EQ(*iterMap, *iter_iter.first);
+ASSERT_TRUE(iter_iter.second);
 
 ++iterMap;
 ++iterVector;
@@ -518,7 +648,20 @@ ASSERT_EQ(*iterMap, *iter_iter.first);
 iter_iter = *iterVector;
 
 ASSERT_EQ(pair_1, *iterMap);
-ASSERT_EQ(*iterMap, *iter_iter.first);
+ASSERT_TRUE(iter_iter.second);
+ASSERT_EQ(iterMap + 1, KalaSorted.end());
+}
+
+TEST(Map, standard_algorithms) {
+  Map<int, int> Kala = {{5, 50}, {1, 10}, {9, 90}, {3, 30}, {7, 70}};
+  auto found = std::lower_bound(
+      Kala.begin(), Kala.end(), 6,
+      [](const std::pair<int, int> &item, int key) { return item.first < key; });
+  ASSERT_EQ(found->first, 7);
+  ASSERT_EQ(found - Kala.begin(), 3);
+  ASSERT_EQ(std::distance(Kala.begin(), Kala.end()), 5);
+  ASSERT_EQ(std::to_address(Kala.begin()), &*Kala.begin());
+  ASSERT_TRUE(std::is_sorted(Kala.begin(), Kala.end()));
 }
 
 TEST(Queue, basic) {
@@ -1135,7 +1278,9 @@ TEST(Test, lower1) {
                                      6, -1, -1, 6, 7, 22, 9, 0, -3};
   std::multiset<int> oMulti(list);
   s21::multiset<int> mMulti(list);
-  ASSERT_EQ(*mMulti.lower_bound(77), *oMulti.lower_bound(77));
+  ASSERT_TRUE(mMulti.lower_bound(77) == mMulti.end());
+  ASSERT_TRUE(oMulti.lower_bound(77) == oMulti.end());
+  ASSERT_EQ(*mMulti.lower_bound(4), *oMulti.lower_bound(4));
   auto it1 = mMulti.lower_bound(1);
   auto it2 = oMulti.lower_bound(1);
   while (it1 != mMulti.end() || it2 != oMulti.end()) {
@@ -1150,7 +1295,9 @@ TEST(Test, upper) {
                                      6, -1, -1, 6, 7, 22, 9, 0, -3};
   std::multiset<int> oMulti(list);
   s21::multiset<int> mMulti(list);
-  ASSERT_EQ(*mMulti.upper_bound(22), *oMulti.upper_bound(22));
+  ASSERT_TRUE(mMulti.upper_bound(22) == mMulti.end());
+  ASSERT_TRUE(oMulti.upper_bound(22) == oMulti.end());
+  ASSERT_EQ(*mMulti.upper_bound(4), *oMulti.upper_bound(4));
   auto it1 = mMulti.upper_bound(1);
   auto it2 = oMulti.upper_bound(1);
   while (it1 != mMulti.end() || it2 != oMulti.end()) {
@@ -1261,6 +1408,140 @@ TEST(Test, multi_emplce_empty) {
   }
 }
 
+//  reaches into the tree under a set to check the red-black invariants
+template <class SetType>
+struct TreeProbe : SetType {
+  typedef typename s21::BinarySearchTree<int>::Node Node;
+
+  //  returns the black height, -1 when an invariant is broken
+  static int BlackHeight(Node* node, Node* parent) {
+    if (node == nullptr) return 1;
+    if (node->_parent != parent) return -1;
+    if (node->_red && parent->_red) return -1;
+    if (node->_left != nullptr && node->_key < node->_left->_key) return -1;
+    if (node->_right != nullptr && node->_right->_key < node->_key) return -1;
+    int left = BlackHeight(node->_left, node);
+    int right = BlackHeight(node->_right, node);
+    if (left < 0 || left != right) return -1;
+    return left + (node->_red ? 0 : 1);
+  }
+
+  static int Height(Node* node) {
+    return node == nullptr
+               ? 0
+               : 1 + std::max(Height(node->_left), Height(node->_right));
+  }
+
+  bool IsValid() { return BlackHeight(this->_Root(), this->_Header()) > 0; }
+
+  int Height() { return Height(this->_Root()); }
+};
+
+TEST(Test, red_black_sorted_input) {
+  const int count = 200000;
+  TreeProbe<s21::set<int>> mSet;
+  for (int i = 0; i < count; i++) {
+    mSet.insert(i);
+  }
+  ASSERT_TRUE(mSet.IsValid());
+  ASSERT_LE(mSet.Height(), 2 * std::log2(count + 1));
+  for (int i = 0; i < count; i += 2) {
+    auto it = mSet.find(i);
+    mSet.erase(it);
+  }
+  ASSERT_TRUE(mSet.IsValid());
+  ASSERT_FALSE(mSet.contains(0));
+  ASSERT_TRUE(mSet.contains(count - 1));
+  int expected = 1;
+  for (auto it = mSet.begin(); it != mSet.end(); ++it, expected += 2) {
+    ASSERT_EQ(*it, expected);
+  }
+  ASSERT_EQ(expected, count + 1);
+
+  TreeProbe<s21::multiset<int>> mMulti;
+  std::multiset<int> oMulti;
+  for (int i = count; i > 0; i--) {
+    mMulti.insert(i / 4);
+    oMulti.insert(i / 4);
+  }
+  ASSERT_TRUE(mMulti.IsValid());
+  ASSERT_LE(mMulti.Height(), 2 * std::log2(count + 1));
+  ASSERT_EQ(mMulti.count(7), oMulti.count(7));
+  for (int i = 0; i < count / 4; i += 3) {
+    auto it = mMulti.find(i);
+    mMulti.erase(it);
+    oMulti.erase(oMulti.find(i));
+  }
+  ASSERT_TRUE(mMulti.IsValid());
+  auto it1 = mMulti.begin();
+  auto it2 = oMulti.begin();
+  while (it1 != mMulti.end() && it2 != oMulti.end()) {
+    ASSERT_EQ(*it1, *it2);
+    ++it1;
+    ++it2;
+  }
+  ASSERT_TRUE(it1 == mMulti.end() && it2 == oMulti.end());
+}
+
+TEST(Test, header_sentinel) {
+  s21::set<int> mSet;
+  ASSERT_TRUE(mSet.begin() == mSet.end());
+  ASSERT_EQ(mSet.size(), 0);
+  std::set<int> oSet;
+  for (int i = 0; i < 1000; i++) {
+    mSet.insert((i * 7919) % 1000);
+    oSet.insert((i * 7919) % 1000);
+    ASSERT_EQ(mSet.size(), oSet.size());
+    ASSERT_EQ(*mSet.begin(), *oSet.begin());
+    auto last = mSet.end();
+    --last;
+    ASSERT_EQ(*last, *oSet.rbegin());
+  }
+  //  walks backwards from end() to begin()
+  auto it1 = mSet.end();
+  auto it2 = oSet.end();
+  do {
+    --it1;
+    --it2;
+    ASSERT_EQ(*it1, *it2);
+  } while (it2 != oSet.begin());
+  ASSERT_TRUE(it1 == mSet.begin());
+
+  for (int i = 0; i < 1000; i += 3) {
+    auto it = mSet.find(i);
+    mSet.erase(it);
+    oSet.erase(i);
+  }
+  ASSERT_EQ(mSet.size(), oSet.size());
+  ASSERT_EQ(*mSet.begin(), *oSet.begin());
+
+  s21::set<int> mMoved(std::move(mSet));
+  ASSERT_EQ(mMoved.size(), oSet.size());
+  ASSERT_EQ(mSet.size(), 0);
+  ASSERT_TRUE(mSet.begin() == mSet.end());
+  auto last = mMoved.end();
+  --last;
+  ASSERT_EQ(*last, *oSet.rbegin());
+  mSet.swap(mMoved);
+  ASSERT_EQ(mSet.size(), oSet.size());
+  ASSERT_TRUE(mMoved.begin() == mMoved.end());
+  mSet.clear();
+  ASSERT_EQ(mSet.size(), 0);
+  ASSERT_TRUE(mSet.begin() == mSet.end());
+
+  std::initializer_list<int> list = {1, 1, 2, 2, 2, 5, 5, 9};
+  s21::multiset<int> mMulti(list);
+  std::multiset<int> oMulti(list);
+  ASSERT_EQ(mMulti.size(), oMulti.size());
+  ASSERT_EQ(*mMulti.lower_bound(3), *oMulti.lower_bound(3));
+  ASSERT_EQ(*mMulti.upper_bound(5), *oMulti.upper_bound(5));
+  ASSERT_EQ(mMulti.count(2), oMulti.count(2));
+  ASSERT_EQ(mMulti.count(9), oMulti.count(9));
+  auto lastMulti = mMulti.end();
+  --lastMulti;
+  ASSERT_EQ(*lastMulti, 9);
+}
+
 TEST(Stack, basic) {
 Stack<int> Kala;
 int k = 5;
@@ -1365,6 +1646,41 @@ ASSERT_EQ(4, Moved.top());
 
 }
 
+TEST(Stack, chunked) {
+  Stack<int, ChunkedStorage<int>> Kala;
+  Kala.push(0);
+  int *bottom = &Kala.top();
+  for (int i{1}; i < 10000; i++) {
+    Kala.push(i);
+  }
+  ASSERT_EQ(*bottom, 0);
+  for (int i{9999}; i > 0; i--) {
+    ASSERT_EQ(Kala.top(), i);
+    Kala.pop();
+  }
+  //  the first element never moved
+  ASSERT_EQ(&Kala.top(), bottom);
+  Kala.pop();
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_THROW(Kala.pop(), std::out_of_range);
+
+  Stack<std::string, ChunkedStorage<std::string>> KalaStrings = {"Kala", "Kala1"};
+  KalaStrings.pop();
+  ASSERT_EQ(KalaStrings.top(), "Kala");
+  KalaStrings.emplace(3, 'k');
+  ASSERT_EQ(KalaStrings.top(), "kkk");
+
+  Stack<std::unique_ptr<int>, ChunkedStorage<std::unique_ptr<int>>> KalaUnique;
+  for (int i{0}; i < 1000; i++) {
+    KalaUnique.push(std::make_unique<int>(i));
+  }
+  Stack<std::unique_ptr<int>, ChunkedStorage<std::unique_ptr<int>>> KalaMoved(std::move(KalaUnique));
+  ASSERT_EQ(*KalaMoved.top(), 999);
+  KalaMoved.pop();
+  ASSERT_EQ(*KalaMoved.top(), 998);
+  ASSERT_TRUE(KalaUnique.empty());
+}
+
 TEST(Vector, basic) {
   Vector<int> Kala;
 
@@ -1409,7 +1725,7 @@ Kala.push_back(3);
 Kala.push_back(3);
 
 ASSERT_EQ(Kala.size(), 10);
-ASSERT_EQ(Kala.max_size(), 10);
+ASSERT_EQ(Kala.max_size(), 16);
 
 //  Shrink_to_fit_check
 
@@ -1419,13 +1735,13 @@ Kala.pop_back();
 Kala.pop_back();
 
 ASSERT_EQ(Kala.size(), 6);
-ASSERT_EQ(Kala.max_size(), 10);
-ASSERT_EQ(Kala.capacity(), 4);
+ASSERT_EQ(Kala.max_size(), 16);
+ASSERT_EQ(Kala.capacity(), 10);
 
 Kala.push_back(3);
 ASSERT_EQ(Kala.size(), 7);
-ASSERT_EQ(Kala.max_size(), 10);
-ASSERT_EQ(Kala.capacity(), 3);
+ASSERT_EQ(Kala.max_size(), 16);
+ASSERT_EQ(Kala.capacity(), 9);
 
 Kala.shrink_to_fit();
 
@@ -1434,11 +1750,15 @@ ASSERT_EQ(Kala.max_size(), 7);
 
 //  Reserve check
 
-Kala.reserve(50);
+Kala.reserve(57);
 
 ASSERT_EQ(Kala.size(), 7);
 ASSERT_EQ(Kala.max_size(), 57);
 
+Kala.reserve(20);
+
+ASSERT_EQ(Kala.max_size(), 57);
+
 Kala.push_back(9);
 ASSERT_EQ(Kala.size(), 8);
 ASSERT_EQ(Kala.max_size(), 57);
@@ -1521,7 +1841,7 @@ ASSERT_EQ(KalaMoved[1], 2);
 iter.Advance(2);
 
 
-ASSERT_EQ(iter.GetPosition(), 2);
+ASSERT_EQ(iter - KalaMoved.begin(), 2);
 ASSERT_EQ(*iter, 8);
 
 KalaMoved.erase(iter);
@@ -1536,7 +1856,7 @@ ASSERT_EQ(KalaMoved.back(), 9);
 
 int ins = 8;
 iter = KalaMoved.insert(iter, ins);
-ASSERT_EQ(iter.GetPosition(), 2);
+ASSERT_EQ(iter - KalaMoved.begin(), 2);
 ASSERT_EQ(*iter, 8);
 
 ASSERT_EQ(KalaMoved.size(), 4);
@@ -1585,6 +1905,1878 @@ Vector<int[5]> ooo{};
 
 }
 
+TEST(Vector, amortized_growth) {
+  Vector<int> Kala;
+  size_t reallocations{0};
+  size_t last_max_size{Kala.max_size()};
+  for (int i{0}; i < 1000000; i++) {
+    Kala.push_back(i);
+    if (Kala.max_size() != last_max_size) {
+      last_max_size = Kala.max_size();
+      reallocations++;
+    }
+  }
+  ASSERT_EQ(Kala.size(), 1000000);
+  ASSERT_LE(reallocations, 21);
+  ASSERT_EQ(Kala[0], 0);
+  ASSERT_EQ(Kala[999999], 999999);
+
+  Vector<int> KalaSlow;
+  KalaSlow.SetGrowthFactor(1.5);
+  KalaSlow.push_back(1);
+  KalaSlow.push_back(2);
+  KalaSlow.push_back(3);
+  ASSERT_EQ(KalaSlow.max_size(), 3);
+  KalaSlow.push_back(4);
+  ASSERT_EQ(KalaSlow.max_size(), 4);
+  KalaSlow.push_back(5);
+  ASSERT_EQ(KalaSlow.max_size(), 6);
+  ASSERT_THROW(KalaSlow.SetGrowthFactor(1.0), std::invalid_argument);
+}
+
+TEST(Vector, standard_algorithms) {
+  static_assert(std::contiguous_iterator<Vector<int>::iterator>);
+  Vector<int> Kala = {9, 4, 7, 1, 8, 2};
+  std::sort(Kala.begin(), Kala.end());
+  ASSERT_TRUE(std::is_sorted(Kala.begin(), Kala.end()));
+  ASSERT_EQ(*std::lower_bound(Kala.begin(), Kala.end(), 5), 7);
+  ASSERT_EQ(Kala.end() - Kala.begin(), 6);
+  ASSERT_EQ(Kala.begin()[3], 7);
+  int sum{0};
+  for (int value : Kala) {
+    sum += value;
+  }
+  ASSERT_EQ(sum, 31);
+}
+
+struct Tracked {
+  static inline int defaults{0};
+  static inline int copies{0};
+  static inline int moves{0};
+  static inline int alive{0};
+  int value{0};
+  Tracked() {
+    defaults++;
+    alive++;
+  }
+  explicit Tracked(int init) : value(init) { alive++; }
+  Tracked(const Tracked &other) : value(other.value) {
+    copies++;
+    alive++;
+  }
+  Tracked(Tracked &&other) noexcept : value(other.value) {
+    moves++;
+    alive++;
+  }
+  Tracked &operator=(const Tracked &other) = default;
+  Tracked &operator=(Tracked &&other) = default;
+  ~Tracked() { alive--; }
+  static void Reset() { defaults = copies = moves = alive = 0; }
+};
+
+TEST(Vector, uninitialized_storage) {
+  Tracked::Reset();
+  {
+    Vector<Tracked> Kala(64);
+    ASSERT_EQ(Tracked::defaults, 0);
+    for (int i{0}; i < 100; i++) {
+      Kala.push_back(Tracked(i));
+    }
+    ASSERT_EQ(Tracked::defaults, 0);
+    ASSERT_EQ(Tracked::copies, 0);
+    ASSERT_EQ(Tracked::alive, 100);
+    ASSERT_EQ(Kala[99].value, 99);
+    Kala.insert(Kala.begin(), Tracked(-1));
+    ASSERT_EQ(Kala.front().value, -1);
+    ASSERT_EQ(Kala.back().value, 99);
+    Kala.erase(Kala.begin());
+    Kala.pop_back();
+    ASSERT_EQ(Tracked::alive, 99);
+    ASSERT_EQ(Tracked::copies, 0);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+
+  Vector<std::string> Strings;
+  std::string payload(64, 'x');
+  for (int i{0}; i < 1000; i++) {
+    Strings.push_back(payload);
+    Strings.push_back(Strings[0]);
+  }
+  ASSERT_EQ(Strings.size(), 2000);
+  ASSERT_EQ(Strings[1999], payload);
+  Strings.insert(Strings.begin() + 1, Strings[0]);
+  ASSERT_EQ(Strings[1], payload);
+  Strings.shrink_to_fit();
+  ASSERT_EQ(Strings.max_size(), 2001);
+  ASSERT_THROW(Strings.at(2001), std::out_of_range);
+}
+
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t outstanding{0};
+  size_t allocations{0};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    outstanding += bytes;
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    outstanding -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(Allocator, pmr_resource) {
+  CountingResource resource;
+  {
+    s21::pmr::Vector<int> Kala(&resource);
+    s21::pmr::List<int> KalaList(&resource);
+    s21::pmr::Map<int, int> KalaMap(&resource);
+    s21::pmr::set<int> KalaSet(&resource);
+    s21::pmr::multiset<int> KalaMulti(&resource);
+    s21::pmr::Stack<int> KalaStack(&resource);
+    s21::pmr::Queue<int> KalaQueue(&resource);
+    s21::pmr::Array<int, 4> KalaArray(&resource);
+    for (int i{0}; i < 100; i++) {
+      Kala.push_back(i);
+      KalaList.push_back(i);
+      KalaMap.insert(i, i);
+      KalaSet.insert(i);
+      KalaMulti.insert(i % 10);
+      KalaStack.push(i);
+      KalaQueue.push(i);
+    }
+    ASSERT_EQ(Kala.get_allocator().resource(), &resource);
+    ASSERT_EQ(KalaList.get_allocator().resource(), &resource);
+    ASSERT_EQ(KalaMap.get_allocator().resource(), &resource);
+    ASSERT_EQ(KalaSet.get_allocator().resource(), &resource);
+    ASSERT_EQ(KalaMulti.get_allocator().resource(), &resource);
+    ASSERT_EQ(KalaStack.get_allocator().resource(), &resource);
+    ASSERT_EQ(KalaQueue.get_allocator().resource(), &resource);
+    ASSERT_EQ(KalaArray.get_allocator().resource(), &resource);
+    ASSERT_GT(resource.allocations, 0);
+    ASSERT_GT(resource.outstanding, 0);
+
+    s21::pmr::Vector<int> KalaMoved(std::move(Kala));
+    s21::pmr::set<int> KalaSetCopy(KalaSet);
+    ASSERT_EQ(KalaMoved.size(), 100);
+    ASSERT_EQ(KalaSetCopy.size(), 100);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+TEST(Allocator, node_pool) {
+  CountingResource resource;
+  {
+    s21::pmr::set<int> KalaSet(&resource);
+    s21::pmr::List<std::string> KalaList(&resource);
+    for (int i{0}; i < 10000; i++) {
+      KalaSet.insert(i);
+      KalaList.push_back(std::to_string(i));
+    }
+    ASSERT_LT(resource.allocations, 100);
+    size_t allocations = resource.allocations;
+    for (int i{0}; i < 10000; i += 2) {
+      auto iter = KalaSet.find(i);
+      KalaSet.erase(iter);
+    }
+    for (int i{0}; i < 10000; i += 2) {
+      KalaSet.insert(i);
+    }
+    ASSERT_EQ(resource.allocations, allocations);
+    ASSERT_EQ(KalaSet.size(), 10000);
+    ASSERT_EQ(KalaList.back(), "9999");
+    KalaSet.clear();
+    KalaList.clear();
+    KalaList.push_back("Kala");
+    ASSERT_EQ(KalaList.front(), "Kala");
+    ASSERT_TRUE(KalaSet.empty());
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+TEST(Stack, chunk_reuse) {
+  CountingResource resource;
+  {
+    Stack<int, s21::pmr::ChunkedStorage<int>> Kala(&resource);
+    for (int i{0}; i < 10000; i++) {
+      Kala.push(i);
+    }
+    size_t allocations = resource.allocations;
+    while (!Kala.empty()) {
+      Kala.pop();
+    }
+    for (int i{0}; i < 10000; i++) {
+      Kala.push(i);
+    }
+    ASSERT_EQ(resource.allocations, allocations);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+
+  //  the chunk of a first element whose constructor threw is kept
+  struct Failing {
+    int value;
+    explicit Failing(int init) : value(init) {
+      if (init < 0) {
+        throw std::invalid_argument("negative");
+      }
+    }
+  };
+  {
+    Stack<Failing, s21::pmr::ChunkedStorage<Failing>> Kala(&resource);
+    ASSERT_THROW(Kala.emplace(-1), std::invalid_argument);
+    ASSERT_TRUE(Kala.empty());
+    size_t allocations = resource.allocations;
+    Kala.emplace(1);
+    Kala.emplace(2);
+    ASSERT_EQ(resource.allocations, allocations);
+    ASSERT_EQ(Kala.top().value, 2);
+    Kala.pop();
+    ASSERT_EQ(Kala.top().value, 1);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+TEST(Allocator, splice_shared_pool) {
+  CountingResource resource;
+  {
+    s21::pmr::List<std::string> first(&resource);
+    s21::pmr::List<std::string> third(&resource);
+    for (int i{0}; i < 100; i++) {
+      third.push_back(std::to_string(i));
+    }
+    {
+      s21::pmr::List<std::string> second(&resource);
+      for (int i{0}; i < 100; i++) {
+        first.push_back(std::to_string(i));
+        second.push_back(std::to_string(i));
+      }
+      size_t allocations = resource.allocations;
+      first.splice(first.begin(), second, second.begin());
+      first.splice(first.end(), second, second.begin(), second.begin() + 10);
+      third.splice(third.begin(), second, second.begin());
+      ASSERT_EQ(resource.allocations, allocations);
+      ASSERT_EQ(second.size(), 88);
+    }
+    ASSERT_EQ(first.front(), "0");
+    ASSERT_EQ(first.back(), "10");
+    ASSERT_EQ(first.size(), 111);
+    ASSERT_EQ(third.front(), "11");
+    first.splice(first.end(), third);
+    ASSERT_TRUE(third.empty());
+    ASSERT_EQ(first.size(), 212);
+    first.clear();
+    third.push_back("Kala");
+    ASSERT_EQ(third.front(), "Kala");
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+TEST(Queue, ring_buffer) {
+  Queue<int> Kala;
+  std::queue<int> Reference;
+  int value{0};
+  //  the head walks around the store several times and the store grows while
+  //  the elements are wrapped, order must stay FIFO
+  for (int round{0}; round < 200; round++) {
+    for (int i{0}; i < round % 7 + 3; i++, value++) {
+      Kala.push(value);
+      Reference.push(value);
+    }
+    for (int i{0}; i < round % 5 + 1 && !Reference.empty(); i++) {
+      ASSERT_EQ(Kala.front(), Reference.front());
+      Kala.pop();
+      Reference.pop();
+    }
+    ASSERT_EQ(Kala.size(), Reference.size());
+    ASSERT_EQ(Kala.back(), Reference.back());
+  }
+  Queue<int> KalaCopy(Kala);
+  while (!Reference.empty()) {
+    ASSERT_EQ(KalaCopy.front(), Reference.front());
+    ASSERT_EQ(Kala.front(), Reference.front());
+    KalaCopy.pop();
+    Kala.pop();
+    Reference.pop();
+  }
+  ASSERT_THROW(Kala.pop(), std::out_of_range);
+
+  //  a steady work queue does not allocate once the store is large enough
+  CountingResource resource;
+  {
+    s21::pmr::Queue<int> Work(&resource);
+    for (int i{0}; i < 100000; i++) {
+      Work.push(i);
+      if (i >= 16) {
+        ASSERT_EQ(Work.front(), i - 16);
+        Work.pop();
+      }
+    }
+    ASSERT_EQ(Work.size(), 16);
+    ASSERT_LE(resource.allocations, 3);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+
+  Tracked::Reset();
+  {
+    Queue<Tracked> Tracks;
+    for (int i{0}; i < 50; i++) {
+      Tracks.push(Tracked(i));
+    }
+    for (int i{0}; i < 25; i++) {
+      Tracks.pop();
+    }
+    ASSERT_EQ(Tracks.size(), 25);
+    ASSERT_EQ(Tracks.front().value, 25);
+    ASSERT_EQ(Tracks.back().value, 49);
+    ASSERT_EQ(Tracked::alive, 25);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+}
+
+//  emplace and push_range must not copy, whatever the underlying container
+template<typename StackType>
+void CheckStackForwarding() {
+  Tracked::Reset();
+  {
+    StackType Kala;
+    Tracked &first = Kala.emplace(1);
+    ASSERT_EQ(&first, &Kala.top());
+    Kala.push(Tracked(2));
+    ASSERT_EQ(Tracked::copies, 0);
+
+    std::vector<Tracked> Items;
+    for (int i{3}; i < 103; i++) {
+      Items.emplace_back(i);
+    }
+    Tracked::copies = 0;
+    Kala.push_range(std::ranges::subrange(std::make_move_iterator(Items.begin()),
+                                          std::make_move_iterator(Items.end())));
+    ASSERT_EQ(Tracked::copies, 0);
+    ASSERT_EQ(Kala.size(), 102);
+    Kala.push_range(Items);
+    ASSERT_EQ(Tracked::copies, 100);
+    ASSERT_EQ(Kala.size(), 202);
+    for (int i{0}; i < 100; i++) {
+      Kala.pop();
+    }
+    for (int i{102}; i > 0; i--) {
+      ASSERT_EQ(Kala.top().value, i);
+      Kala.pop();
+    }
+    ASSERT_TRUE(Kala.empty());
+    ASSERT_THROW(Kala.pop(), std::out_of_range);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(Stack, containers) {
+  CheckStackForwarding<Stack<Tracked>>();
+  CheckStackForwarding<Stack<Tracked, RingBuffer<Tracked>>>();
+  CheckStackForwarding<Stack<Tracked, ChunkedStorage<Tracked>>>();
+  CheckStackForwarding<Stack<Tracked, Deque<Tracked>>>();
+
+  Stack<int> KalaFromVector(Vector<int>{1, 2, 3});
+  ASSERT_EQ(KalaFromVector.top(), 3);
+  ASSERT_EQ(KalaFromVector.size(), 3);
+
+  Tracked::Reset();
+  {
+    Queue<Tracked> Kala;
+    std::vector<Tracked> Items;
+    for (int i{0}; i < 50; i++) {
+      Items.emplace_back(i);
+    }
+    Tracked::copies = 0;
+    Kala.emplace(-1);
+    Kala.push_range(std::ranges::subrange(std::make_move_iterator(Items.begin()),
+                                          std::make_move_iterator(Items.end())));
+    ASSERT_EQ(Tracked::copies, 0);
+    ASSERT_EQ(Kala.front().value, -1);
+    ASSERT_EQ(Kala.back().value, 49);
+    Kala.pop();
+    for (int i{0}; i < 50; i++) {
+      ASSERT_EQ(Kala.front().value, i);
+      Kala.pop();
+    }
+    ASSERT_TRUE(Kala.empty());
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+
+  Queue<int, RingBuffer<int>> KalaRing = {1, 2, 3};
+  KalaRing.pop();
+  ASSERT_EQ(KalaRing.front(), 2);
+
+  Queue<int, RingBuffer<int>> KalaInit = {1, 2, 3};
+  KalaInit.push_range(std::vector<int>{4, 5});
+  ASSERT_EQ(KalaInit.size(), 5);
+  ASSERT_EQ(KalaInit.front(), 1);
+  ASSERT_EQ(KalaInit.back(), 5);
+}
+
+//  pops every element and checks the order against std::priority_queue
+template<typename QueueType, typename Compare = std::less<int>>
+void CheckHeapOrder(size_t count) {
+  QueueType Kala;
+  std::priority_queue<int, std::vector<int>, Compare> Reference;
+  unsigned seed{12345};
+  for (size_t i{0}; i < count; i++) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>(seed >> 16) % 1000;
+    Kala.push(value);
+    Reference.push(value);
+    if (i % 3 == 2) {
+      ASSERT_EQ(Kala.top(), Reference.top());
+      Kala.pop();
+      Reference.pop();
+    }
+  }
+  ASSERT_EQ(Kala.size(), Reference.size());
+  while (!Reference.empty()) {
+    ASSERT_EQ(Kala.top(), Reference.top());
+    Kala.pop();
+    Reference.pop();
+  }
+  ASSERT_TRUE(Kala.empty());
+}
+
+TEST(PriorityQueue, heap) {
+  CheckHeapOrder<PriorityQueue<int>>(1000);
+  CheckHeapOrder<PriorityQueue<int, Vector<int>, std::less<int>, 2>>(1000);
+  CheckHeapOrder<PriorityQueue<int, Vector<int>, std::less<int>, 3>>(1000);
+  CheckHeapOrder<PriorityQueue<int, Vector<int>, std::greater<int>, 8>, std::greater<int>>(1000);
+
+  PriorityQueue<int> KalaInit = {3, 9, 1, 7, 5};
+  ASSERT_EQ(KalaInit.size(), 5);
+  ASSERT_EQ(KalaInit.top(), 9);
+  //  a long range is heapified, a short one is sifted in
+  std::vector<int> Long(100);
+  for (int i{0}; i < 100; i++) {
+    Long[i] = (i * 37) % 101;
+  }
+  KalaInit.push_range(Long);
+  KalaInit.push_range(std::vector<int>{150, -1});
+  ASSERT_EQ(KalaInit.size(), 107);
+  std::vector<int> Popped;
+  while (!KalaInit.empty()) {
+    Popped.push_back(KalaInit.top());
+    KalaInit.pop();
+  }
+  ASSERT_TRUE(std::is_sorted(Popped.rbegin(), Popped.rend()));
+  ASSERT_EQ(Popped.front(), 150);
+  ASSERT_EQ(Popped.back(), -1);
+  ASSERT_THROW(KalaInit.pop(), std::out_of_range);
+
+  PriorityQueue<int> KalaFromVector(std::less<int>(), Vector<int>{4, 8, 2, 6});
+  ASSERT_EQ(KalaFromVector.top(), 8);
+
+  PriorityQueue<std::string> KalaStrings;
+  KalaStrings.emplace(3, 'a');
+  KalaStrings.emplace(2, 'z');
+  KalaStrings.push("m");
+  ASSERT_EQ(KalaStrings.top(), "zz");
+  KalaStrings.pop();
+  ASSERT_EQ(KalaStrings.top(), "m");
+
+  PriorityQueue<std::unique_ptr<int>, Vector<std::unique_ptr<int>>,
+                std::function<bool(const std::unique_ptr<int> &, const std::unique_ptr<int> &)>>
+      KalaUnique([](const std::unique_ptr<int> &left, const std::unique_ptr<int> &right) {
+        return *left < *right;
+      });
+  for (int i{0}; i < 10; i++) {
+    KalaUnique.push(std::make_unique<int>((i * 7) % 10));
+  }
+  ASSERT_EQ(*KalaUnique.top(), 9);
+  KalaUnique.pop();
+  ASSERT_EQ(*KalaUnique.top(), 8);
+}
+
+TEST(PriorityQueue, handles) {
+  AddressablePriorityQueue<int, std::greater<int>> Kala;
+  std::vector<size_t> Handles;
+  std::vector<int> Values;
+  for (int i{0}; i < 200; i++) {
+    Values.push_back((i * 53) % 200 + 100);
+    Handles.push_back(Kala.push(Values.back()));
+  }
+  ASSERT_EQ(Kala.top(), 100);
+  //  decrease and increase keys, then erase a few
+  for (int i{0}; i < 200; i += 3) {
+    Values[i] = i % 2 == 0 ? Values[i] - 150 : Values[i] + 150;
+    Kala.update(Handles[i], Values[i]);
+    ASSERT_EQ(Kala.at(Handles[i]), Values[i]);
+  }
+  for (int i{1}; i < 200; i += 10) {
+    Kala.erase(Handles[i]);
+    ASSERT_FALSE(Kala.contains(Handles[i]));
+    Values[i] = -1000;
+  }
+  ASSERT_THROW(Kala.update(Handles[1], 5), std::out_of_range);
+  std::multiset<int> Expected;
+  for (int value : Values) {
+    if (value != -1000) {
+      Expected.insert(value);
+    }
+  }
+  ASSERT_EQ(Kala.size(), Expected.size());
+  //  erased handles are given to new elements
+  size_t Reused = Kala.push(-500);
+  ASSERT_LT(Reused, 200);
+  ASSERT_EQ(Kala.top_handle(), Reused);
+  ASSERT_EQ(Kala.top(), -500);
+  Kala.pop();
+  for (int value : Expected) {
+    ASSERT_EQ(Kala.top(), value);
+    ASSERT_EQ(Kala.at(Kala.top_handle()), value);
+    Kala.pop();
+  }
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_THROW(Kala.pop(), std::out_of_range);
+
+  CountingResource resource;
+  {
+    s21::pmr::AddressablePriorityQueue<std::string> KalaStrings(&resource);
+    size_t First = KalaStrings.push("b");
+    KalaStrings.emplace(3, 'c');
+    KalaStrings.update(First, "d");
+    ASSERT_EQ(KalaStrings.top(), "d");
+    ASSERT_EQ(KalaStrings.get_allocator().resource(), &resource);
+    ASSERT_GT(resource.allocations, 0);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+TEST(SpscQueue, basic) {
+  SpscQueue<int, 8> Kala;
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.capacity(), 8);
+  ASSERT_EQ(Kala.front(), nullptr);
+  ASSERT_THROW(Kala.pop(), std::out_of_range);
+  for (int i{0}; i < 8; i++) {
+    ASSERT_TRUE(Kala.try_push(i));
+  }
+  ASSERT_FALSE(Kala.try_push(8));
+  ASSERT_EQ(Kala.size(), 8);
+  int value{-1};
+  ASSERT_TRUE(Kala.try_pop(value));
+  ASSERT_EQ(value, 0);
+  ASSERT_EQ(*Kala.front(), 1);
+  Kala.pop();
+
+  //  the batch calls stop at the ends of the ring and wrap around it
+  int Items[]{10, 11, 12, 13};
+  ASSERT_EQ(Kala.try_push_n(Items, 4), 2);
+  int Out[16]{};
+  ASSERT_EQ(Kala.try_pop_n(Out, 16), 8);
+  ASSERT_EQ(Out[0], 2);
+  ASSERT_EQ(Out[5], 7);
+  ASSERT_EQ(Out[7], 11);
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.try_pop_n(Out, 16), 0);
+  ASSERT_EQ(Kala.try_push_n(Items, 4), 4);
+  ASSERT_EQ(Kala.size(), 4);
+
+  Tracked::Reset();
+  {
+    SpscQueue<Tracked, 4> Tracks;
+    Tracks.try_emplace(1);
+    Tracks.try_push(Tracked(2));
+    Tracks.try_emplace(3);
+    Tracked Taken;
+    ASSERT_TRUE(Tracks.try_pop(Taken));
+    ASSERT_EQ(Taken.value, 1);
+    ASSERT_EQ(Tracked::copies, 0);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+
+  CountingResource resource;
+  {
+    s21::pmr::SpscQueue<std::string, 16> KalaStrings(&resource);
+    KalaStrings.try_emplace(3, 'k');
+    ASSERT_EQ(*KalaStrings.front(), "kkk");
+    ASSERT_EQ(resource.allocations, 1);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+TEST(SpscQueue, two_threads) {
+  const int count{1000000};
+  SpscQueue<int, 1024> Kala;
+  std::thread producer([&Kala, count]() {
+    int Batch[64];
+    int next{0};
+    while (next < count) {
+      if (next % 3 == 0) {
+        while (!Kala.try_push(next)) {
+        }
+        next++;
+      } else {
+        int size{std::min(64, count - next)};
+        for (int i{0}; i < size; i++) {
+          Batch[i] = next + i;
+        }
+        next += static_cast<int>(Kala.try_push_n(Batch, size));
+      }
+    }
+  });
+  int expected{0};
+  bool ordered{true};
+  int Batch[32];
+  while (expected < count) {
+    if (expected % 2 == 0) {
+      int value;
+      if (Kala.try_pop(value)) {
+        ordered = ordered && value == expected;
+        expected++;
+      }
+    } else {
+      size_t taken{Kala.try_pop_n(Batch, 32)};
+      for (size_t i{0}; i < taken; i++) {
+        ordered = ordered && Batch[i] == expected;
+        expected++;
+      }
+    }
+  }
+  producer.join();
+  ASSERT_TRUE(ordered);
+  ASSERT_TRUE(Kala.empty());
+}
+
+TEST(MpmcQueue, basic) {
+  MpmcQueue<int, 8> Kala;
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.capacity(), 8);
+  int value{-1};
+  ASSERT_FALSE(Kala.try_pop(value));
+  for (int i{0}; i < 8; i++) {
+    ASSERT_TRUE(Kala.try_push(i));
+  }
+  ASSERT_FALSE(Kala.try_push(8));
+  ASSERT_EQ(Kala.size(), 8);
+  Kala.pop(value);
+  ASSERT_EQ(value, 0);
+  ASSERT_TRUE(Kala.try_pop(value));
+  ASSERT_EQ(value, 1);
+
+  //  a batch claims only the run of ready slots and wraps around the ring
+  int Items[]{10, 11, 12, 13};
+  ASSERT_EQ(Kala.try_push_n(Items, 4), 2);
+  int Out[16]{};
+  ASSERT_EQ(Kala.try_pop_n(Out, 16), 8);
+  ASSERT_EQ(Out[0], 2);
+  ASSERT_EQ(Out[5], 7);
+  ASSERT_EQ(Out[7], 11);
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.try_pop_n(Out, 16), 0);
+  ASSERT_EQ(Kala.try_push_n(Items, 4), 4);
+  Kala.push(14);
+  ASSERT_EQ(Kala.size(), 5);
+
+  Tracked::Reset();
+  {
+    MpmcQueue<Tracked, 4> Tracks;
+    Tracks.try_emplace(1);
+    Tracks.push(Tracked(2));
+    Tracks.try_emplace(3);
+    Tracked Taken;
+    ASSERT_TRUE(Tracks.try_pop(Taken));
+    ASSERT_EQ(Taken.value, 1);
+    ASSERT_EQ(Tracked::copies, 0);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+
+  CountingResource resource;
+  {
+    s21::pmr::MpmcQueue<std::string, 16> KalaStrings(&resource);
+    KalaStrings.try_emplace(3, 'k');
+    std::string taken;
+    KalaStrings.pop(taken);
+    ASSERT_EQ(taken, "kkk");
+    ASSERT_EQ(resource.allocations, 1);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+//  every value is taken exactly once and the values of one producer keep
+//  their order for each consumer
+TEST(MpmcQueue, many_threads) {
+  const int threads{4};
+  const int count{100000};
+  MpmcQueue<int, 256> Kala;
+  std::vector<std::thread> workers;
+  std::vector<std::vector<int>> Taken(threads);
+  for (int t{0}; t < threads; t++) {
+    workers.emplace_back([&Kala, t, count]() {
+      int Batch[16];
+      for (int next{0}; next < count;) {
+        if (next % 5 == 0) {
+          Kala.push(t * count + next);
+          next++;
+        } else {
+          int size{std::min(16, count - next)};
+          for (int i{0}; i < size; i++) {
+            Batch[i] = t * count + next + i;
+          }
+          int pushed{static_cast<int>(Kala.try_push_n(Batch, size))};
+          if (pushed == 0) {
+            std::this_thread::yield();
+          }
+          next += pushed;
+        }
+      }
+    });
+    workers.emplace_back([&Kala, &Taken, t, count]() {
+      int Batch[8];
+      while (static_cast<int>(Taken[t].size()) < count) {
+        if (Taken[t].size() % 3 == 0) {
+          int value;
+          Kala.pop(value);
+          Taken[t].push_back(value);
+        } else {
+          size_t want{std::min<size_t>(8, count - Taken[t].size())};
+          size_t popped{Kala.try_pop_n(Batch, want)};
+          if (popped == 0) {
+            std::this_thread::yield();
+          }
+          Taken[t].insert(Taken[t].end(), Batch, Batch + popped);
+        }
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  ASSERT_TRUE(Kala.empty());
+  std::vector<int> Seen(threads * count, 0);
+  bool ordered{true};
+  for (const std::vector<int> &taken : Taken) {
+    std::vector<int> Last(threads, -1);
+    for (int value : taken) {
+      Seen[value]++;
+      ordered = ordered && value > Last[value / count];
+      Last[value / count] = value;
+    }
+  }
+  ASSERT_TRUE(ordered);
+  ASSERT_EQ(std::count(Seen.begin(), Seen.end(), 1), threads * count);
+}
+
+TEST(WorkStealingDeque, basic) {
+  WorkStealingDeque<int> Kala;
+  int value{-1};
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_FALSE(Kala.pop(value));
+  ASSERT_FALSE(Kala.steal(value));
+  //  the ring grows past its first 64 slots
+  for (int i{0}; i < 200; i++) {
+    Kala.push(i);
+  }
+  ASSERT_EQ(Kala.size(), 200);
+  ASSERT_TRUE(Kala.pop(value));
+  ASSERT_EQ(value, 199);
+  ASSERT_TRUE(Kala.steal(value));
+  ASSERT_EQ(value, 0);
+  ASSERT_TRUE(Kala.steal(value));
+  ASSERT_EQ(value, 1);
+  for (int i{198}; i >= 2; i--) {
+    ASSERT_TRUE(Kala.pop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(Kala.pop(value));
+  ASSERT_FALSE(Kala.steal(value));
+  ASSERT_TRUE(Kala.empty());
+
+  CountingResource resource;
+  {
+    s21::pmr::WorkStealingDeque<int> KalaPmr(&resource);
+    for (int i{0}; i < 100; i++) {
+      KalaPmr.push(i);
+    }
+    ASSERT_EQ(resource.allocations, 4);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+//  the owner pushes and pops while thieves steal, every element is taken
+//  exactly once
+TEST(WorkStealingDeque, thieves) {
+  const int count{200000};
+  const int thieves{3};
+  WorkStealingDeque<int> Kala;
+  std::vector<int> Seen(count, 0);
+  std::atomic<bool> done{false};
+  std::vector<std::vector<int>> Stolen(thieves);
+  std::vector<std::thread> workers;
+  for (int t{0}; t < thieves; t++) {
+    workers.emplace_back([&Kala, &Stolen, &done, t]() {
+      int value;
+      while (!done.load()) {
+        if (Kala.steal(value)) {
+          Stolen[t].push_back(value);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::vector<int> Popped;
+  int value;
+  for (int i{0}; i < count; i++) {
+    Kala.push(i);
+    if (i % 3 == 0 && Kala.pop(value)) {
+      Popped.push_back(value);
+    }
+  }
+  while (Kala.pop(value)) {
+    Popped.push_back(value);
+  }
+  done.store(true);
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  for (int taken : Popped) {
+    Seen[taken]++;
+  }
+  for (const std::vector<int> &stolen : Stolen) {
+    for (int taken : stolen) {
+      Seen[taken]++;
+    }
+  }
+  ASSERT_EQ(std::count(Seen.begin(), Seen.end(), 1), count);
+}
+
+static long long ParallelFib(ThreadPool &pool, int n) {
+  if (n < 16) {
+    return n < 2 ? n : ParallelFib(pool, n - 1) + ParallelFib(pool, n - 2);
+  }
+  long long left{0};
+  TaskGroup group(pool);
+  group.run([&pool, &left, n]() {left = ParallelFib(pool, n - 1);});
+  long long right{ParallelFib(pool, n - 2)};
+  group.wait();
+  return left + right;
+}
+
+TEST(ThreadPool, fork_join) {
+  ThreadPool pool(4);
+  ASSERT_EQ(pool.size(), 4);
+  ASSERT_EQ(ParallelFib(pool, 27), 196418);
+
+  Vector<int> Kala;
+  for (int i{0}; i < 100000; i++) {
+    Kala.push_back(i);
+  }
+  std::atomic<long long> sum{0};
+  {
+    TaskGroup group(pool);
+    for (size_t first{0}; first < Kala.size(); first += 4096) {
+      group.run([&Kala, &sum, first]() {
+        size_t last{std::min<size_t>(first + 4096, Kala.size())};
+        sum += std::accumulate(Kala.begin() + first, Kala.begin() + last, 0LL);
+      });
+    }
+    group.wait();
+  }
+  ASSERT_EQ(sum.load(), 99999LL * 100000 / 2);
+
+  //  the first exception of a group is rethrown by wait, the others run on
+  TaskGroup group(pool);
+  std::atomic<int> ran{0};
+  for (int i{0}; i < 10; i++) {
+    group.run([&ran, i]() {
+      ran++;
+      if (i % 4 == 0) {
+        throw std::out_of_range("No such element");
+      }
+    });
+  }
+  ASSERT_THROW(group.wait(), std::out_of_range);
+  ASSERT_EQ(ran.load(), 10);
+  group.wait();
+
+  //  a function that throws while it is moved into its task is not counted
+  struct FailingMove {
+    FailingMove() = default;
+    FailingMove(FailingMove &&) { throw std::length_error("move"); }
+    void operator()() {}
+  };
+  ASSERT_THROW(group.run(FailingMove()), std::length_error);
+  group.wait();
+}
+
+TEST(ThreadPool, submit) {
+  std::atomic<int> ran{0};
+  {
+    ThreadPool pool(2);
+    for (int i{0}; i < 1000; i++) {
+      pool.submit([&ran]() {ran++;});
+    }
+  }
+  ASSERT_EQ(ran.load(), 1000);
+}
+
+TEST(Deque, basic) {
+  Deque<int> Kala;
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.begin(), Kala.end());
+  ASSERT_THROW(Kala.pop_front(), std::out_of_range);
+  ASSERT_THROW(Kala.back(), std::out_of_range);
+  Kala.push_back(2);
+  Kala.push_front(1);
+  Kala.emplace_back(3, 4);
+  Kala.emplace_front(0);
+  ASSERT_EQ(Kala.size(), 5);
+  for (int i{0}; i < 5; i++) {
+    ASSERT_EQ(Kala[i], i);
+  }
+  ASSERT_EQ(Kala.front(), 0);
+  ASSERT_EQ(Kala.back(), 4);
+  ASSERT_THROW(Kala.at(5), std::out_of_range);
+  Kala.pop_front();
+  Kala.pop_back();
+  ASSERT_EQ(Kala.front(), 1);
+  ASSERT_EQ(Kala.back(), 3);
+
+  Deque<int> KalaCopy(Kala);
+  Deque<int> KalaMoved(std::move(Kala));
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(KalaMoved.size(), 3);
+  ASSERT_TRUE(std::equal(KalaCopy.begin(), KalaCopy.end(), KalaMoved.begin()));
+  Kala = std::move(KalaCopy);
+  Kala.swap(KalaMoved);
+  ASSERT_EQ(Kala.at(2), 3);
+  Kala.clear();
+  ASSERT_TRUE(Kala.empty());
+  Kala.push_front(7);
+  ASSERT_EQ(Kala.back(), 7);
+
+  Deque<std::string> KalaStrings = {"b", "c"};
+  KalaStrings.EmplaceFront(2, 'a');
+  ASSERT_EQ(KalaStrings.front(), "aa");
+  ASSERT_EQ(KalaStrings.EmplaceBack("d"), "d");
+}
+
+//  elements cross many blocks at both ends and the map is recentred and
+//  grown, the result is checked against std::deque
+TEST(Deque, blocks) {
+  Deque<int> Kala;
+  std::deque<int> Std;
+  for (int i{0}; i < 20000; i++) {
+    if (i % 3 == 0) {
+      Kala.push_front(i);
+      Std.push_front(i);
+    } else {
+      Kala.push_back(i);
+      Std.push_back(i);
+    }
+  }
+  int *first{&Kala.front()};
+  int *last{&Kala.back()};
+  for (int i{0}; i < 10000; i++) {
+    Kala.push_back(i);
+    Std.push_back(i);
+    Kala.push_front(-i);
+    Std.push_front(-i);
+  }
+  ASSERT_EQ(first, &Kala[10000]);
+  ASSERT_EQ(last, &Kala[29999]);
+  ASSERT_EQ(Kala.size(), Std.size());
+  ASSERT_TRUE(std::equal(Kala.begin(), Kala.end(), Std.begin(), Std.end()));
+  ASSERT_EQ(Kala.end() - Kala.begin(), 40000);
+  ASSERT_EQ(*(Kala.end() - 1), Std.back());
+  ASSERT_EQ(Kala.begin()[12345], Std[12345]);
+  Deque<int>::iterator middle{Kala.begin() + 30000};
+  middle -= 25000;
+  ASSERT_EQ(*middle, Std[5000]);
+  ASSERT_TRUE(middle < Kala.end());
+  ASSERT_EQ(*std::prev(Kala.end()), Std.back());
+
+  std::sort(Kala.begin(), Kala.end());
+  std::sort(Std.begin(), Std.end());
+  ASSERT_TRUE(std::equal(Kala.begin(), Kala.end(), Std.begin(), Std.end()));
+  ASSERT_TRUE(std::binary_search(Kala.begin(), Kala.end(), 19999));
+
+  //  a queue walks along the map without growing it
+  for (int i{0}; i < 100000; i++) {
+    Kala.push_back(i);
+    Std.push_back(i);
+    Kala.pop_front();
+    Std.pop_front();
+  }
+  while (!Std.empty()) {
+    ASSERT_EQ(Kala.back(), Std.back());
+    Kala.pop_back();
+    Std.pop_back();
+  }
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.begin(), Kala.end());
+}
+
+TEST(Deque, allocator) {
+  Tracked::Reset();
+  {
+    Deque<Tracked> Kala;
+    for (int i{0}; i < 3000; i++) {
+      Kala.EmplaceBack(i);
+      Kala.push_front(Tracked(-i));
+    }
+    ASSERT_EQ(Tracked::copies, 0);
+    ASSERT_EQ(Tracked::alive, 6000);
+    for (int i{0}; i < 1000; i++) {
+      Kala.pop_back();
+      Kala.pop_front();
+    }
+    ASSERT_EQ(Tracked::alive, 4000);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+
+  CountingResource resource;
+  {
+    s21::pmr::Deque<int> Kala(&resource);
+    for (int i{0}; i < 10000; i++) {
+      Kala.push_back(i);
+    }
+    size_t allocations{resource.allocations};
+    for (int i{0}; i < 100000; i++) {
+      Kala.push_back(i);
+      Kala.pop_front();
+    }
+    //  the spare block is reused when a block is freed at the front
+    ASSERT_LE(resource.allocations - allocations, 2);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+//  inserts in random order against std::map, the store doubles instead of
+//  growing by one slot per insert
+TEST(Map, sorted_insert) {
+  Map<int, int> Kala;
+  std::map<int, int> Std;
+  unsigned seed{7};
+  size_t reallocations{0};
+  for (int i{0}; i < 5000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 3000);
+    size_t capacity{Kala.max_size()};
+    auto inserted = Kala.insert(key, i);
+    auto expected = Std.insert({key, i});
+    ASSERT_EQ(inserted.second, expected.second);
+    ASSERT_EQ(inserted.first->first, key);
+    ASSERT_EQ(inserted.first->second, expected.first->second);
+    reallocations += Kala.max_size() != capacity ? 1 : 0;
+  }
+  ASSERT_LT(reallocations, 16);
+  ASSERT_EQ(Kala.size(), Std.size());
+  ASSERT_TRUE(std::equal(Kala.begin(), Kala.end(), Std.begin(), Std.end(), [](const auto &left, const auto &right) {
+    return left.first == right.first && left.second == right.second;
+  }));
+
+  for (int key{0}; key < 3000; key += 3) {
+    auto found = Kala.FindPosition(key);
+    ASSERT_EQ(found.second, Std.count(key) == 1);
+    if (found.second) {
+      Kala.erase(Kala.begin() + found.first);
+      Std.erase(key);
+    }
+  }
+  ASSERT_TRUE(std::equal(Kala.begin(), Kala.end(), Std.begin(), Std.end(), [](const auto &left, const auto &right) {
+    return left.first == right.first && left.second == right.second;
+  }));
+
+  Kala[-1] += 5;
+  Kala[4000] = 9;
+  ASSERT_EQ(Kala.begin()->second, 5);
+  ASSERT_EQ(Kala.at(4000), 9);
+  ASSERT_EQ(Kala.size(), Std.size() + 2);
+}
+
+TEST(Map, non_trivial_values) {
+  Tracked::Reset();
+  {
+    Map<std::string, Tracked> Kala;
+    for (int i{0}; i < 200; i++) {
+      Kala.insert(std::to_string(i * 7 % 200), Tracked(i));
+    }
+    ASSERT_EQ(Kala.size(), 200);
+    ASSERT_TRUE(std::is_sorted(Kala.begin(), Kala.end(), [](const auto &left, const auto &right) {
+      return left.first < right.first;
+    }));
+    ASSERT_FALSE(Kala.insert(std::to_string(5), Tracked(-1)).second);
+    ASSERT_EQ(Kala.at("5").value, 115);
+    Kala.erase(Kala.begin());
+    ASSERT_EQ(Tracked::alive, 199);
+
+    Map<std::string, Tracked> KalaOther = {{"5", Tracked(-1)}, {"zz", Tracked(1)}};
+    Kala.merge(KalaOther);
+    ASSERT_TRUE(KalaOther.empty());
+    ASSERT_EQ(Kala.size(), 200);
+    ASSERT_EQ(Kala.at("5").value, 115);
+    ASSERT_EQ((--Kala.end())->first, "zz");
+    ASSERT_EQ(Tracked::alive, 200);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(Test, bulk_load) {
+  std::vector<int> keys;
+  unsigned seed = 3;
+  for (int i = 0; i < 100000; i++) {
+    seed = seed * 1103515245 + 12345;
+    keys.push_back(static_cast<int>((seed >> 8) % 50000));
+  }
+  std::set<int> oSet(keys.begin(), keys.end());
+  std::multiset<int> oMulti(keys.begin(), keys.end());
+
+  TreeProbe<s21::set<int>> mSet;
+  static_cast<s21::set<int>&>(mSet) = s21::set<int>(keys.begin(), keys.end());
+  ASSERT_TRUE(mSet.IsValid());
+  ASSERT_EQ(mSet.Height(), std::ceil(std::log2(oSet.size() + 1)));
+  ASSERT_EQ(mSet.size(), oSet.size());
+  ASSERT_TRUE(std::equal(oSet.begin(), oSet.end(), mSet.begin()));
+
+  TreeProbe<s21::multiset<int>> mMulti;
+  static_cast<s21::multiset<int>&>(mMulti) =
+      s21::multiset<int>(keys.begin(), keys.end());
+  ASSERT_TRUE(mMulti.IsValid());
+  ASSERT_EQ(mMulti.size(), oMulti.size());
+  ASSERT_EQ(mMulti.count(7), oMulti.count(7));
+  ASSERT_TRUE(std::equal(oMulti.begin(), oMulti.end(), mMulti.begin()));
+
+  //  the built trees keep balancing on later inserts and erases
+  for (int i = 0; i < 50000; i += 2) {
+    mSet.insert(i + 50000);
+    auto it = mSet.find(i);
+    if (it != mSet.end()) mSet.erase(it);
+    mMulti.insert(i);
+  }
+  ASSERT_TRUE(mSet.IsValid());
+  ASSERT_TRUE(mMulti.IsValid());
+
+  std::vector<int> sorted = {1, 1, 2, 3, 3, 3, 8};
+  auto fromSorted = s21::set<int>::from_sorted(sorted.begin(), sorted.end());
+  ASSERT_EQ(fromSorted.size(), 4);
+  ASSERT_TRUE(fromSorted.contains(8));
+  std::list<int> sortedList(sorted.begin(), sorted.end());
+  auto multiFromSorted =
+      s21::multiset<int>::from_sorted(sortedList.begin(), sortedList.end());
+  ASSERT_EQ(multiFromSorted.size(), 7);
+  ASSERT_EQ(multiFromSorted.count(3), 3);
+  s21::set<int> empty(sorted.end(), sorted.end());
+  ASSERT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(Map, bulk_load) {
+  std::vector<std::pair<int, int>> pairs;
+  std::map<int, int> Std;
+  unsigned seed{11};
+  for (int i{0}; i < 20000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 10000);
+    pairs.push_back({key, i});
+    Std.insert({key, i});
+  }
+  Map<int, int> Kala(pairs.begin(), pairs.end());
+  ASSERT_EQ(Kala.size(), Std.size());
+  ASSERT_TRUE(std::equal(Kala.begin(), Kala.end(), Std.begin(), Std.end(), [](const auto &left, const auto &right) {
+    return left.first == right.first && left.second == right.second;
+  }));
+
+  auto KalaSorted = Map<int, int>::from_sorted(Std.begin(), Std.end());
+  ASSERT_EQ(KalaSorted.size(), Std.size());
+  ASSERT_TRUE(std::equal(Kala.begin(), Kala.end(), KalaSorted.begin()));
+
+  std::list<std::pair<std::string, int>> words = {{"a", 1}, {"b", 2}, {"b", 3}, {"c", 4}};
+  auto KalaWords = Map<std::string, int>::from_sorted(words.begin(), words.end());
+  ASSERT_EQ(KalaWords.size(), 3);
+  ASSERT_EQ(KalaWords.at("b"), 2);
+  KalaWords.insert("ab", 5);
+  ASSERT_EQ((KalaWords.begin() + 1)->first, "ab");
+}
+
+//  stateful allocator that follows its container on swap and move
+//  assignment, each instance draws from its own arena
+template <typename T>
+struct ArenaAllocator {
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_swap;
+  typedef std::true_type propagate_on_container_move_assignment;
+  CountingResource *arena;
+  explicit ArenaAllocator(CountingResource *resource) : arena(resource) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+  T *allocate(size_t n) {
+    return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T *p, size_t n) {
+    arena->deallocate(p, n * sizeof(T), alignof(T));
+  }
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &other) const {
+    return arena == other.arena;
+  }
+};
+
+TEST(Map, lookup_index) {
+  Map<int, int> Kala;
+  Kala.enable_lookup_index();
+  ASSERT_TRUE(Kala.lookup_index_enabled());
+  ASSERT_FALSE(Kala.contains(1));
+  ASSERT_EQ(Kala.FindPosition(1).first, 0);
+  std::map<int, int> Std;
+  unsigned seed{5};
+  for (int i{0}; i < 20000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 3000);
+    if (i % 3 == 2) {
+      auto found = Kala.FindPosition(key);
+      ASSERT_EQ(found.second, Std.count(key) == 1);
+      ASSERT_EQ(found.first, static_cast<size_t>(std::distance(Std.begin(), Std.lower_bound(key))));
+      if (found.second) {
+        Kala.erase(Kala.begin() + found.first);
+        Std.erase(key);
+      }
+    } else {
+      Kala[key] = i;
+      Std[key] = i;
+    }
+    if (i % 1000 == 0) {
+      for (int probe{-1}; probe <= 3000; probe++) {
+        ASSERT_EQ(Kala.contains(probe), Std.count(probe) == 1);
+      }
+    }
+  }
+  for (auto &item : Std) {
+    ASSERT_EQ(Kala.at(item.first), item.second);
+  }
+  ASSERT_THROW(Kala.at(3000), std::out_of_range);
+
+  Map<int, int> KalaCopy(Kala);
+  ASSERT_TRUE(KalaCopy.lookup_index_enabled());
+  Map<int, int> KalaOther;
+  KalaOther.swap(KalaCopy);
+  ASSERT_TRUE(KalaOther.lookup_index_enabled());
+  ASSERT_FALSE(KalaCopy.lookup_index_enabled());
+  ASSERT_EQ(KalaOther.at(Std.begin()->first), Std.begin()->second);
+  Map<int, int> KalaMerged;
+  KalaMerged.enable_lookup_index();
+  ASSERT_FALSE(KalaMerged.contains(Std.begin()->first));
+  KalaMerged.merge(KalaOther);
+  ASSERT_TRUE(KalaMerged.contains(Std.begin()->first));
+  KalaMerged.enable_lookup_index(false);
+  ASSERT_TRUE(KalaMerged.contains(Std.begin()->first));
+
+  Map<std::string, int> KalaWords = {{"b", 2}, {"d", 4}, {"f", 6}};
+  KalaWords.enable_lookup_index();
+  ASSERT_EQ(KalaWords.FindPosition("c"), std::make_pair(size_t{1}, false));
+  ASSERT_EQ(KalaWords.FindPosition("d"), std::make_pair(size_t{1}, true));
+  ASSERT_EQ(KalaWords.FindPosition("g"), std::make_pair(size_t{3}, false));
+  KalaWords.insert("a", 1);
+  ASSERT_EQ(KalaWords.at("a"), 1);
+  ASSERT_EQ(KalaWords.FindPosition("d"), std::make_pair(size_t{2}, true));
+
+  typedef ArenaAllocator<std::pair<int, int>> Arena;
+  CountingResource first, second;
+  {
+    Map<int, int, std::less<>, Arena> KalaFirst{Arena(&first)};
+    Map<int, int, std::less<>, Arena> KalaSecond{Arena(&second)};
+    KalaFirst.enable_lookup_index();
+    KalaSecond.enable_lookup_index();
+    for (int i{0}; i < 100; i++) {
+      KalaFirst.insert(i, i);
+      KalaSecond.insert(i, -i);
+      KalaSecond.insert(i + 100, i);
+    }
+    ASSERT_TRUE(KalaFirst.contains(99));
+    ASSERT_TRUE(KalaSecond.contains(199));
+    KalaFirst.swap(KalaSecond);
+    ASSERT_EQ(KalaFirst.get_allocator().arena, &second);
+    ASSERT_EQ(KalaFirst.at(199), 99);
+    ASSERT_EQ(KalaSecond.at(99), 99);
+    KalaSecond.insert(100, 100);
+    ASSERT_TRUE(KalaSecond.contains(100));
+    KalaSecond = std::move(KalaFirst);
+    ASSERT_EQ(KalaSecond.get_allocator().arena, &second);
+    ASSERT_EQ(first.outstanding, 0);
+    ASSERT_EQ(KalaSecond.at(5), -5);
+  }
+  ASSERT_EQ(first.outstanding, 0);
+  ASSERT_EQ(second.outstanding, 0);
+
+  pmr::Map<int, int> KalaPmr(&first);
+  KalaPmr.enable_lookup_index();
+  KalaPmr.insert(1, 1);
+  pmr::Map<int, int> KalaPmrMoved(&second);
+  KalaPmrMoved = std::move(KalaPmr);
+  ASSERT_TRUE(KalaPmrMoved.lookup_index_enabled());
+  ASSERT_TRUE(KalaPmrMoved.contains(1));
+  pmr::Map<int, int> KalaPmrPlain(&first);
+  KalaPmrMoved = std::move(KalaPmrPlain);
+  ASSERT_FALSE(KalaPmrMoved.lookup_index_enabled());
+}
+
+TEST(SplitMap, basic) {
+  SplitMap<int, int> Kala;
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.begin(), Kala.end());
+  ASSERT_THROW(Kala.at(1), std::out_of_range);
+  std::map<int, int> Std;
+  unsigned seed{3};
+  for (int i{0}; i < 5000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 2000);
+    if (i % 4 == 3) {
+      auto found = Kala.FindPosition(key);
+      ASSERT_EQ(found.second, Std.count(key) == 1);
+      if (found.second) {
+        Kala.erase(Kala.begin() + found.first);
+        Std.erase(key);
+      }
+    } else {
+      ASSERT_EQ(Kala.insert(key, i).second, Std.insert({key, i}).second);
+    }
+  }
+  ASSERT_EQ(Kala.size(), Std.size());
+  ASSERT_TRUE(std::equal(Kala.begin(), Kala.end(), Std.begin(), Std.end(), [](const auto &left, const auto &right) {
+    return left.first == right.first && left.second == right.second;
+  }));
+
+  auto iter = Kala.begin() + 2;
+  ASSERT_EQ(iter[-2].first, Kala.begin()->first);
+  ASSERT_EQ(iter - Kala.begin(), 2);
+  ASSERT_TRUE(Kala.begin() < iter);
+  iter->second = -7;
+  ASSERT_EQ((*iter).second, -7);
+  std::pair<int, int> copied = *iter;
+  ASSERT_EQ(copied.second, -7);
+  Kala.insert_or_assign({iter->first, 8});
+  ASSERT_EQ(Kala.at(iter->first), 8);
+  Kala[-1] += 5;
+  ASSERT_EQ(Kala.begin()->second, 5);
+
+  SplitMap<int, int> KalaOther = {{-1, 1}, {5000, 2}};
+  Kala.merge(KalaOther);
+  ASSERT_TRUE(KalaOther.empty());
+  ASSERT_EQ(Kala.at(-1), 5);
+  ASSERT_EQ((--Kala.end())->second, 2);
+  ASSERT_EQ(Kala.size(), Std.size() + 2);
+}
+
+TEST(SplitMap, non_trivial_values) {
+  Tracked::Reset();
+  {
+    SplitMap<std::string, Tracked> Kala;
+    for (int i{0}; i < 200; i++) {
+      Kala.insert(std::to_string(i * 7 % 200), Tracked(i));
+    }
+    ASSERT_EQ(Kala.size(), 200);
+    ASSERT_TRUE(std::is_sorted(Kala.begin(), Kala.end(), [](const auto &left, const auto &right) {
+      return left.first < right.first;
+    }));
+    ASSERT_FALSE(Kala.insert(std::to_string(5), Tracked(-1)).second);
+    ASSERT_EQ(Kala.at("5").value, 115);
+    Kala.insert("zz", Kala.at("5"));
+    ASSERT_EQ(Kala.at("zz").value, 115);
+    Kala.erase(Kala.begin());
+    ASSERT_EQ(Tracked::alive, 200);
+
+    SplitMap<std::string, Tracked> KalaCopy(Kala);
+    ASSERT_EQ(Tracked::alive, 400);
+    KalaCopy.clear();
+    ASSERT_EQ(Tracked::alive, 200);
+
+    std::vector<std::pair<std::string, Tracked>> pairs = {{"b", Tracked(2)}, {"a", Tracked(1)}, {"b", Tracked(3)}};
+    SplitMap<std::string, Tracked> KalaRange(pairs.begin(), pairs.end());
+    ASSERT_EQ(KalaRange.size(), 2);
+    ASSERT_EQ(KalaRange.at("b").value, 2);
+    std::sort(pairs.begin(), pairs.end(), [](const auto &left, const auto &right) {return left.first < right.first;});
+    auto KalaSorted = SplitMap<std::string, Tracked>::from_sorted(pairs.begin(), pairs.end());
+    ASSERT_EQ(KalaSorted.size(), 2);
+    ASSERT_EQ(KalaSorted.begin()->first, "a");
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+
+  CountingResource resource;
+  {
+    pmr::SplitMap<int, std::string> Kala(&resource);
+    for (int i{0}; i < 100; i++) {
+      Kala[i] = std::string(40, 'k');
+    }
+    pmr::SplitMap<int, std::string> KalaMoved(std::move(Kala));
+    ASSERT_EQ(KalaMoved.size(), 100);
+    ASSERT_EQ(KalaMoved.get_allocator().resource(), &resource);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+struct Label {
+  static inline int made{0};
+  std::string text;
+  Label(std::string_view init) : text(init) { made++; }
+  friend bool operator<(const Label &left, const Label &right) { return left.text < right.text; }
+  friend bool operator<(const Label &left, std::string_view right) { return left.text < right; }
+  friend bool operator<(std::string_view left, const Label &right) { return left < right.text; }
+};
+
+TEST(Map, transparent_lookup) {
+  Map<std::string, int> Kala = {{"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+  std::string_view beta{"beta"};
+  ASSERT_TRUE(Kala.contains(beta));
+  ASSERT_EQ(Kala.at(beta), 2);
+  ASSERT_EQ(Kala.at("gamma"), 3);
+  ASSERT_EQ(Kala.find(beta)->second, 2);
+  ASSERT_EQ(Kala.find("delta"), Kala.end());
+  ASSERT_EQ(Kala.count("alpha"), 1);
+  ASSERT_EQ(Kala.lower_bound("b")->first, "beta");
+  ASSERT_THROW(Kala.at(std::string_view("zeta")), std::out_of_range);
+  Kala.enable_lookup_index();
+  ASSERT_EQ(Kala.FindPosition(beta), std::make_pair(size_t{1}, true));
+  ASSERT_EQ(Kala.lower_bound("zeta"), Kala.end());
+
+  Map<Label, int> KalaLabels;
+  SplitMap<Label, int> KalaSplit;
+  for (std::string_view text : {"one", "two", "three"}) {
+    KalaLabels.insert(Label(text), 1);
+    KalaSplit.insert(Label(text), 2);
+  }
+  Label::made = 0;
+  ASSERT_TRUE(KalaLabels.contains(std::string_view("two")));
+  ASSERT_EQ(KalaLabels.at(std::string_view("three")), 1);
+  ASSERT_EQ(KalaLabels.count(std::string_view("four")), 0);
+  ASSERT_EQ(KalaSplit.at(std::string_view("one")), 2);
+  ASSERT_EQ(KalaSplit.find(std::string_view("four")), KalaSplit.end());
+  ASSERT_EQ(KalaSplit.lower_bound(std::string_view("p"))->first.text, "three");
+  ASSERT_EQ(Label::made, 0);
+}
+
+TEST(Test, transparent_lookup) {
+  set<std::string> Kala{"alpha", "beta", "gamma"};
+  ASSERT_TRUE(Kala.contains(std::string_view("beta")));
+  ASSERT_FALSE(Kala.contains("delta"));
+  ASSERT_EQ(Kala.count("gamma"), 1);
+  ASSERT_EQ(*Kala.find("alpha"), "alpha");
+  ASSERT_EQ(*Kala.lower_bound("b"), "beta");
+  ASSERT_TRUE(Kala.lower_bound("zeta") == Kala.end());
+
+  multiset<std::string> KalaMulti{"a", "b", "b", "b", "c"};
+  std::string_view b{"b"};
+  ASSERT_EQ(KalaMulti.count(b), 3);
+  ASSERT_EQ(KalaMulti.count("d"), 0);
+  ASSERT_EQ(KalaMulti.count(std::string("a")), 1);
+  ASSERT_TRUE(KalaMulti.contains(b));
+  auto range = KalaMulti.equal_range(b);
+  int inRange{0};
+  for (auto iter = range.first; iter != range.second; ++iter) {
+    inRange++;
+  }
+  ASSERT_EQ(inRange, 3);
+  ASSERT_EQ(*KalaMulti.upper_bound(b), "c");
+
+  set<Label> KalaLabels;
+  multiset<Label> KalaMultiLabels;
+  for (std::string_view text : {"one", "two", "two"}) {
+    KalaLabels.insert(Label(text));
+    KalaMultiLabels.insert(Label(text));
+  }
+  Label::made = 0;
+  ASSERT_TRUE(KalaLabels.contains(std::string_view("one")));
+  ASSERT_EQ(KalaLabels.count(std::string_view("two")), 1);
+  ASSERT_EQ(KalaMultiLabels.count(std::string_view("two")), 2);
+  ASSERT_FALSE(KalaMultiLabels.contains(std::string_view("zero")));
+  ASSERT_TRUE(KalaLabels.find(std::string_view("zero")) == KalaLabels.end());
+  ASSERT_EQ(Label::made, 0);
+}
+
+//  orders ints by their remainder, so the state of the comparator decides
+//  which keys are equal
+struct ModuloLess {
+  int mod;
+  bool operator()(int left, int right) const {return left % mod < right % mod;}
+};
+
+TEST(Map, custom_compare) {
+  static_assert(sizeof(Map<int, int, std::greater<>>) == sizeof(Map<int, int>));
+  static_assert(sizeof(SplitMap<int, int, std::greater<>>) == sizeof(SplitMap<int, int>));
+
+  Map<int, std::string, std::greater<>> Kala{{1, "one"}, {3, "three"}, {2, "two"}};
+  Kala.insert(5, "five");
+  std::vector<int> keys;
+  for (auto iter = Kala.begin(); iter != Kala.end(); ++iter) {
+    keys.push_back(iter->first);
+  }
+  ASSERT_EQ(keys, std::vector<int>({5, 3, 2, 1}));
+  ASSERT_EQ(Kala.at(3), "three");
+  ASSERT_EQ(Kala.lower_bound(4)->first, 3);
+  Kala.enable_lookup_index(true);
+  ASSERT_EQ(Kala.at(2), "two");
+  ASSERT_FALSE(Kala.contains(4));
+
+  std::vector<std::pair<int, int>> pairs{{10, 0}, {13, 1}, {21, 2}, {4, 3}};
+  Map<int, int, ModuloLess> KalaModulo(pairs.begin(), pairs.end(), ModuloLess{5});
+  ASSERT_EQ(KalaModulo.key_comp().mod, 5);
+  ASSERT_EQ(KalaModulo.size(), 4);
+  ASSERT_EQ(KalaModulo.begin()->first, 10);
+  ASSERT_TRUE(KalaModulo.contains(16));
+  ASSERT_EQ(KalaModulo.at(8), 1);
+  ASSERT_FALSE(KalaModulo.insert(19, 7).second);
+  Map<int, int, ModuloLess> KalaCopy(KalaModulo);
+  ASSERT_EQ(KalaCopy.key_comp().mod, 5);
+  ASSERT_EQ(KalaCopy.at(23), 1);
+  Map<int, int, ModuloLess> KalaMoved(std::move(KalaCopy));
+  ASSERT_EQ(KalaMoved.at(9), 3);
+
+  std::vector<std::pair<int, int>> sorted{{9, 0}, {7, 1}, {2, 2}};
+  auto KalaSplit = SplitMap<int, int, std::greater<>>::from_sorted(sorted.begin(), sorted.end());
+  ASSERT_EQ(KalaSplit.size(), 3);
+  ASSERT_EQ(KalaSplit.at(7), 1);
+  KalaSplit.insert(8, 3);
+  ASSERT_EQ((KalaSplit.begin() + 1)->first, 8);
+  SplitMap<int, int, ModuloLess> KalaSplitModulo(ModuloLess{3});
+  KalaSplitModulo.insert(4, 0);
+  ASSERT_FALSE(KalaSplitModulo.insert(7, 1).second);
+  ASSERT_EQ(KalaSplitModulo.at(1), 0);
+}
+
+TEST(Test, custom_compare) {
+  set<int, std::greater<>> Kala{4, 1, 3, 2};
+  std::vector<int> keys;
+  for (auto iter = Kala.begin(); iter != Kala.end(); ++iter) {
+    keys.push_back(*iter);
+  }
+  ASSERT_EQ(keys, std::vector<int>({4, 3, 2, 1}));
+  ASSERT_EQ(*Kala.lower_bound(5), 4);
+  ASSERT_TRUE(Kala.find(0) == Kala.end());
+
+  multiset<int, std::greater<>> KalaMulti{1, 2, 2, 3};
+  std::vector<int> multiKeys;
+  for (auto iter = KalaMulti.begin(); iter != KalaMulti.end(); ++iter) {
+    multiKeys.push_back(*iter);
+  }
+  ASSERT_EQ(multiKeys, std::vector<int>({3, 2, 2, 1}));
+  ASSERT_EQ(KalaMulti.count(2), 2);
+  ASSERT_EQ(*KalaMulti.upper_bound(2), 1);
+
+  set<int, ModuloLess> KalaModulo(ModuloLess{4});
+  KalaModulo.insert(5);
+  ASSERT_FALSE(KalaModulo.insert(9).second);
+  ASSERT_TRUE(KalaModulo.contains(13));
+  ASSERT_EQ(KalaModulo.key_comp().mod, 4);
+  set<int, ModuloLess> KalaCopy(KalaModulo);
+  ASSERT_EQ(KalaCopy.key_comp().mod, 4);
+  ASSERT_EQ(*KalaCopy.find(1), 5);
+
+  std::vector<int> values{6, 1, 11, 3};
+  multiset<int, ModuloLess> KalaMultiModulo(values.begin(), values.end(),
+                                            ModuloLess{5});
+  ASSERT_EQ(KalaMultiModulo.count(16), 3);
+  ASSERT_EQ(*KalaMultiModulo.begin(), 6);
+
+  std::vector<int> mixed{7, 2, 5};
+  CountingResource resource;
+  pmr::set<int, ModuloLess> KalaPmr(mixed.begin(), mixed.end(),
+                                    ModuloLess{4}, &resource);
+  pmr::set<int, ModuloLess> KalaPmrMoved(ModuloLess{10});
+  KalaPmrMoved = std::move(KalaPmr);
+  ASSERT_EQ(KalaPmrMoved.key_comp().mod, 4);
+  keys.clear();
+  for (auto iter = KalaPmrMoved.begin(); iter != KalaPmrMoved.end(); ++iter) {
+    keys.push_back(*iter);
+  }
+  ASSERT_EQ(keys, std::vector<int>({5, 2, 7}));
+  pmr::multiset<int, ModuloLess> KalaPmrMulti(mixed.begin(), mixed.end(),
+                                              ModuloLess{4}, &resource);
+  pmr::multiset<int, ModuloLess> KalaPmrMultiMoved(ModuloLess{10});
+  KalaPmrMultiMoved = std::move(KalaPmrMulti);
+  ASSERT_EQ(KalaPmrMultiMoved.key_comp().mod, 4);
+  ASSERT_EQ(*KalaPmrMultiMoved.begin(), 5);
+}
+
+TEST(UnorderedMap, basic) {
+  UnorderedMap<int, int> Kala;
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_EQ(Kala.begin(), Kala.end());
+  ASSERT_FALSE(Kala.contains(1));
+  ASSERT_THROW(Kala.at(1), std::out_of_range);
+  auto inserted = Kala.insert(std::make_pair(1, 10));
+  ASSERT_TRUE(inserted.second);
+  ASSERT_EQ(inserted.first->second, 10);
+  ASSERT_FALSE(Kala.insert(1, 11).second);
+  ASSERT_EQ(Kala.at(1), 10);
+  Kala.insert_or_assign(std::make_pair(1, 12));
+  ASSERT_EQ(Kala[1], 12);
+  Kala[2] += 5;
+  ASSERT_EQ(Kala.at(2), 5);
+  ASSERT_EQ(Kala.size(), 2);
+  ASSERT_EQ(Kala.count(2), 1);
+  ASSERT_EQ(Kala.erase(2), 1);
+  ASSERT_EQ(Kala.erase(2), 0);
+  ASSERT_EQ(Kala.find(2), Kala.end());
+
+  UnorderedMap<int, int> KalaInit = {{1, 1}, {2, 4}, {3, 9}};
+  UnorderedMap<int, int> KalaCopy(KalaInit);
+  UnorderedMap<int, int> KalaMoved(std::move(KalaInit));
+  ASSERT_TRUE(KalaInit.empty());
+  int sum{0};
+  for (auto &item : KalaMoved) {
+    sum += item.second;
+  }
+  ASSERT_EQ(sum, 14);
+  ASSERT_EQ(KalaCopy.at(3), 9);
+  Kala = std::move(KalaCopy);
+  Kala.swap(KalaMoved);
+  ASSERT_EQ(KalaMoved.size(), 3);
+  Kala.erase(Kala.find(1));
+  ASSERT_EQ(Kala.size(), 2);
+  Kala.clear();
+  ASSERT_EQ(Kala.bucket_count(), 0);
+}
+
+//  churn on a fixed key range fills groups up, so erases leave tombstones
+//  and the table is rehashed in place
+TEST(UnorderedMap, against_std) {
+  UnorderedMap<int, int> Kala;
+  std::unordered_map<int, int> Std;
+  unsigned seed{5};
+  for (int i{0}; i < 200000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 2000);
+    if ((seed >> 4) % 3 == 0) {
+      ASSERT_EQ(Kala.erase(key), Std.erase(key));
+    } else {
+      ASSERT_EQ(Kala.insert(key, i).second, Std.insert({key, i}).second);
+    }
+  }
+  ASSERT_EQ(Kala.size(), Std.size());
+  ASSERT_LE(Kala.bucket_count(), 4096);
+  for (int key{0}; key < 2000; key++) {
+    auto found = Std.find(key);
+    ASSERT_EQ(Kala.contains(key), found != Std.end());
+    if (found != Std.end()) {
+      ASSERT_EQ(Kala.at(key), found->second);
+    }
+  }
+  size_t visited{0};
+  for (auto iter = Kala.begin(); iter != Kala.end(); ++iter, visited++) {
+    ASSERT_EQ(Std.at(iter->first), iter->second);
+  }
+  ASSERT_EQ(visited, Std.size());
+}
+
+struct StringHash {
+  typedef void is_transparent;
+  size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+};
+
+TEST(UnorderedMap, heterogeneous_and_allocator) {
+  UnorderedMap<std::string, int, StringHash, std::equal_to<>> Kala;
+  for (int i{0}; i < 1000; i++) {
+    Kala.insert(std::to_string(i), i);
+  }
+  std::string_view key{"123"};
+  ASSERT_TRUE(Kala.contains(key));
+  ASSERT_EQ(Kala.at("999"), 999);
+  ASSERT_EQ(Kala.find(std::string_view("1000")), Kala.end());
+  ASSERT_EQ(Kala.erase("5"), 1);
+  ASSERT_EQ(Kala.size(), 999);
+
+  CountingResource resource;
+  Tracked::Reset();
+  {
+    s21::pmr::UnorderedMap<int, Tracked> KalaTracked(&resource);
+    for (int i{0}; i < 500; i++) {
+      KalaTracked.try_emplace(i, i);
+    }
+    for (int i{0}; i < 500; i += 2) {
+      KalaTracked.erase(i);
+    }
+    ASSERT_EQ(Tracked::alive, 250);
+    ASSERT_EQ(KalaTracked.get_allocator().resource(), &resource);
+    s21::pmr::UnorderedMap<int, Tracked> KalaCopy(KalaTracked);
+    ASSERT_EQ(KalaCopy.at(7).value, 7);
+    ASSERT_EQ(Tracked::alive, 500);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+  ASSERT_EQ(resource.outstanding, 0);
+}
+
+//  128 byte nodes hold a few elements each, so a few thousand keys already
+//  build a tree of several levels
+template<typename Key, typename T>
+using SmallBTreeMap = BTreeMap<Key, T, std::less<>, std::allocator<std::pair<Key, T>>, 128>;
+
+TEST(BTreeMap, basic) {
+  SmallBTreeMap<int, std::string> Kala;
+  ASSERT_TRUE(Kala.empty());
+  ASSERT_TRUE(Kala.begin() == Kala.end());
+  ASSERT_THROW(Kala.at(1), std::out_of_range);
+  ASSERT_TRUE(Kala.insert(2, "two").second);
+  ASSERT_FALSE(Kala.insert(std::make_pair(2, "deux")).second);
+  ASSERT_TRUE(Kala.insert_or_assign(std::make_pair(2, "zwei")).second);
+  ASSERT_EQ(Kala.at(2), "zwei");
+  Kala[1] = "one";
+  ASSERT_EQ(Kala.size(), 2);
+  ASSERT_EQ(Kala.begin()->first, 1);
+  for (int i{3}; i < 1000; i++) {
+    Kala.insert(i, std::to_string(i));
+  }
+  ASSERT_GE(Kala.height(), 2);
+  ASSERT_EQ(Kala.at(777), "777");
+  ASSERT_TRUE(Kala.contains(999));
+  ASSERT_EQ(Kala.count(1000), 0);
+  ASSERT_TRUE(Kala.find(1000) == Kala.end());
+  ASSERT_EQ(Kala.lower_bound(500)->first, 500);
+  ASSERT_EQ(Kala.upper_bound(500)->first, 501);
+  ASSERT_TRUE(Kala.upper_bound(999) == Kala.end());
+  auto last = Kala.end();
+  --last;
+  ASSERT_EQ(last->first, 999);
+
+  SmallBTreeMap<int, std::string> KalaCopy(Kala);
+  for (int i{2}; i < 1000; i += 2) {
+    Kala.erase(Kala.find(i));
+  }
+  ASSERT_EQ(Kala.size(), 500);
+  ASSERT_EQ(KalaCopy.size(), 999);
+  int expected{1};
+  for (auto iter = Kala.begin(); iter != Kala.end(); ++iter, expected += 2) {
+    ASSERT_EQ(iter->first, expected);
+  }
+  SmallBTreeMap<int, std::string> KalaMoved(std::move(KalaCopy));
+  ASSERT_TRUE(KalaCopy.empty());
+  Kala.merge(KalaMoved);
+  ASSERT_EQ(Kala.size(), 999);
+  ASSERT_TRUE(KalaMoved.empty());
+  while (!Kala.empty()) {
+    Kala.erase(Kala.begin());
+  }
+  ASSERT_EQ(Kala.height(), 0);
+
+  std::vector<std::pair<int, int>> pairs{{3, 0}, {1, 1}, {3, 2}, {2, 3}};
+  BTreeMap<int, int> KalaRange(pairs.begin(), pairs.end());
+  ASSERT_EQ(KalaRange.size(), 3);
+  ASSERT_EQ(KalaRange.at(3), 0);
+  BTreeMap<std::string, int> KalaText{{"alpha", 1}, {"beta", 2}};
+  ASSERT_EQ(KalaText.at(std::string_view("beta")), 2);
+  ASSERT_TRUE(KalaText.contains("alpha"));
+}
+
+//  random inserts and erases over a small key range split, merge and
+//  rebalance nodes on every level
+TEST(BTreeMap, against_std) {
+  SmallBTreeMap<int, int> Kala;
+  std::map<int, int> Std;
+  unsigned seed{11};
+  for (int i{0}; i < 100000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 3000);
+    if ((seed >> 4) % 3 == 0) {
+      auto found = Kala.find(key);
+      ASSERT_EQ(found != Kala.end(), Std.erase(key) == 1);
+      if (found != Kala.end()) {
+        Kala.erase(found);
+      }
+    } else {
+      ASSERT_EQ(Kala.insert(key, i).second, Std.insert({key, i}).second);
+    }
+    auto bound = Kala.lower_bound(key + 1);
+    auto stdBound = Std.lower_bound(key + 1);
+    ASSERT_EQ(bound == Kala.end(), stdBound == Std.end());
+    if (stdBound != Std.end()) {
+      ASSERT_EQ(bound->first, stdBound->first);
+    }
+  }
+  ASSERT_EQ(Kala.size(), Std.size());
+  auto iter = Kala.begin();
+  for (auto &item : Std) {
+    ASSERT_EQ(iter->first, item.first);
+    ASSERT_EQ(iter->second, item.second);
+    ++iter;
+  }
+  ASSERT_TRUE(iter == Kala.end());
+
+  std::vector<std::pair<int, int>> sorted(Std.begin(), Std.end());
+  auto KalaSorted = SmallBTreeMap<int, int>::from_sorted(sorted.begin(), sorted.end());
+  ASSERT_EQ(KalaSorted.size(), Std.size());
+  for (auto &item : Std) {
+    ASSERT_EQ(KalaSorted.at(item.first), item.second);
+  }
+}
+
+//  every arithmetic key width goes through the SIMD node search
+template<typename Key>
+void CheckBTreeSetBounds() {
+  BTreeSet<Key, std::less<>, std::allocator<Key>, 128> Kala;
+  std::set<Key> Std;
+  unsigned seed{3};
+  for (int i{0}; i < 3000; i++) {
+    seed = seed * 1103515245 + 12345;
+    Key key = static_cast<Key>(static_cast<int>(seed) >> 7);
+    ASSERT_EQ(Kala.insert(key).second, Std.insert(key).second);
+    Key probe = static_cast<Key>(static_cast<int>(seed * 7) >> 7);
+    auto lower = Std.lower_bound(probe);
+    ASSERT_EQ(Kala.lower_bound(probe) == Kala.end(), lower == Std.end());
+    if (lower != Std.end()) {
+      ASSERT_EQ(*Kala.lower_bound(probe), *lower);
+    }
+    auto upper = Std.upper_bound(probe);
+    ASSERT_EQ(Kala.upper_bound(probe) == Kala.end(), upper == Std.end());
+    if (upper != Std.end()) {
+      ASSERT_EQ(*Kala.upper_bound(probe), *upper);
+    }
+  }
+  ASSERT_TRUE(std::equal(Std.begin(), Std.end(), Kala.begin()));
+}
+
+TEST(BTreeSet, simd_search) {
+  CheckBTreeSetBounds<int8_t>();
+  CheckBTreeSetBounds<uint8_t>();
+  CheckBTreeSetBounds<int16_t>();
+  CheckBTreeSetBounds<uint16_t>();
+  CheckBTreeSetBounds<int32_t>();
+  CheckBTreeSetBounds<uint32_t>();
+  CheckBTreeSetBounds<int64_t>();
+  CheckBTreeSetBounds<uint64_t>();
+  CheckBTreeSetBounds<float>();
+  CheckBTreeSetBounds<double>();
+}
+
+TEST(BTreeSet, allocator) {
+  CountingResource resource;
+  {
+    s21::pmr::BTreeSet<std::string> Kala(&resource);
+    for (int i{0}; i < 2000; i++) {
+      Kala.insert(std::to_string(i) + " padding past the small string buffer");
+    }
+    ASSERT_EQ(Kala.get_allocator().resource(), &resource);
+    ASSERT_TRUE(Kala.contains("1999 padding past the small string buffer"));
+    s21::pmr::BTreeSet<std::string> KalaCopy(Kala);
+    for (int i{0}; i < 2000; i += 3) {
+      KalaCopy.erase(KalaCopy.find(std::to_string(i) + " padding past the small string buffer"));
+    }
+    ASSERT_EQ(KalaCopy.size(), 1333);
+  }
+  ASSERT_EQ(resource.outstanding, 0);
+
+  Tracked::Reset();
+  {
+    BTreeMap<int, Tracked> Kala;
+    for (int i{0}; i < 5000; i++) {
+      Kala.insert(i, Tracked(i));
+    }
+    for (int i{0}; i < 5000; i += 2) {
+      Kala.erase(Kala.find(i));
+    }
+    ASSERT_EQ(Tracked::alive, 2500);
+    ASSERT_EQ(Kala.at(4999).value, 4999);
+  }
+  ASSERT_EQ(Tracked::alive, 0);
+}
+
 int main() {
   testing::InitGoogleTest();
   return RUN_ALL_TESTS();